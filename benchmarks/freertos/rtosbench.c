@@ -0,0 +1,208 @@
+///////////////////////////////////////////
+// rtosbench.c
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified:
+//
+// Purpose: FreeRTOS latency benchmarks: context switch, semaphore handoff, interrupt to task
+//
+// Documentation: RISC-V System on Chip Design
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+//
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied. See the License for the specific language governing permissions
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+// Every result is in mcycle counts.  Each benchmark runs in its own worker tasks, and the
+// controller task (highest priority) waits for them on a semaphore and prints the results.
+//
+// ctxsw int   two equal priority tasks that never use the FPU bounce with taskYIELD();
+//             cycles per switch, including the ecall trap and the scheduler
+// ctxsw fp    the same with an FP write between yields, so mstatus.FS is Dirty and every
+//             switch also saves and restores the FP registers
+// sem handoff a low priority task gives a semaphore that a blocked high priority task takes;
+//             cycles from just before xSemaphoreGive() to the first instruction after xSemaphoreTake()
+// irq entry   cycles from the store that sets CLINT MSIP to the top of the C interrupt handler
+// irq to task cycles from the store that sets MSIP to the high priority task waking on a
+//             semaphore given with xSemaphoreGiveFromISR()
+//
+// The tick interrupt still runs every 10000 cycles, so averages include the odd tick; min is the clean figure.
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "wally_port.h"
+
+#define ITERATIONS 64
+#define WORKER_PRIORITY_HIGH (tskIDLE_PRIORITY + 3)
+#define WORKER_PRIORITY_LOW  (tskIDLE_PRIORITY + 2)
+#define CONTROL_PRIORITY     (tskIDLE_PRIORITY + 4)
+
+typedef struct {
+  unsigned long sum, min, max, n;
+} stats_t;
+
+static SemaphoreHandle_t done, handoff;
+static volatile unsigned long stamp, isrstamp;
+static volatile int go;
+static stats_t ctxint, ctxfp, sem, irqentry, irqtask;
+
+static void record(stats_t *s, unsigned long cycles) {
+  if (s->n == 0 || cycles < s->min) s->min = cycles;
+  if (cycles > s->max) s->max = cycles;
+  s->sum += cycles;
+  s->n++;
+}
+
+static void report(const char *name, stats_t *s) {
+  wally_puts(name);
+  wally_puts(": avg ");
+  wally_putu(s->n ? s->sum / s->n : 0);
+  wally_puts(" min ");
+  wally_putu(s->min);
+  wally_puts(" max ");
+  wally_putu(s->max);
+  wally_puts(" cycles\n");
+}
+
+// Context switch: the measuring task sees two switches per loop, one out and one back
+static void yield_measure(void *arg) {
+  stats_t *s = arg;
+  unsigned long start;
+  int i;
+  for (i = 0; i < ITERATIONS; i++) {
+    start = wally_cycles();
+    taskYIELD();
+    record(s, (wally_cycles() - start) / 2);
+  }
+  xSemaphoreGive(done);
+  vTaskSuspend(NULL);
+}
+
+static void yield_partner(void *arg) {
+  (void)arg;
+  for (;;) taskYIELD();
+}
+
+static void yield_measure_fp(void *arg) {
+  volatile double x = 1.0;
+  stats_t *s = arg;
+  unsigned long start;
+  int i;
+  for (i = 0; i < ITERATIONS; i++) {
+    x = x * 1.5;
+    start = wally_cycles();
+    taskYIELD();
+    record(s, (wally_cycles() - start) / 2);
+  }
+  xSemaphoreGive(done);
+  vTaskSuspend(NULL);
+}
+
+static void yield_partner_fp(void *arg) {
+  volatile double x = 1.0;
+  (void)arg;
+  for (;;) {
+    x = x + 1.0;
+    taskYIELD();
+  }
+}
+
+// Semaphore handoff and interrupt to task share the waiting side
+static void handoff_waiter(void *arg) {
+  stats_t *s = arg;
+  int i;
+  for (i = 0; i < ITERATIONS; i++) {
+    xSemaphoreTake(handoff, portMAX_DELAY);
+    record(s, wally_cycles() - stamp);
+  }
+  xSemaphoreGive(done);
+  vTaskSuspend(NULL);
+}
+
+static void handoff_giver(void *arg) {
+  (void)arg;
+  for (;;) {
+    stamp = wally_cycles();
+    xSemaphoreGive(handoff);
+  }
+}
+
+static void irq_raiser(void *arg) {
+  (void)arg;
+  for (;;) {
+    stamp = wally_cycles();
+    *(volatile uint32_t *)WALLY_CLINT_MSIP = 1;
+    while (go); // spin until the interrupt handler has run
+    go = 1;
+  }
+}
+
+void wally_software_interrupt(void) {
+  BaseType_t woken = pdFALSE;
+  isrstamp = wally_cycles();
+  wally_clear_msip();
+  record(&irqentry, isrstamp - stamp);
+  go = 0;
+  xSemaphoreGiveFromISR(handoff, &woken);
+  portYIELD_FROM_ISR(woken);
+}
+
+static void run(TaskFunction_t measure, TaskFunction_t partner, UBaseType_t partnerpriority, stats_t *s) {
+  TaskHandle_t m, p;
+  xTaskCreate(partner, "partner", configMINIMAL_STACK_SIZE, NULL, partnerpriority, &p);
+  xTaskCreate(measure, "measure", configMINIMAL_STACK_SIZE, s, WORKER_PRIORITY_HIGH, &m);
+  xSemaphoreTake(done, portMAX_DELAY);
+  vTaskDelete(m);
+  vTaskDelete(p);
+}
+
+static void controller(void *arg) {
+  (void)arg;
+  wally_puts("FreeRTOS " tskKERNEL_VERSION_NUMBER " on Wally, ");
+  wally_puts(configWALLY_SSTC_TICK ? "Sstc tick\n" : "CLINT tick\n");
+
+  run(yield_measure, yield_partner, WORKER_PRIORITY_HIGH, &ctxint);
+  report("ctxsw int", &ctxint);
+  run(yield_measure_fp, yield_partner_fp, WORKER_PRIORITY_HIGH, &ctxfp);
+  report("ctxsw fp", &ctxfp);
+  run(handoff_waiter, handoff_giver, WORKER_PRIORITY_LOW, &sem);
+  report("sem handoff", &sem);
+
+  asm volatile("csrs mie, %0" :: "r"(0x8)); // MSIE
+  go = 1;
+  run(handoff_waiter, irq_raiser, WORKER_PRIORITY_LOW, &irqtask);
+  asm volatile("csrc mie, %0" :: "r"(0x8));
+  report("irq entry", &irqentry);
+  report("irq to task", &irqtask);
+
+  wally_exit(0);
+}
+
+int main(void) {
+  extern void freertos_risc_v_trap_handler(void);
+
+  done = xSemaphoreCreateBinary();
+  handoff = xSemaphoreCreateBinary();
+  xTaskCreate(controller, "control", configMINIMAL_STACK_SIZE, NULL, CONTROL_PRIORITY, NULL);
+  asm volatile("csrw mtvec, %0" :: "r"(freertos_risc_v_trap_handler));
+  vTaskStartScheduler();
+  return 1; // only reached if the idle task could not be created
+}
@@ -0,0 +1,85 @@
+///////////////////////////////////////////
+// FreeRTOSConfig.h
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified:
+//
+// Purpose: FreeRTOS kernel configuration for Wally rv32gc/rv64gc
+//
+// Documentation: RISC-V System on Chip Design
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+//
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied. See the License for the specific language governing permissions
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+// configWALLY_SSTC_TICK is set by the Makefile (make SSTC=1).
+// 0: the tick comes from the CLINT mtimecmp and is handled by the port's own mtimer code.
+// 1: the tick comes from the Sstc stimecmp CSR; wally_port.c sets it up and services it.
+#ifndef configWALLY_SSTC_TICK
+#define configWALLY_SSTC_TICK 0
+#endif
+
+// CLINT (clint_apb.sv).  MTIME advances once per clock, so mtime ticks are cycles.
+#define configWALLY_CLINT_BASE          0x02000000UL
+#if configWALLY_SSTC_TICK
+#define configMTIME_BASE_ADDRESS        0
+#define configMTIMECMP_BASE_ADDRESS     0
+#else
+#define configMTIME_BASE_ADDRESS        ( configWALLY_CLINT_BASE + 0xBFF8UL )
+#define configMTIMECMP_BASE_ADDRESS     ( configWALLY_CLINT_BASE + 0x4000UL )
+#endif
+
+// The clock is nominal: it only sets the tick period, 10000 cycles, which keeps ticks rare in simulation.
+#define configCPU_CLOCK_HZ              10000000UL
+#define configTICK_RATE_HZ              1000
+#define configTICK_TYPE_WIDTH_IN_BITS   TICK_TYPE_WIDTH_32_BITS
+
+#define configUSE_PREEMPTION            1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#define configUSE_IDLE_HOOK             0
+#define configUSE_TICK_HOOK             0
+#define configIDLE_SHOULD_YIELD         0
+#define configMAX_PRIORITIES            5
+#define configMINIMAL_STACK_SIZE        256
+#define configISR_STACK_SIZE_WORDS      512
+#define configMAX_TASK_NAME_LEN         8
+#define configUSE_MUTEXES               1
+#define configUSE_COUNTING_SEMAPHORES   1
+#define configQUEUE_REGISTRY_SIZE       0
+#define configUSE_TIMERS                0
+#define configUSE_TRACE_FACILITY        0
+#define configCHECK_FOR_STACK_OVERFLOW  0
+#define configUSE_MALLOC_FAILED_HOOK    1
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#define configSUPPORT_STATIC_ALLOCATION 0
+#define configTOTAL_HEAP_SIZE           ( 48 * 1024 )
+
+#define INCLUDE_vTaskDelete             1
+#define INCLUDE_vTaskSuspend            1
+#define INCLUDE_vTaskDelay              1
+
+#ifndef __ASSEMBLER__
+void vWallyAssert(const char *file, int line);
+#endif
+#define configASSERT( x ) if ( ( x ) == 0 ) vWallyAssert( __FILE__, __LINE__ )
+
+#endif
@@ -0,0 +1,181 @@
+///////////////////////////////////////////
+// freertos_risc_v_chip_specific_extensions.h
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified:
+//
+// Purpose: Wally extensions to the FreeRTOS RISC-V context switch: timer selection and
+//          floating-point context save gated by mstatus.FS
+//
+// Documentation: RISC-V System on Chip Design
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+//
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied. See the License for the specific language governing permissions
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Included by the port's assembly after portWORD_SIZE, store_x and load_x are defined.
+// The port pushes portasmADDITIONAL_CONTEXT_SIZE words below the integer frame and keeps
+// the task's mepc in word 0 of that area, so the words used here start at 1.
+//
+// Floating-point state is saved only when mstatus.FS is Clean or Dirty.  This is an FS-gated
+// save, not a lazy one: FS is never set to Off, so there is no first-use trap, and a task that
+// has used the FPU pays for the save on every switch.  csrsr.sv moves FS to Dirty on any write
+// to the FP register file or fcsr, so a task that has never executed an FP write keeps
+// FS = Initial and its switches skip the 33 FP stores and loads entirely.
+// After a save, FS goes back to Clean both in mstatus and in the mstatus word of the frame,
+// so the task resumes Clean as the privileged spec expects of state that matches its saved
+// copy.  A Clean task is still saved on its next switch, because the frame is popped off the
+// task's stack when it resumes and no copy outlives it.  Word 1 records the FS value seen at
+// save time so the restore knows whether the frame holds FP state; new task frames are zero
+// filled by the port.  Interrupt handlers must not use the FPU, since the FP registers are not
+// saved around them.
+
+#ifndef FREERTOS_RISC_V_EXTENSIONS_H
+#define FREERTOS_RISC_V_EXTENSIONS_H
+
+#if configWALLY_SSTC_TICK
+#define portasmHAS_SIFIVE_CLINT 0
+#define portasmHAS_MTIME 0
+#else
+#define portasmHAS_SIFIVE_CLINT 1
+#define portasmHAS_MTIME 1
+#endif
+
+// Everything other than the CLINT tick goes to the C handler in wally_port.c
+#define portasmHANDLE_INTERRUPT freertos_risc_v_application_interrupt_handler
+
+#ifdef __riscv_flen
+
+#if __riscv_flen == 64
+#define portasmFREG_SIZE 8
+#define portasmFSTORE fsd
+#define portasmFLOAD fld
+#else
+#define portasmFREG_SIZE 4
+#define portasmFSTORE fsw
+#define portasmFLOAD flw
+#endif
+
+// mepc, FS, fcsr, one word of alignment slack, then f0-f31 on an 8-byte boundary.
+// Always a multiple of four words so the stack stays 16-byte aligned.
+#define portasmADDITIONAL_CONTEXT_SIZE ( 4 + ( 32 * portasmFREG_SIZE ) / portWORD_SIZE )
+#define portasmFS_CLEAN 2
+#define portasmFS_DIRTY_BIT 0x2000  // the bit of mstatus.FS that separates Dirty from Clean
+
+// mstatus is the last word of the port's integer frame.  portContext.h defines portCONTEXT_SIZE
+// only after it includes this file, so portasmSAVE_ADDITIONAL_REGISTERS is a preprocessor macro:
+// it is expanded where the port uses it, after portCONTEXT_SIZE exists, and binds the word
+// index to an assembler symbol before running the save.
+#define portasmSAVE_ADDITIONAL_REGISTERS \
+	.set wally_mstatus_word, ( portCONTEXT_SIZE / portWORD_SIZE ) - 1 ; wally_save_fp
+
+// t0 = 8-byte aligned base of the f0-f31 save area
+.macro portasmFREG_BASE
+	addi t0, sp, ( 3 * portWORD_SIZE + 7 )
+	andi t0, t0, -8
+	.endm
+
+.macro portasmFREGS op
+	\op f0,  0  * portasmFREG_SIZE( t0 )
+	\op f1,  1  * portasmFREG_SIZE( t0 )
+	\op f2,  2  * portasmFREG_SIZE( t0 )
+	\op f3,  3  * portasmFREG_SIZE( t0 )
+	\op f4,  4  * portasmFREG_SIZE( t0 )
+	\op f5,  5  * portasmFREG_SIZE( t0 )
+	\op f6,  6  * portasmFREG_SIZE( t0 )
+	\op f7,  7  * portasmFREG_SIZE( t0 )
+	\op f8,  8  * portasmFREG_SIZE( t0 )
+	\op f9,  9  * portasmFREG_SIZE( t0 )
+	\op f10, 10 * portasmFREG_SIZE( t0 )
+	\op f11, 11 * portasmFREG_SIZE( t0 )
+	\op f12, 12 * portasmFREG_SIZE( t0 )
+	\op f13, 13 * portasmFREG_SIZE( t0 )
+	\op f14, 14 * portasmFREG_SIZE( t0 )
+	\op f15, 15 * portasmFREG_SIZE( t0 )
+	\op f16, 16 * portasmFREG_SIZE( t0 )
+	\op f17, 17 * portasmFREG_SIZE( t0 )
+	\op f18, 18 * portasmFREG_SIZE( t0 )
+	\op f19, 19 * portasmFREG_SIZE( t0 )
+	\op f20, 20 * portasmFREG_SIZE( t0 )
+	\op f21, 21 * portasmFREG_SIZE( t0 )
+	\op f22, 22 * portasmFREG_SIZE( t0 )
+	\op f23, 23 * portasmFREG_SIZE( t0 )
+	\op f24, 24 * portasmFREG_SIZE( t0 )
+	\op f25, 25 * portasmFREG_SIZE( t0 )
+	\op f26, 26 * portasmFREG_SIZE( t0 )
+	\op f27, 27 * portasmFREG_SIZE( t0 )
+	\op f28, 28 * portasmFREG_SIZE( t0 )
+	\op f29, 29 * portasmFREG_SIZE( t0 )
+	\op f30, 30 * portasmFREG_SIZE( t0 )
+	\op f31, 31 * portasmFREG_SIZE( t0 )
+	.endm
+
+// The integer registers are already in the frame, so t0 and t1 are free.
+.macro wally_save_fp
+	addi sp, sp, -( portasmADDITIONAL_CONTEXT_SIZE * portWORD_SIZE )
+	csrr t0, mstatus
+	srli t0, t0, 13
+	andi t0, t0, 3
+	store_x t0, 1 * portWORD_SIZE( sp )
+	addi t1, x0, portasmFS_CLEAN
+	bltu t0, t1, wally_fp_save_done\@
+	frcsr t1
+	store_x t1, 2 * portWORD_SIZE( sp )
+	portasmFREG_BASE
+	portasmFREGS portasmFSTORE
+	// The frame now matches the FP registers: mark FS Clean live and in the saved mstatus
+	li t0, portasmFS_DIRTY_BIT
+	csrc mstatus, t0
+	load_x t1, ( portasmADDITIONAL_CONTEXT_SIZE + wally_mstatus_word ) * portWORD_SIZE( sp )
+	not t0, t0
+	and t1, t1, t0
+	store_x t1, ( portasmADDITIONAL_CONTEXT_SIZE + wally_mstatus_word ) * portWORD_SIZE( sp )
+wally_fp_save_done\@:
+	.endm
+
+// The outgoing task may have FS = Initial, so set FS before touching the FP registers.
+// The port rewrites mstatus from the frame right after this, restoring the task's own FS,
+// which is Clean for any frame holding FP state.
+.macro portasmRESTORE_ADDITIONAL_REGISTERS
+	load_x t0, 1 * portWORD_SIZE( sp )
+	addi t1, x0, portasmFS_CLEAN
+	bltu t0, t1, wally_fp_restore_done\@
+	li t0, 0x6000
+	csrs mstatus, t0
+	load_x t1, 2 * portWORD_SIZE( sp )
+	fscsr t1
+	portasmFREG_BASE
+	portasmFREGS portasmFLOAD
+wally_fp_restore_done\@:
+	addi sp, sp, ( portasmADDITIONAL_CONTEXT_SIZE * portWORD_SIZE )
+	.endm
+
+#else // no FPU
+
+#define portasmADDITIONAL_CONTEXT_SIZE 0
+
+.macro portasmSAVE_ADDITIONAL_REGISTERS
+	.endm
+
+.macro portasmRESTORE_ADDITIONAL_REGISTERS
+	.endm
+
+#endif
+
+#endif
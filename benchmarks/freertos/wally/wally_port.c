@@ -0,0 +1,195 @@
+///////////////////////////////////////////
+// wally_port.c
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified:
+//
+// Purpose: Board support for FreeRTOS on Wally: console, exit, interrupt and exception
+//          handlers, and the optional Sstc tick
+//
+// Documentation: RISC-V System on Chip Design
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+//
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied. See the License for the specific language governing permissions
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stddef.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "wally_port.h"
+
+#define UART_THR ((volatile uint8_t *)0x10000000)
+#define UART_LSR ((volatile uint8_t *)0x10000005)
+
+extern volatile uint64_t tohost;
+
+// The kernel needs these and the benchmark is linked without a C library
+void *memset(void *dst, int c, size_t n) {
+  uint8_t *d = dst;
+  while (n--) *d++ = (uint8_t)c;
+  return dst;
+}
+
+void *memcpy(void *dst, const void *src, size_t n) {
+  uint8_t *d = dst;
+  const uint8_t *s = src;
+  while (n--) *d++ = *s++;
+  return dst;
+}
+
+// uartPC16550D.sv echoes every transmitted character to the simulator console
+void wally_putchar(char c) {
+  while (!(*UART_LSR & 0x20));
+  *UART_THR = c;
+}
+
+void wally_puts(const char *s) {
+  while (*s) wally_putchar(*s++);
+}
+
+void wally_putu(unsigned long n) {
+  char buf[24];
+  int i = 0;
+  do {
+    buf[i++] = '0' + n % 10;
+    n /= 10;
+  } while (n);
+  while (i) wally_putchar(buf[--i]);
+}
+
+void wally_puthex(unsigned long n) {
+  int i;
+  wally_puts("0x");
+  for (i = sizeof(n) * 8 - 4; i >= 0; i -= 4) wally_putchar("0123456789abcdef"[(n >> i) & 0xF]);
+}
+
+// A 32-bit store to tohost ends the simulation (see TestComplete in testbench.sv)
+void wally_exit(int code) {
+  taskDISABLE_INTERRUPTS();
+  *(volatile uint32_t *)&tohost = (code << 1) | 1;
+  for (;;);
+}
+
+void vWallyAssert(const char *file, int line) {
+  wally_puts("FreeRTOS assertion failed: ");
+  wally_puts(file);
+  wally_puts(":");
+  wally_putu(line);
+  wally_puts("\n");
+  wally_exit(1);
+}
+
+void vApplicationMallocFailedHook(void) {
+  wally_puts("FreeRTOS heap exhausted\n");
+  wally_exit(1);
+}
+
+void wally_clear_msip(void) {
+  *(volatile uint32_t *)WALLY_CLINT_MSIP = 0;
+}
+
+// Weak default for the benchmark's software interrupt hook
+__attribute__((weak)) void wally_software_interrupt(void) {
+  wally_clear_msip();
+}
+
+#if configWALLY_SSTC_TICK
+static uint64_t ullNextTime;
+static const uint64_t uxTimerIncrementsForOneTick = configCPU_CLOCK_HZ / configTICK_RATE_HZ;
+
+static uint64_t wally_time(void) {
+#if __riscv_xlen == 64
+  uint64_t t;
+  asm volatile("csrr %0, time" : "=r"(t));
+  return t;
+#else
+  uint32_t hi, lo, hi2;
+  do {
+    asm volatile("csrr %0, timeh" : "=r"(hi));
+    asm volatile("csrr %0, time" : "=r"(lo));
+    asm volatile("csrr %0, timeh" : "=r"(hi2));
+  } while (hi != hi2);
+  return ((uint64_t)hi << 32) | lo;
+#endif
+}
+
+// stimecmp is 0x14D and stimecmph is 0x15D; written by number for older assemblers
+static void wally_set_stimecmp(uint64_t t) {
+#if __riscv_xlen == 64
+  asm volatile("csrw 0x14D, %0" :: "r"(t));
+#else
+  asm volatile("csrw 0x15D, %0" :: "r"(0xFFFFFFFF)); // no spurious match while the halves disagree
+  asm volatile("csrw 0x14D, %0" :: "r"((uint32_t)t));
+  asm volatile("csrw 0x15D, %0" :: "r"((uint32_t)(t >> 32)));
+#endif
+}
+
+// Called by xPortStartScheduler when configMTIME_BASE_ADDRESS is 0
+void vPortSetupTimerInterrupt(void) {
+  // menvcfg.STCE (bit 63; menvcfgh 0x31A bit 31 on RV32) turns on stimecmp
+#if __riscv_xlen == 64
+  asm volatile("csrs 0x30A, %0" :: "r"(1UL << 63));
+#else
+  asm volatile("csrs 0x31A, %0" :: "r"(1UL << 31));
+#endif
+  ullNextTime = wally_time() + uxTimerIncrementsForOneTick;
+  wally_set_stimecmp(ullNextTime);
+  asm volatile("csrs mie, %0" :: "r"(0x20)); // STIE only; mtimecmp is left alone and MTIE stays off
+}
+#endif
+
+// Called by the port for every interrupt except the CLINT tick
+void freertos_risc_v_application_interrupt_handler(void) {
+  unsigned long cause;
+  asm volatile("csrr %0, mcause" : "=r"(cause));
+  switch (cause & 0xFFF) {
+    case 3: // machine software interrupt from the CLINT MSIP register
+      wally_software_interrupt();
+      break;
+#if configWALLY_SSTC_TICK
+    case 5: // supervisor timer interrupt from stimecmp, taken in M-mode because it is not delegated
+      ullNextTime += uxTimerIncrementsForOneTick;
+      wally_set_stimecmp(ullNextTime);
+      if (xTaskIncrementTick() != pdFALSE) vTaskSwitchContext();
+      break;
+#endif
+    default:
+      wally_puts("Unexpected interrupt, mcause = ");
+      wally_puthex(cause);
+      wally_puts("\n");
+      wally_exit(1);
+  }
+}
+
+// Called by the port for every exception except ecall from M-mode, which it uses to yield
+void freertos_risc_v_application_exception_handler(void) {
+  unsigned long cause, epc, tval;
+  asm volatile("csrr %0, mcause" : "=r"(cause));
+  asm volatile("csrr %0, mepc" : "=r"(epc));
+  asm volatile("csrr %0, mtval" : "=r"(tval));
+  wally_puts("Unexpected exception, mcause = ");
+  wally_puthex(cause);
+  wally_puts(" mepc = ");
+  wally_puthex(epc);
+  wally_puts(" mtval = ");
+  wally_puthex(tval);
+  wally_puts("\n");
+  wally_exit(1);
+}
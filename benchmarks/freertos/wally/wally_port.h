@@ -0,0 +1,54 @@
+///////////////////////////////////////////
+// wally_port.h
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified:
+//
+// Purpose: Board support interface shared by the FreeRTOS port and benchmark
+//
+// Documentation: RISC-V System on Chip Design
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+//
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied. See the License for the specific language governing permissions
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef WALLY_PORT_H
+#define WALLY_PORT_H
+
+#include "FreeRTOSConfig.h"
+
+#define WALLY_CLINT_MSIP (configWALLY_CLINT_BASE + 0x0000UL)
+
+void wally_putchar(char c);
+void wally_puts(const char *s);
+void wally_putu(unsigned long n);
+void wally_puthex(unsigned long n);
+void wally_exit(int code);
+void wally_clear_msip(void);
+
+// Called from the machine software interrupt; the default only clears MSIP
+void wally_software_interrupt(void);
+
+static inline unsigned long wally_cycles(void) {
+  unsigned long c;
+  asm volatile("csrr %0, mcycle" : "=r"(c));
+  return c;
+}
+
+#endif
@@ -0,0 +1,279 @@
+#!/usr/bin/env python3
+
+###########################################
+## etrace-decode.py
+##
+## Written: CORE-V-Wally contributors 19 October 2026
+## Created: 19 October 2026
+## Modified:
+##
+## Purpose: Rebuild the retired PC stream from packets captured by the trace buffer (trace_apb.sv)
+##          and the ELF that was running.  See src/trace/etrace.sv for the packet formats.
+##
+## A component of the CORE-V-WALLY configurable RISC-V project.
+## https://github.com/openhwgroup/cvw
+##
+## Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+##
+## SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+##
+## Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+## except in compliance with the License, or, at your option, the Apache License version 2.0. You
+## may obtain a copy of the License at
+##
+## https:##solderpad.org/licenses/SHL-2.1/
+##
+## Unless required by applicable law or agreed to in writing, any work distributed under the
+## License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+## either express or implied. See the License for the specific language governing permissions
+## and limitations under the License.
+################################################################################################
+
+# how to invoke this decoder:
+# etrace-decode.py <elf> <trace dump> [--xlen 32|64] [--binary] [--first N] [-v]
+# The trace dump is the buffer read back from TRACE_BASE+0x8000, oldest entry first.
+# Each text line holds one entry, either as eight 32-bit hex words starting with word 0
+# or as a single 256-bit hex number.  With --binary the dump is raw memory, 32 bytes per entry.
+# If the buffer wrapped, pass --first <write index from the status register> to start at the oldest entry.
+# Empty entries (zero length header) are skipped.
+# The decoder prints one retired PC per line; traps are printed as comments.
+# With --check <retired log>, the decoded stream is instead compared with the PCs the testbench
+# logged while tracing was enabled (one hex PC per line), allowing a few unreported instructions
+# around enabling and disabling the trace.
+
+import sys
+import io
+import struct
+import argparse
+import contextlib
+
+class Memory:
+    """Loadable segments of an ELF file, used to look up instructions"""
+    def __init__(self, elfname):
+        self.segments = []
+        with open(elfname, "rb") as f:
+            data = f.read()
+        if data[0:4] != b"\x7fELF":
+            sys.exit(elfname + " is not an ELF file")
+        is64 = data[4] == 2
+        if is64:
+            (phoff, phentsize, phnum) = (struct.unpack_from("<Q", data, 0x20)[0],
+                struct.unpack_from("<H", data, 0x36)[0], struct.unpack_from("<H", data, 0x38)[0])
+        else:
+            (phoff, phentsize, phnum) = (struct.unpack_from("<I", data, 0x1C)[0],
+                struct.unpack_from("<H", data, 0x2A)[0], struct.unpack_from("<H", data, 0x2C)[0])
+        for i in range(phnum):
+            off = phoff + i*phentsize
+            if is64:
+                (ptype, _, poffset, pvaddr, ppaddr, pfilesz) = struct.unpack_from("<IIQQQQ", data, off)
+            else:
+                (ptype, poffset, pvaddr, ppaddr, pfilesz) = struct.unpack_from("<IIIII", data, off)
+            if ptype == 1: # PT_LOAD
+                self.segments.append((pvaddr, data[poffset:poffset+pfilesz]))
+
+    def half(self, adr):
+        for (base, contents) in self.segments:
+            if base <= adr and adr + 2 <= base + len(contents):
+                return struct.unpack_from("<H", contents, adr - base)[0]
+        raise KeyError(adr)
+
+    def instr(self, adr):
+        lo = self.half(adr)
+        if lo & 3 != 3:
+            return (lo, 2)
+        return (lo | (self.half(adr + 2) << 16), 4)
+
+def sext(val, bits):
+    return val - (1 << bits) if val & (1 << (bits-1)) else val
+
+def bits(val, hi, lo):
+    return (val >> lo) & ((1 << (hi-lo+1)) - 1)
+
+def classify(instr, length, pc, xlen):
+    """Return the kind of control flow instruction and its target if it can be inferred"""
+    if length == 4:
+        op = instr & 0x7F
+        if op == 0x63:
+            imm = (bits(instr,31,31) << 12) | (bits(instr,7,7) << 11) | (bits(instr,30,25) << 5) | (bits(instr,11,8) << 1)
+            return ("branch", pc + sext(imm, 13))
+        if op == 0x6F:
+            imm = (bits(instr,31,31) << 20) | (bits(instr,19,12) << 12) | (bits(instr,20,20) << 11) | (bits(instr,30,21) << 1)
+            return ("jump", pc + sext(imm, 21))
+        if op == 0x67:
+            return ("updiscon", None)
+        if instr in (0x30200073, 0x10200073): # mret, sret
+            return ("updiscon", None)
+        return ("other", None)
+    quadrant = instr & 3
+    funct3 = bits(instr,15,13)
+    if quadrant == 1 and (funct3 == 5 or (funct3 == 1 and xlen == 32)): # c.j, c.jal
+        imm = (bits(instr,12,12) << 11) | (bits(instr,8,8) << 10) | (bits(instr,10,9) << 8) | (bits(instr,6,6) << 7) | \
+              (bits(instr,7,7) << 6) | (bits(instr,2,2) << 5) | (bits(instr,11,11) << 4) | (bits(instr,5,3) << 1)
+        return ("jump", pc + sext(imm, 12))
+    if quadrant == 1 and funct3 in (6, 7): # c.beqz, c.bnez
+        imm = (bits(instr,12,12) << 8) | (bits(instr,6,5) << 6) | (bits(instr,2,2) << 5) | (bits(instr,11,10) << 3) | (bits(instr,4,3) << 1)
+        return ("branch", pc + sext(imm, 9))
+    if quadrant == 2 and funct3 == 4 and bits(instr,11,7) != 0 and bits(instr,6,2) == 0: # c.jr, c.jalr
+        return ("updiscon", None)
+    return ("other", None)
+
+class Decoder:
+    def __init__(self, mem, xlen, verbose):
+        self.mem = mem
+        self.xlen = xlen
+        self.verbose = verbose
+        self.mask = (1 << xlen) - 1
+        self.cur = None
+        self.limit = 1 << 20 # give up on a walk that never reaches its address
+
+    def retire(self):
+        """Emit the current instruction and return its control flow class"""
+        (instr, length) = self.mem.instr(self.cur)
+        print("%x" % self.cur)
+        (kind, target) = classify(instr, length, self.cur, self.xlen)
+        return (kind, target, (self.cur + length) & self.mask)
+
+    def walk(self, brmap, count, adr, updiscon=False):
+        """Follow the program from cur, using count branch outcomes, until reaching adr.
+           With updiscon, stop at the jump to adr instead; with adr None, stop after the last outcome."""
+        if self.cur is None: # not yet synchronized; every address names the next instruction to retire
+            self.cur = adr
+            return
+        steps = 0
+        while True:
+            if adr is not None and count == 0 and self.cur == adr and not updiscon:
+                return
+            if adr is None and count == 0:
+                return
+            steps += 1
+            if steps > self.limit:
+                print("# walk did not reach %s; resynchronizing" % ("%x" % adr if adr is not None else "the end of the map"))
+                self.cur = adr
+                return
+            try:
+                (kind, target, nextpc) = self.retire()
+            except KeyError:
+                print("# no instruction at %x in the ELF; resynchronizing" % self.cur)
+                self.cur = adr
+                return
+            if kind == "branch":
+                if count == 0:
+                    print("# branch at %x with no outcome left; resynchronizing" % self.cur)
+                    self.cur = adr
+                    return
+                taken = (brmap & 1) == 0
+                brmap >>= 1
+                count -= 1
+                self.cur = target & self.mask if taken else nextpc
+            elif kind == "jump" and (target & self.mask) > self.cur:
+                self.cur = target & self.mask
+            elif kind in ("jump", "updiscon"): # backward jumps and indirect jumps always send their target
+                if adr is None:
+                    print("# jump at %x in a full branch map; trace lost" % self.cur)
+                    self.cur = None
+                    return
+                self.cur = adr
+                return
+            else:
+                self.cur = nextpc
+
+    def packet(self, payload, nbytes):
+        xlen = self.xlen
+        fmt = bits(payload, 1, 0)
+        if fmt == 3:
+            sub = bits(payload, 3, 2)
+            priv = bits(payload, 6, 5)
+            if sub == 0:
+                adr = bits(payload, xlen+5, 7) << 1
+                if self.verbose:
+                    print("# sync %x priv %d" % (adr, priv))
+                self.walk(0, 0, adr)
+            elif sub == 1:
+                ecause = bits(payload, 12, 7)
+                interrupt = bits(payload, 13, 13)
+                adr = bits(payload, xlen+13, 15) << 1
+                tval = bits(payload, 2*xlen+13, xlen+14)
+                print("# %s %d at %s tval %x, handler %x priv %d" % ("interrupt" if interrupt else "exception",
+                    ecause, "%x" % self.cur if self.cur is not None else "?", tval, adr, priv))
+                self.cur = adr
+            else:
+                print("# unsupported format 3 subformat %d" % sub)
+        elif fmt == 2:
+            adr = bits(payload, xlen, 2) << 1
+            self.walk(0, 0, adr, bits(payload, xlen+2, xlen+2) != bits(adr, xlen-1, xlen-1))
+        elif fmt == 1:
+            count = bits(payload, 6, 2)
+            if count == 0:
+                if self.cur is not None:
+                    self.walk(bits(payload, 37, 7), 31, None)
+            else:
+                mw = 1 if count == 1 else 9 if count <= 9 else 17 if count <= 17 else 25 if count <= 25 else 31
+                adr = bits(payload, 5+mw+xlen, 7+mw) << 1
+                self.walk(bits(payload, 6+mw, 7), count, adr, bits(payload, 7+mw+xlen, 7+mw+xlen) != bits(adr, xlen-1, xlen-1))
+        else:
+            print("# unsupported format 0 packet")
+
+def entries(args):
+    if args.binary:
+        with open(args.trace, "rb") as f:
+            data = f.read()
+        for i in range(0, len(data) - 31, 32):
+            yield int.from_bytes(data[i:i+32], "little")
+    else:
+        with open(args.trace) as f:
+            for line in f:
+                words = line.split()
+                if len(words) == 8:
+                    yield sum(int(w, 16) << (32*i) for (i, w) in enumerate(words))
+                elif len(words) == 1:
+                    yield int(words[0], 16)
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode a Wally E-Trace buffer dump into a PC stream")
+    parser.add_argument("elf", help="program that was traced")
+    parser.add_argument("trace", help="trace buffer dump")
+    parser.add_argument("--xlen", type=int, default=64, choices=[32, 64])
+    parser.add_argument("--binary", action="store_true", help="dump is raw memory rather than hex text")
+    parser.add_argument("--first", type=int, default=0, help="index of the oldest entry in a wrapped buffer")
+    parser.add_argument("-v", "--verbose", action="store_true", help="print sync packets")
+    parser.add_argument("--check", metavar="RETIRED", help="compare the decoded stream with a log of retired PCs")
+    args = parser.parse_args()
+
+    decoder = Decoder(Memory(args.elf), args.xlen, args.verbose)
+    packets = list(entries(args))
+    packets = packets[args.first:] + packets[:args.first]
+    decoded = io.StringIO()
+    with contextlib.redirect_stdout(decoded if args.check else sys.stdout):
+        for p in packets:
+            nbytes = p & 0x1F
+            if nbytes != 0:
+                decoder.packet(p >> 8, nbytes)
+    if args.check:
+        sys.exit(check(decoded.getvalue().splitlines(), args.check))
+
+def check(lines, retiredname, slack=16):
+    """The decoded PCs must be the retired PCs, missing at most slack instructions at either end"""
+    comments = [l for l in lines if l.startswith("#")]
+    decoded = [int(l, 16) for l in lines if l and not l.startswith("#")]
+    with open(retiredname) as f:
+        retired = [int(l, 16) for l in f if l.strip()]
+    for c in comments:
+        print(c)
+    print("decoded %d of %d retired instructions" % (len(decoded), len(retired)))
+    if not decoded or comments:
+        print("E-Trace round trip FAILED")
+        return 1
+    for start in range(min(slack, len(retired)) + 1):
+        if retired[start:start+len(decoded)] == decoded and len(retired) - start - len(decoded) <= slack:
+            print("E-Trace round trip passed")
+            return 0
+    first = retired.index(decoded[0]) if decoded[0] in retired[:slack+1] else 0
+    for (i, (d, r)) in enumerate(zip(decoded, retired[first:])):
+        if d != r:
+            print("first difference at instruction %d: decoded %x, retired %x" % (i, d, r))
+            break
+    print("E-Trace round trip FAILED")
+    return 1
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,352 @@
+#!/usr/bin/env python3
+
+###########################################
+## paretoExplore.py
+##
+## Written: CORE-V-Wally contributors 19 October 2026
+## Created: 19 October 2026
+## Modified:
+##
+## Purpose: Explore Wally configuration parameters for the performance/area/energy Pareto frontier.
+##          Each design point is written as a derivative configuration in config/deriv, simulated on
+##          embench for CPI, and synthesized with synthDC for fmax, area, and power.  Simulations and
+##          syntheses run in parallel and their results are cached, so an interrupted or extended
+##          search only runs new points.  Points are chosen by a surrogate-guided search: neighbors of
+##          the current frontier and random points are scored by an inverse-distance-weighted model of
+##          the evaluated points, and those predicted to be Pareto-optimal are evaluated next.
+##
+##          The frontier is written to pareto.csv, and pareto-derivlist.txt holds each frontier point
+##          in config/derivlist.txt format so it can be pasted there to reproduce it.
+##
+##          Embench is built for rv32imac, so the base must be an rv32 configuration.  Its integer
+##          divides use the divider in the mdu, or fdivsqrt when IDIV_ON_FPU = 1, which is the only way
+##          RADIX and DIVCOPIES affect its run time.  When the divider parameters are searched, the CPI
+##          of the divide-heavy benchmarks (--divbench) is a separate objective, so the divider is not
+##          judged by its area alone.
+##
+##          Example: paretoExplore.py -b rv32gc -n 40 -j 8 -e sky90 -t 500
+##          Use --space to search a JSON dictionary of {parameter: [values]} instead of the default,
+##          and --dryrun to write the configurations and print the commands without running them.
+##
+## A component of the CORE-V-WALLY configurable RISC-V project.
+## https://github.com/openhwgroup/cvw
+##
+## Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+##
+## SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+##
+## Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+## except in compliance with the License, or, at your option, the Apache License version 2.0. You
+## may obtain a copy of the License at
+##
+## https:##solderpad.org/licenses/SHL-2.1/
+##
+## Unless required by applicable law or agreed to in writing, any work distributed under the
+## License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+## either express or implied. See the License for the specific language governing permissions
+## and limitations under the License.
+################################################################################################
+
+import argparse
+import csv
+import datetime
+import hashlib
+import json
+import math
+import os
+import random
+import re
+import subprocess
+import sys
+from concurrent.futures import ThreadPoolExecutor
+
+WALLY = os.environ.get('WALLY', os.path.abspath(os.path.join(os.path.dirname(__file__), '..')))
+
+# Values are written into config.vh exactly as given, like the entries of config/derivlist.txt,
+# and compared by numeric value, so 32'h10 and 32'd16 are the same setting.
+# Way sizes stop at 4096 bytes because the caches are virtually indexed with 4 KiB pages.
+DefaultSpace = {
+    'DCACHE_NUMWAYS':        ["32'd1", "32'd2", "32'd4", "32'd8"],
+    'DCACHE_WAYSIZEINBYTES': ["32'd1024", "32'd2048", "32'd4096"],
+    'ICACHE_NUMWAYS':        ["32'd1", "32'd2", "32'd4", "32'd8"],
+    'ICACHE_WAYSIZEINBYTES': ["32'd1024", "32'd2048", "32'd4096"],
+    'BPRED_SIZE':            ["32'd6", "32'd8", "32'd10", "32'd12", "32'd14"],
+    'BTB_SIZE':              ["32'd6", "32'd8", "32'd10", "32'd12"],
+    'ITLB_ENTRIES':          ["32'd8", "32'd16", "32'd32"],
+    'DTLB_ENTRIES':          ["32'd8", "32'd16", "32'd32"],
+    'IDIV_BITSPERCYCLE':     ["32'd1", "32'd2", "32'd4"],
+    'IDIV_ON_FPU':           ["0", "1"],
+    'RADIX':                 ["32'd2", "32'd4"],
+    'DIVCOPIES':             ["32'd1", "32'd2", "32'd4"]
+}
+
+Objectives = ['TimePerInstr', 'Area', 'EnergyPerInstr'] # all minimized
+DivParams = ['IDIV_BITSPERCYCLE', 'IDIV_ON_FPU', 'RADIX', 'DIVCOPIES']
+
+###########################################
+# Design points
+###########################################
+
+def Value(value):
+    '''Numeric value of a config.vh setting such as 4, 32'd4, 32'h4 or 1'b1; other settings are
+    returned as strings with spaces removed.'''
+    value = str(value).replace(' ', '')
+    m = re.fullmatch(r"(\d*)'([sS]?)([bBoOdDhH])([0-9a-fA-F_]+)", value)
+    if m: return int(m.group(4).replace('_', ''), {'b': 2, 'o': 8, 'd': 10, 'h': 16}[m.group(3).lower()])
+    if re.fullmatch(r'[\d_]+', value): return int(value.replace('_', ''))
+    return value
+
+def PointKey(point):
+    '''Hash of a design point's parameter values; names its configuration and its cache entries.'''
+    return hashlib.sha1(json.dumps({p: Value(v) for p, v in point.items()}, sort_keys=True).encode()).hexdigest()[:10]
+
+def PointName(point):
+    return 'pareto_' + PointKey(point) + '_' + args.base
+
+def BaseValues(space):
+    '''Index of the base configuration's setting of each parameter, or None if it is not in the list.'''
+    base = open(os.path.join(WALLY, 'config', args.base, 'config.vh')).read()
+    indices = {}
+    for param, values in space.items():
+        m = re.search(r'localparam\s+' + param + r'\s*=\s*(.*?);', base)
+        if m is None:
+            sys.exit(f'Error: {param} not found in config/{args.base}/config.vh')
+        value = Value(m.group(1))
+        indices[param] = next((i for i, v in enumerate(values) if Value(v) == value), None)
+    return indices
+
+def WriteConfig(point):
+    '''Derive config/deriv/<name>/config.vh from the base configuration, as derivgen.pl does.'''
+    name = PointName(point)
+    dir = os.path.join(WALLY, 'config', 'deriv', name)
+    os.makedirs(dir, exist_ok=True)
+    lines = open(os.path.join(WALLY, 'config', args.base, 'config.vh')).readlines()
+    hit = set()
+    with open(os.path.join(dir, 'config.vh'), 'w') as config:
+        config.write(f'// Config {name} automatically derived from {args.base} on {datetime.datetime.now().ctime()} using paretoExplore.py\n')
+        for line in lines:
+            for param, value in point.items():
+                (line, n) = re.subn(r'\b' + param + r'\s*=\s*.*;', f'{param} = {value};', line)
+                if n: hit.add(param)
+            config.write(line)
+    for param in point:
+        if param not in hit: print(f'Unable to find {param} in {name}')
+    return name
+
+###########################################
+# Evaluation
+###########################################
+
+def RunCommand(cmd, cwd):
+    if args.dryrun:
+        print(f'cd {cwd}; {cmd}')
+        return
+    subprocess.run(['bash', '-c', cmd], cwd=cwd, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+
+def GeoMean(values):
+    return math.exp(sum(math.log(v) for v in values) / len(values))
+
+def Simulate(name, workdir):
+    '''Run embench on the configuration and return the geometric mean CPI of all the benchmarks and
+    of the divide-heavy ones, or None on failure.'''
+    log = os.path.join(workdir, 'sim.log')
+    cmd = args.simcmd.format(config=name, log=log)
+    RunCommand(cmd, os.path.join(WALLY, 'sim'))
+    if not os.path.exists(log): return None
+    # Same transcript format as parseHPMC.py: HPM counters are printed after each benchmark
+    cpis, divcpis, divcycles, counters = [], [], 0, {}
+    for line in open(log):
+        tokens = line.split()
+        if len(tokens) > 4 and tokens[1][0:3] == 'Cnt':
+            countTokens = line.split('=')[1].split()
+            counters[' '.join(countTokens[1:])] = int(countTokens[0]) if countTokens[0] != 'x' else 0
+        elif 'is done' in line:
+            if counters.get('InstRet', 0) > 0:
+                cpi = counters['Mcycle'] / counters['InstRet']
+                cpis.append(cpi)
+                # Embench Benchmark: bd_speedopt_speed/src/ud/ud is done.
+                if os.path.basename(tokens[2]) in args.divbench:
+                    divcpis.append(cpi)
+                    divcycles += counters.get('Divide Cycles', 0)
+            counters = {}
+    if len(cpis) == 0 or (args.divsearch and len(divcpis) == 0): return None
+    if args.divsearch and divcycles == 0: print(f'{name}: warning: {",".join(args.divbench)} spent no cycles dividing')
+    return (GeoMean(cpis), GeoMean(divcpis) if divcpis else None)
+
+def Synthesize(name, workdir):
+    '''Synthesize the configuration and return (fmax MHz, area, total power), or None on failure.'''
+    outdir = os.path.join(workdir, 'synth')
+    # USESRAM=1 keeps synthDC from shrinking the caches and predictors being explored
+    cmd = (f'make synth DESIGN=wallypipelinedcore CONFIG={name} TECH={args.tech} FREQ={args.targetfreq} '
+           f'MAXOPT={int(args.maxopt)} USESRAM=1 MAXCORES=1 OUTPUTDIR={outdir}')
+    RunCommand(cmd, os.path.join(WALLY, 'synthDC'))
+    metricReg = re.compile(r'-?\d+\.\d+[e]?[-+]?\d*')
+    try:
+        qor = open(os.path.join(outdir, 'reports', 'qor.rep')).read()
+        slack = float(metricReg.findall(re.search(r'Path Slack.*', qor).group(0))[0])
+        area = float(metricReg.findall(re.search(r'Design Area.*', qor).group(0))[0])
+        power = 0.0
+        for line in open(os.path.join(outdir, 'reports', 'power.rep')):
+            if line.split()[0:1] == ['wallypipelinedcore']:
+                power = float(metricReg.findall(line)[3]) # switching, internal, leakage, total
+                break
+    except (OSError, AttributeError, IndexError):
+        return None
+    delay = 1000.0/args.targetfreq - slack
+    return (1000.0/delay, area, power)
+
+def Evaluate(point):
+    '''Run (or look up) simulation and synthesis of a point.  Returns the point's result dictionary.'''
+    key = PointKey(point)
+    workdir = os.path.join(args.workdir, key)
+    os.makedirs(workdir, exist_ok=True)
+    resultFile = os.path.join(workdir, f'result_{args.tech}_{args.targetfreq}.json')
+    if os.path.exists(resultFile):
+        result = json.load(open(resultFile))
+        if result.get('Failed') or all(o in result for o in Objectives): return result
+    name = WriteConfig(point)
+    with ThreadPoolExecutor(2) as pool: # simulate and synthesize concurrently; the tools are separate processes
+        sim = pool.submit(Simulate, name, workdir)
+        synth = pool.submit(Synthesize, name, workdir)
+        (sim, synth) = (sim.result(), synth.result())
+    result = {'Name': name, 'Params': point}
+    if args.dryrun:
+        result['Failed'] = True
+    elif sim is None or synth is None:
+        result['Failed'] = True
+        print(f'{name}: {"simulation" if sim is None else "synthesis"} failed; see {workdir}')
+    else:
+        ((cpi, divcpi), (fmax, area, power)) = (sim, synth)
+        result.update({'CPI': cpi, 'Fmax': fmax, 'Area': area, 'Power': power,
+                       'TimePerInstr': cpi / fmax * 1000,      # ns
+                       'EnergyPerInstr': power * cpi / fmax})  # power units / MHz, nJ if power is in mW
+        if divcpi is not None: result.update({'DivCPI': divcpi, 'DivTimePerInstr': divcpi / fmax * 1000})
+        print(f'{name}: CPI {cpi:.3f} fmax {fmax:.0f} MHz area {area:.0f}')
+    if not args.dryrun: json.dump(result, open(resultFile, 'w'), indent=1)
+    return result
+
+###########################################
+# Search
+###########################################
+
+def Dominates(a, b):
+    return all(a[o] <= b[o] for o in Objectives) and any(a[o] < b[o] for o in Objectives)
+
+def ParetoFront(results):
+    good = [r for r in results if not r.get('Failed')]
+    return [r for r in good if not any(Dominates(s, r) for s in good)]
+
+def ToPoint(indices, space):
+    return {param: space[param][i] for param, i in indices.items()}
+
+def ToIndices(point, space):
+    return {param: space[param].index(value) for param, value in point.items()}
+
+def Distance(a, b, space):
+    '''Distance between two points, with each parameter's index range normalized to 1.'''
+    return math.sqrt(sum(((a[p] - b[p]) / max(1, len(space[p]) - 1))**2 for p in space))
+
+def Predict(indices, evaluated, space):
+    '''Inverse-distance-weighted estimate of each objective from the evaluated points.'''
+    weights, pred = [], {o: 0.0 for o in Objectives}
+    for (idx, r) in evaluated:
+        weights.append((1.0 / max(Distance(indices, idx, space), 1e-6)**2, r))
+    total = sum(w for (w, r) in weights)
+    for (w, r) in weights:
+        for o in Objectives: pred[o] += w * r[o] / total
+    return pred
+
+def Propose(results, evaluatedKeys, space, count):
+    '''Choose up to count unevaluated points: neighbors of the frontier and random points, ranked
+    by whether the surrogate predicts they are non-dominated, then by distance from evaluated points.'''
+    good = [(ToIndices(r['Params'], space), r) for r in results if not r.get('Failed')]
+    candidates = []
+    for r in ParetoFront(results):
+        idx = ToIndices(r['Params'], space)
+        for p in space:
+            for step in (-1, 1):
+                if 0 <= idx[p] + step < len(space[p]):
+                    candidates.append(dict(idx, **{p: idx[p] + step}))
+    candidates += [{p: random.randrange(len(v)) for p, v in space.items()} for i in range(20*count)]
+    unique = {}
+    for c in candidates:
+        key = PointKey(ToPoint(c, space))
+        if key not in evaluatedKeys: unique[key] = c
+    if len(good) == 0: return [ToPoint(c, space) for c in list(unique.values())[:count]]
+    scored = []
+    for c in unique.values():
+        pred = Predict(c, good, space)
+        dominated = any(Dominates(r, pred) for (idx, r) in good)
+        novelty = min(Distance(c, idx, space) for (idx, r) in good)
+        scored.append((dominated, -novelty, c))
+    scored.sort(key=lambda s: (s[0], s[1]))
+    return [ToPoint(c, space) for (d, n, c) in scored[:count]]
+
+def WriteFront(results, space):
+    front = sorted(ParetoFront(results), key=lambda r: r['TimePerInstr'])
+    with open(os.path.join(args.workdir, 'pareto.csv'), 'w', newline='') as f:
+        writer = csv.writer(f)
+        writer.writerow(['Name', 'CPI', 'Fmax (MHz)', 'Time/Instr (ns)', 'Area', 'Power', 'Energy/Instr'] +
+                        (['Divide CPI'] if args.divsearch else []) + list(space))
+        for r in front:
+            writer.writerow([r['Name'], f"{r['CPI']:.4f}", f"{r['Fmax']:.1f}", f"{r['TimePerInstr']:.4f}",
+                             f"{r['Area']:.0f}", f"{r['Power']:.4g}", f"{r['EnergyPerInstr']:.4g}"] +
+                            ([f"{r['DivCPI']:.4f}"] if args.divsearch else []) + [r['Params'][p] for p in space])
+    with open(os.path.join(args.workdir, 'pareto-derivlist.txt'), 'w') as f:
+        f.write(f'# Pareto frontier of {args.base} in {args.tech} at {args.targetfreq} MHz target, from paretoExplore.py\n')
+        for r in front:
+            f.write(f"# CPI {r['CPI']:.4f} fmax {r['Fmax']:.1f} MHz area {r['Area']:.0f} energy/instr {r['EnergyPerInstr']:.4g}\n")
+            f.write(f"deriv {r['Name']} {args.base}\n")
+            for p in space: f.write(f"{p:<22} {r['Params'][p]}\n")
+            f.write('\n')
+    print(f'{len(front)} Pareto-optimal points of {len(results)} written to {args.workdir}/pareto.csv')
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Search Wally configuration parameters for the performance/area/energy Pareto frontier')
+    parser.add_argument('-b', '--base', default='rv32gc', help='Base configuration in config/; must be rv32 to run embench')
+    parser.add_argument('-s', '--space', help='JSON file of {parameter: [values]} to search instead of the default space')
+    parser.add_argument('-n', '--points', type=int, default=32, help='Number of design points to evaluate, including cached ones')
+    parser.add_argument('-i', '--initial', type=int, default=8, help='Random points evaluated before the guided search')
+    parser.add_argument('-j', '--jobs', type=int, default=4, help='Design points evaluated in parallel')
+    parser.add_argument('-e', '--tech', default='sky90', help='Synthesis technology')
+    parser.add_argument('-t', '--targetfreq', type=int, default=500, help='Synthesis target frequency (MHz)')
+    parser.add_argument('-o', '--maxopt', action='store_true', help='Turn on MAXOPT in synthesis')
+    parser.add_argument('-w', '--workdir', default=os.path.join(WALLY, 'synthDC', 'pareto'), help='Directory for results and the cache')
+    parser.add_argument('--simcmd', default='vsim > {log} -c <<!\ndo wally-batch.do {config} configOptions embench -GPrintHPMCounters=1\n!',
+                        help='Command run in sim/ to measure CPI; {config} and {log} are substituted')
+    parser.add_argument('--divbench', default='ud', help='Comma-separated embench benchmarks whose CPI measures the divider')
+    parser.add_argument('--seed', type=int, default=1, help='Random seed')
+    parser.add_argument('--dryrun', action='store_true', help='Write configurations and print commands without running them')
+    args = parser.parse_args()
+
+    random.seed(args.seed)
+    args.workdir = os.path.abspath(args.workdir)
+    os.makedirs(args.workdir, exist_ok=True)
+    space = json.load(open(args.space)) if args.space else DefaultSpace
+    args.divbench = args.divbench.split(',')
+
+    # Embench is compiled for rv32imac, and its CPI is meaningless on an rv64 core
+    xlen = re.search(r'localparam\s+XLEN\s*=\s*(.*?);', open(os.path.join(WALLY, 'config', args.base, 'config.vh')).read())
+    if 'embench' in args.simcmd and (xlen is None or Value(xlen.group(1)) != 32):
+        sys.exit(f'Error: embench needs an rv32 base configuration; {args.base} is not rv32')
+
+    # The divider only shows up in the CPI of benchmarks that divide, so they get an objective of their own
+    args.divsearch = any(p in space for p in DivParams)
+    if args.divsearch: Objectives.append('DivTimePerInstr')
+
+    # Start from the base configuration (where its settings are in the space) and random points
+    baseIdx = BaseValues(space)
+    first = {p: (i if i is not None else len(space[p]) // 2) for p, i in baseIdx.items()}
+    queue = [ToPoint(first, space)]
+    queue += [ToPoint({p: random.randrange(len(v)) for p, v in space.items()}, space) for i in range(args.initial - 1)]
+
+    results, evaluatedKeys = [], set()
+    with ThreadPoolExecutor(args.jobs) as pool:
+        while len(results) < args.points:
+            batch = [p for p in queue if PointKey(p) not in evaluatedKeys][:min(args.jobs, args.points - len(results))]
+            if len(batch) == 0: batch = Propose(results, evaluatedKeys, space, min(args.jobs, args.points - len(results)))
+            if len(batch) == 0: break # space exhausted
+            evaluatedKeys.update(PointKey(p) for p in batch)
+            results += list(pool.map(Evaluate, batch))
+            queue = []
+    if not args.dryrun: WriteFront(results, space)
@@ -88,6 +88,8 @@ def ComputeStats(benchmarks):
         dataDict['BDMR'] = 100.0 * int(dataDict['BP Dir Wrong']) / int(dataDict['Br Count'])
         dataDict['BTMR'] = 100.0 * int(dataDict['BP Target Wrong']) / (int(dataDict['Br Count']) + int(dataDict['Jump Not Return']))
         dataDict['RASMPR'] = 100.0 * int(dataDict['RAS Wrong']) / int(dataDict['Return'])
+        # indirect jump (jalr not return) mispredictions per thousand instructions.  Older logs lack the counter.
+        dataDict['IndMPKI'] = 1000.0 * int(dataDict.get('Indirect Target Wrong', 0)) / int(dataDict['InstRet'])
         dataDict['ClassMPR'] = 100.0 * int(dataDict['Instr Class Wrong']) / int(dataDict['InstRet'])
         dataDict['ICacheMR'] = 100.0 * int(dataDict['I Cache Miss']) / int(dataDict['I Cache Access'])
 
@@ -106,7 +108,7 @@ def ComputeStats(benchmarks):
 
 
 def ComputeGeometricAverage(benchmarks):
-    fields = ['BDMR', 'BTMR', 'RASMPR', 'ClassMPR', 'ICacheMR', 'DCacheMR', 'CPI', 'ICacheMT', 'DCacheMT']
+    fields = ['BDMR', 'BTMR', 'RASMPR', 'IndMPKI', 'ClassMPR', 'ICacheMR', 'DCacheMR', 'CPI', 'ICacheMT', 'DCacheMT']
     AllAve = {}
     for field in fields:
         Product = 1
@@ -120,7 +122,7 @@ def ComputeGeometricAverage(benchmarks):
     benchmarks.append(('Mean', '', AllAve))
 
 def GenerateName(predictorType, predictorParams):
-    if(predictorType == 'gshare' or  predictorType == 'twobit' or predictorType == 'btb' or predictorType == 'class' or predictorType == 'ras'):
+    if(predictorType == 'gshare' or  predictorType == 'twobit' or predictorType == 'btb' or predictorType == 'class' or predictorType == 'ras' or predictorType == 'ibtb'):
         return predictorType + predictorParams[0]
     elif(predictorParams == 'local'):
         return predictorType + predictorParams[0] + '_' + predictorParams[1]
@@ -129,7 +131,7 @@ def GenerateName(predictorType, predictorParams):
         sys.exit(-1)
 
 def ComputePredNumEntries(predictorType, predictorParams):
-    if(predictorType == 'gshare' or  predictorType == 'twobit' or predictorType == 'btb' or predictorType == 'class'):
+    if(predictorType == 'gshare' or  predictorType == 'twobit' or predictorType == 'btb' or predictorType == 'class' or predictorType == 'ibtb'):
         return 2**int(predictorParams[0])
     elif(predictorType == 'ras'):
         return int(predictorParams[0])
@@ -292,10 +294,12 @@ def ReportAsGraph(benchmarkDict, bar, FileName):
     titlesInvert = {'BDMR' : 'Branch Direction Accuracy',
               'BTMR' : 'Branch Target Accuracy',
               'RASMPR': 'RAS Accuracy',
+              'IndMPKI': 'Indirect Jump MPKI',
               'ClassMPR': 'Class Prediction Accuracy'}
     titles = {'BDMR' : 'Branch Direction Misprediction',
               'BTMR' : 'Branch Target Misprediction',
               'RASMPR': 'RAS Misprediction',
+              'IndMPKI': 'Indirect Jump MPKI',
               'ClassMPR': 'Class Misprediction'}
     if(args.summary):
         markers = ['x', '.', '+', '*', '^', 'o', ',', 's']
@@ -404,6 +408,7 @@ metric = parser.add_mutually_exclusive_group()
 metric.add_argument('-r', '--ras', action='store_const', help='Plot return address stack (RAS) performance.', default=False, const=True)
 metric.add_argument('-d', '--direction', action='store_const', help='Plot direction prediction (2-bit, Gshare, local, etc) performance.', default=False, const=True)
 metric.add_argument('-t', '--target', action='store_const', help='Plot branch target buffer (BTB) performance.', default=False, const=True)
+metric.add_argument('-j', '--indirect', action='store_const', help='Plot indirect jump target predictor mispredictions per thousand instructions.', default=False, const=True)
 metric.add_argument('-c', '--iclass', action='store_const', help='Plot instruction classification performance.', default=False, const=True)
 
 parser.add_argument('-s', '--summary', action='store_const', help='Show only the geometric average for all benchmarks.', default=False, const=True)
@@ -426,6 +431,7 @@ ReportPredictorType = 'BDMR'  # default
 if(args.ras): ReportPredictorType = 'RASMPR'
 if(args.target): ReportPredictorType = 'BTMR'
 if(args.iclass): ReportPredictorType = 'ClassMPR'
+if(args.indirect): ReportPredictorType = 'IndMPKI'
 
 # Figure how we are displaying the data
 ReportMode = 'gui' # default
@@ -26,6 +26,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 `include "BranchPredictorType.vh"
+`include "CacheReplacementType.vh"
 
 // RV32 or RV64: XLEN = 32 or 64
 localparam XLEN = 32'd32;
@@ -68,24 +69,38 @@ localparam DTLB_ENTRIES = 32'd0;
 localparam DCACHE_NUMWAYS = 32'd4;
 localparam DCACHE_WAYSIZEINBYTES = 32'd4096;
 localparam DCACHE_LINELENINBITS = 32'd512;
+localparam DCACHE_REPLACEMENT = `REPL_PLRU; // REPL_PLRU, REPL_LRU, REPL_SRRIP, REPL_BRRIP, REPL_RANDOM
+localparam DCACHE_SECTORS = 32'd1; // sectors per D$ line, each with its own valid and dirty bit; a miss fetches one sector
 localparam ICACHE_NUMWAYS = 32'd4;
 localparam ICACHE_WAYSIZEINBYTES = 32'd4096;
 localparam ICACHE_LINELENINBITS = 32'd512;
+localparam ICACHE_REPLACEMENT = `REPL_PLRU;
+localparam LOOPBUF_SUPPORTED = 0; // replay small loops from a loop buffer in front of the I$
+localparam LOOPBUF_ENTRIES = 32'd32; // 32-bit instructions held by the loop buffer
 localparam CACHE_SRAMLEN = 32'd128;
+localparam CACHE_LATENCY = 32'd1; // cycles to read the cache SRAMs; 2 registers their outputs to take them off the critical path
 
 // Integer Divider Configuration
 // IDIV_BITSPERCYCLE must be 1, 2, or 4
 localparam IDIV_BITSPERCYCLE = 32'd2;
 localparam IDIV_ON_FPU = 0;
+localparam CSRFWD_SUPPORTED = 0; // forward CSR read values from Memory stage instead of stalling dependent instructions
+localparam LOADFWD_SUPPORTED = 0; // forward word-sized load data from Memory stage instead of stalling dependent instructions
 
 // Legal number of PMP entries are 0, 16, or 64
 localparam PMP_ENTRIES = 32'd0;
 
+// Cache page-granularity PMP permissions in TLB entries and in a one-entry bare-mode cache
+localparam PMPCACHE_SUPPORTED = 0;
+
 // Address space
 localparam logic [63:0] RESET_VECTOR = 64'h80000000;
 
 // WFI Timeout Wait
 localparam WFI_TIMEOUT_BIT = 32'd16;
+// Gate the pipeline clock while waiting for an interrupt: 0 = no, 1 = latch clock gate (ASIC; synthDC maps it
+// to the library's integrated clock gate), 2 = BUFGCE (FPGA)
+localparam WFI_CLOCKGATE = 32'd0;
 
 // Peripheral Addresses
 // Peripheral memory space extends from BASE to BASE+RANGE
@@ -125,6 +140,13 @@ localparam logic [63:0] SDC_RANGE = 64'h0000007F;
 localparam SPI_SUPPORTED = 1'b1;
 localparam logic [63:0] SPI_BASE = 64'h10040000;
 localparam logic [63:0] SPI_RANGE = 64'h00000FFF;
+localparam TRACE_SUPPORTED = 1'b0;
+localparam logic [63:0] TRACE_BASE = 64'h10070000;
+localparam logic [63:0] TRACE_RANGE = 64'h0000FFFF;
+localparam TRACE_ENTRIES = 32'd256;
+localparam ETH_SUPPORTED = 1'b0;
+localparam logic [63:0] ETH_BASE = 64'h10080000;
+localparam logic [63:0] ETH_RANGE = 64'h00000FFF;
 
 // Bus Interface width
 localparam AHBW = 32'd32;
@@ -134,6 +156,7 @@ localparam AHBW = 32'd32;
 // AHB 
 localparam RAM_LATENCY = 32'b0;
 localparam BURST_EN    = 1;
+localparam EBU_ARB     = 32'd0; // EBU arbitration: 0 = LSU first, 1 = round robin, 2 = oldest first, 3 = critical first
 
 // Tie GPIO outputs back to inputs
 localparam GPIO_LOOPBACK_TEST = 1;
@@ -150,6 +173,7 @@ localparam PLIC_GPIO_ID = 32'd3;
 localparam PLIC_UART_ID = 32'd10;
 localparam PLIC_SPI_ID = 32'd6;
 localparam PLIC_SDC_ID = 32'd9;
+localparam PLIC_ETH_ID = 32'd8;
 
 localparam BPRED_SUPPORTED = 0;
 localparam BPRED_TYPE = `BP_GSHARE; // BP_GSHARE_BASIC, BP_GLOBAL, BP_GLOBAL_BASIC, BP_TWOBIT
@@ -157,6 +181,7 @@ localparam BPRED_SIZE = 32'd10;
 localparam BPRED_NUM_LHR = 32'd6;
 localparam BTB_SIZE = 32'd10;
 localparam RAS_SIZE = 32'd16;
+localparam IBTB_SIZE = 32'd0; // log2 entries in path-history indexed indirect jump target predictor; 0 disables
 localparam INSTR_CLASS_PRED = 0;
 
 localparam SVADU_SUPPORTED = 0;
@@ -0,0 +1,5 @@
+`define REPL_PLRU       (32'd0)
+`define REPL_LRU        (32'd1)
+`define REPL_SRRIP      (32'd2)
+`define REPL_BRRIP      (32'd3)
+`define REPL_RANDOM     (32'd4)
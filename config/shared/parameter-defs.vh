@@ -2,6 +2,7 @@
 // Populate parameter structure with values specific to the current configuration
 
 `include "BranchPredictorType.vh"
+`include "CacheReplacementType.vh"
 
 localparam cvw_t P = '{ 
   XLEN :                 XLEN,  
@@ -10,6 +11,7 @@ localparam cvw_t P = '{
   AHBW :                 AHBW, 
   RAM_LATENCY :          RAM_LATENCY,
   BURST_EN :             BURST_EN,
+  EBU_ARB :              EBU_ARB,
   ZICSR_SUPPORTED :      ZICSR_SUPPORTED,
   ZIFENCEI_SUPPORTED :   ZIFENCEI_SUPPORTED,
   COUNTERS :             COUNTERS,
@@ -39,15 +41,25 @@ localparam cvw_t P = '{
   DCACHE_NUMWAYS :       DCACHE_NUMWAYS,
   DCACHE_WAYSIZEINBYTES :        DCACHE_WAYSIZEINBYTES,
   DCACHE_LINELENINBITS :        DCACHE_LINELENINBITS,
+  DCACHE_REPLACEMENT :        DCACHE_REPLACEMENT,
+  DCACHE_SECTORS :        DCACHE_SECTORS,
   ICACHE_NUMWAYS :        ICACHE_NUMWAYS,
   ICACHE_WAYSIZEINBYTES :        ICACHE_WAYSIZEINBYTES,
   ICACHE_LINELENINBITS :        ICACHE_LINELENINBITS,
+  ICACHE_REPLACEMENT :        ICACHE_REPLACEMENT,
+  LOOPBUF_SUPPORTED :        LOOPBUF_SUPPORTED,
+  LOOPBUF_ENTRIES :        LOOPBUF_ENTRIES,
   CACHE_SRAMLEN : CACHE_SRAMLEN,
+  CACHE_LATENCY : CACHE_LATENCY,
   IDIV_BITSPERCYCLE :        IDIV_BITSPERCYCLE,
   IDIV_ON_FPU :        IDIV_ON_FPU,
+  CSRFWD_SUPPORTED :        CSRFWD_SUPPORTED,
+  LOADFWD_SUPPORTED :        LOADFWD_SUPPORTED,
   PMP_ENTRIES :        PMP_ENTRIES,
+  PMPCACHE_SUPPORTED :        PMPCACHE_SUPPORTED,
   RESET_VECTOR :        RESET_VECTOR,
   WFI_TIMEOUT_BIT :        WFI_TIMEOUT_BIT,
+  WFI_CLOCKGATE :        WFI_CLOCKGATE,
   DTIM_SUPPORTED :        DTIM_SUPPORTED,
   DTIM_BASE :        DTIM_BASE,
   DTIM_RANGE :        DTIM_RANGE,
@@ -83,6 +95,13 @@ localparam cvw_t P = '{
   SPI_SUPPORTED :        SPI_SUPPORTED,
   SPI_BASE :        SPI_BASE,
   SPI_RANGE :        SPI_RANGE,
+  TRACE_SUPPORTED :        TRACE_SUPPORTED,
+  TRACE_BASE :        TRACE_BASE,
+  TRACE_RANGE :        TRACE_RANGE,
+  TRACE_ENTRIES :        TRACE_ENTRIES,
+  ETH_SUPPORTED :        ETH_SUPPORTED,
+  ETH_BASE :        ETH_BASE,
+  ETH_RANGE :        ETH_RANGE,
   GPIO_LOOPBACK_TEST :        GPIO_LOOPBACK_TEST,
   SPI_LOOPBACK_TEST :        SPI_LOOPBACK_TEST,
   UART_PRESCALE :        UART_PRESCALE ,
@@ -92,6 +111,7 @@ localparam cvw_t P = '{
   PLIC_UART_ID :        PLIC_UART_ID,
   PLIC_SPI_ID :        PLIC_SPI_ID,
   PLIC_SDC_ID :        PLIC_SDC_ID,
+  PLIC_ETH_ID :        PLIC_ETH_ID,
   BPRED_SUPPORTED :        BPRED_SUPPORTED,
                        /* verilator lint_off ENUMVALUE */
                        // *** definitely need to fix this.
@@ -102,6 +122,7 @@ localparam cvw_t P = '{
   BPRED_NUM_LHR : BPRED_NUM_LHR,                       
   BTB_SIZE :        BTB_SIZE,
   RAS_SIZE :        RAS_SIZE,
+  IBTB_SIZE :        IBTB_SIZE,
   INSTR_CLASS_PRED :  INSTR_CLASS_PRED,
   RADIX :        RADIX,
   DIVCOPIES :        DIVCOPIES,
@@ -54,6 +54,13 @@ if {$board=="ArtyA7"} {
     set_property PROCESSING_ORDER NORMAL [get_files  ../constraints/constraints-$boardSubName.xdc]
 }
 
+# WFI pipeline clock gate on a BUFGCE.  CLOCK_DELAY_GROUP is UltraScale only; on the Arty the clock through
+# the BUFGCE is derived and timed without further constraints.
+if {$board!="ArtyA7" && [catch {exec grep -E {WFI_CLOCKGATE *= *(32'd)?2;} ../src/CopiedFiles_do_not_add_to_repo/config/config.vh}] == 0} {
+    add_files -fileset constrs_1 -norecurse ../constraints/wficlockgate.xdc
+    set_property PROCESSING_ORDER LATE [get_files  ../constraints/wficlockgate.xdc]
+}
+
 # define top level
 set_property top fpgaTop [current_fileset]
 
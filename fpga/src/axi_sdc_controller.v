@@ -32,7 +32,8 @@
 
 module sdc_controller #(
     parameter dma_addr_bits = 32,
-    parameter fifo_addr_bits = 7,
+    parameter fifo_addr_bits = 9,           // FIFO holds 2**fifo_addr_bits words; 9 or more allows 256-beat bursts
+    parameter write_bursts_bits = 3,        // up to 2**write_bursts_bits-1 DMA write bursts awaiting a response
     parameter sdio_card_detect_level = 1,
     parameter voltage_controll_reg = 3300,
     parameter capabilies_reg = 16'b0000_0000_0000_0011
@@ -442,9 +443,6 @@ reg [31:0] fifo_dout;
 assign fifo_almost_full = fifo_data_len > (1 << fifo_addr_bits) * 3 / 4;
 assign fifo_almost_empty = fifo_free_len > (1 << fifo_addr_bits) * 3 / 4;
 
-wire tx_stb = en_tx_fifo && fifo_free_len >= (1 << fifo_addr_bits) / 3;
-wire rx_stb = en_rx_fifo && m_axi_bresp_cnt != 3'b111 && (fifo_data_len >= (1 << fifo_addr_bits) / 3 || (!fifo_empty && !data_busy));
-
 always @(posedge clock)
     if (reset || ctrl_rst || !(en_rx_fifo || en_tx_fifo)) begin
         fifo_inp_pos <= 0;
@@ -472,7 +470,7 @@ wire m_axi_write = en_rx_fifo;
 reg [7:0] m_axi_wcnt;
 reg [dma_addr_bits-1:2] m_bus_adr_o;
 wire [31:0] m_bus_dat_i;
-reg [2:0] m_axi_bresp_cnt;
+reg [write_bursts_bits-1:0] m_axi_bresp_cnt;
 reg m_bus_error;
 
 assign m_axi_bready = m_axi_bresp_cnt != 0;
@@ -480,11 +478,22 @@ assign m_axi_rready = m_axi_cyc & !m_axi_write;
 assign m_bus_dat_i = {m_axi_rdata[7:0],m_axi_rdata[15:8],m_axi_rdata[23:16],m_axi_rdata[31:24]};
 assign m_axi_wdata = {fifo_dout[7:0],fifo_dout[15:8],fifo_dout[23:16],fifo_dout[31:24]};
 
-// AXI burst cannot cross a 4KB boundary
-wire [fifo_addr_bits-1:0] tx_burst_len;
-wire [fifo_addr_bits-1:0] rx_burst_len;
-assign tx_burst_len = m_bus_adr_o[11:2] + fifo_free_len >= m_bus_adr_o[11:2] ? fifo_free_len - 1 : ~m_bus_adr_o[fifo_addr_bits+1:2];
-assign rx_burst_len = m_bus_adr_o[11:2] + fifo_data_len >= m_bus_adr_o[11:2] ? fifo_data_len - 1 : ~m_bus_adr_o[fifo_addr_bits+1:2];
+// DMA bursts are as long as AXI4 allows (256 beats), limited to half the FIFO so the SD side
+// can keep going while a burst drains, and end at 4KB boundaries.  A write burst starts once a
+// full burst of data is waiting, or to flush the rest at the end of the transfer.
+localparam max_burst = (1 << (fifo_addr_bits - 1)) < 256 ? (1 << (fifo_addr_bits - 1)) : 256;
+wire [15:0] boundary_len = 16'd1024 - m_bus_adr_o[11:2];
+wire [15:0] burst_len = boundary_len < max_burst ? boundary_len : max_burst;
+wire [15:0] data_len = fifo_data_len;
+wire [15:0] free_len = fifo_free_len;
+
+wire tx_stb = en_tx_fifo && free_len >= burst_len;
+wire rx_stb = en_rx_fifo && ~&m_axi_bresp_cnt && (data_len >= burst_len || (!fifo_empty && !data_busy));
+
+// Burst length - 1.  A read burst fills the FIFO space found by tx_stb; a write burst takes
+// what rx_stb found waiting, up to burst_len.
+wire [15:0] tx_burst_len = burst_len - 1;
+wire [15:0] rx_burst_len = (data_len < burst_len ? data_len : burst_len) - 1;
 
 assign data_int_status_reg = { data_int_status[`INT_DATA_SIZE-1:1],
     !en_rx_fifo && !en_tx_fifo && !m_axi_cyc && m_axi_bresp_cnt == 0 && data_int_status[0] };
@@ -498,6 +507,7 @@ always @(posedge clock) begin
     end else if (m_axi_cyc) begin
         if (m_axi_awvalid && m_axi_awready) begin
             m_axi_awvalid <= 0;
+            if (!m_axi_wvalid) m_axi_cyc <= 0; // write data went first
         end
         if (m_axi_arvalid && m_axi_arready) begin
             m_axi_arvalid <= 0;
@@ -505,7 +515,7 @@ always @(posedge clock) begin
         if (m_axi_wvalid && m_axi_wready) begin
             if (m_axi_wlast) begin
                 m_axi_wvalid <= 0;
-                m_axi_cyc <= 0;
+                m_axi_cyc <= m_axi_awvalid && !m_axi_awready; // address not yet accepted
             end else begin
                 m_axi_wlast <= m_axi_wcnt + 1 == m_axi_awlen;
                 m_axi_wcnt <= m_axi_wcnt + 1;
@@ -519,13 +529,13 @@ always @(posedge clock) begin
         m_axi_wcnt <= 0;
         if (m_axi_write) begin
             m_axi_awaddr <= { m_bus_adr_o, 2'b00 };
-            m_axi_awlen <= rx_burst_len < 8'hff ? rx_burst_len : 8'hff;
+            m_axi_awlen <= rx_burst_len[7:0];
             m_axi_wlast <= rx_burst_len == 0;
             m_axi_awvalid <= 1;
             m_axi_wvalid <= 1;
         end else begin
             m_axi_araddr <= { m_bus_adr_o, 2'b00 };
-            m_axi_arlen <= tx_burst_len < 8'hff ? tx_burst_len : 8'hff;
+            m_axi_arlen <= tx_burst_len[7:0];
             m_axi_arvalid <= 1;
         end
     end
@@ -0,0 +1,423 @@
+// SPDX-License-Identifier: GPL-2.0-only
+
+#include <linux/dma-mapping.h>
+#include <linux/etherdevice.h>
+#include <linux/interrupt.h>
+#include <linux/io.h>
+#include <linux/module.h>
+#include <linux/netdevice.h>
+#include <linux/of.h>
+#include <linux/of_net.h>
+#include <linux/platform_device.h>
+#include <linux/skbuff.h>
+#include <linux/version.h>
+
+/*
+ * Wally Ethernet MAC driver.
+ *
+ * The MAC (src/uncore/eth_apb.sv) moves frames between memory and an MII PHY
+ * with two descriptor rings.  Each descriptor is 16 bytes: the buffer address
+ * followed by the frame length.  Descriptors from head up to tail belong to
+ * the hardware; software advances tail and the hardware advances head.
+ *
+ * Wally's DMA is not cache coherent.  The rings come from
+ * dma_alloc_coherent() and the frame buffers are streaming mappings synced
+ * around every transfer, which relies on Zicbom for the cache maintenance.
+ * The hardware needs word-aligned buffers, so frames are copied through
+ * per-slot buffers rather than mapping socket buffers directly.
+ *
+ * The module is built by the fpga-axi-sdc buildroot package together with
+ * everything else in package-source.
+ *
+ * Device tree:
+ *   ethernet@10080000 {
+ *       compatible = "wally,eth";
+ *       reg = <0x00 0x10080000 0x00 0x1000>;
+ *       interrupt-parent = <&PLIC>;
+ *       interrupts = <8>;
+ *       local-mac-address = [02 00 00 00 00 01];
+ *   };
+ */
+
+#define ETH_CTRL         0x00
+#define ETH_INTSTAT      0x04
+#define ETH_INTEN        0x08
+#define ETH_MACLO        0x0C
+#define ETH_MACHI        0x10
+#define ETH_TXBASELO     0x14
+#define ETH_TXBASEHI     0x18
+#define ETH_TXSIZE       0x1C
+#define ETH_TXTAIL       0x20
+#define ETH_TXHEAD       0x24
+#define ETH_RXBASELO     0x28
+#define ETH_RXBASEHI     0x2C
+#define ETH_RXSIZE       0x30
+#define ETH_RXTAIL       0x34
+#define ETH_RXHEAD       0x38
+#define ETH_RXDROPS      0x44
+
+#define ETH_CTRL_TXEN    0x0001
+#define ETH_CTRL_RXEN    0x0002
+#define ETH_CTRL_PROMISC 0x0004
+
+#define ETH_INT_TX       0x0001
+#define ETH_INT_RX       0x0002
+#define ETH_INT_DROP     0x0004
+#define ETH_INT_DESCERR  0x0008
+#define ETH_INT_ALL      (ETH_INT_TX | ETH_INT_RX | ETH_INT_DROP | ETH_INT_DESCERR)
+
+#define WALLY_ETH_RING   64
+#define WALLY_ETH_BUFLEN 1536
+#define WALLY_ETH_NAPI_WEIGHT 16
+
+struct wally_eth_desc {
+    u64 addr;
+    u64 len;
+};
+
+struct wally_eth_ring {
+    struct wally_eth_desc *desc;
+    dma_addr_t desc_dma;
+    void *buf[WALLY_ETH_RING];
+    dma_addr_t buf_dma[WALLY_ETH_RING];
+    unsigned int head;   // next descriptor software will look at
+    unsigned int tail;   // next descriptor software will hand over
+};
+
+struct wally_eth {
+    void __iomem *regs;
+    struct device *dev;
+    struct net_device *ndev;
+    struct napi_struct napi;
+    int irq;
+    struct wally_eth_ring tx;
+    struct wally_eth_ring rx;
+};
+
+static inline u32 eth_read(struct wally_eth *priv, unsigned int reg) {
+    return ioread32(priv->regs + reg);
+}
+
+static inline void eth_write(struct wally_eth *priv, unsigned int reg, u32 val) {
+    iowrite32(val, priv->regs + reg);
+}
+
+static unsigned int ring_next(unsigned int i) {
+    return (i + 1) % WALLY_ETH_RING;
+}
+
+static void wally_eth_set_mac(struct wally_eth *priv) {
+    const u8 *a = priv->ndev->dev_addr;
+    eth_write(priv, ETH_MACLO, a[0] | a[1] << 8 | a[2] << 16 | (u32)a[3] << 24);
+    eth_write(priv, ETH_MACHI, a[4] | a[5] << 8);
+}
+
+static void wally_eth_free_ring(struct wally_eth *priv, struct wally_eth_ring *ring,
+                                enum dma_data_direction dir) {
+    int i;
+    for (i = 0; i < WALLY_ETH_RING; i++) {
+        if (ring->buf[i]) {
+            dma_unmap_single(priv->dev, ring->buf_dma[i], WALLY_ETH_BUFLEN, dir);
+            kfree(ring->buf[i]);
+            ring->buf[i] = NULL;
+        }
+    }
+    if (ring->desc)
+        dma_free_coherent(priv->dev, WALLY_ETH_RING * sizeof(struct wally_eth_desc),
+                          ring->desc, ring->desc_dma);
+    ring->desc = NULL;
+}
+
+static int wally_eth_alloc_ring(struct wally_eth *priv, struct wally_eth_ring *ring,
+                                enum dma_data_direction dir) {
+    int i;
+    ring->desc = dma_alloc_coherent(priv->dev, WALLY_ETH_RING * sizeof(struct wally_eth_desc),
+                                    &ring->desc_dma, GFP_KERNEL);
+    if (!ring->desc)
+        return -ENOMEM;
+    for (i = 0; i < WALLY_ETH_RING; i++) {
+        ring->buf[i] = kmalloc(WALLY_ETH_BUFLEN, GFP_KERNEL);
+        if (!ring->buf[i])
+            return -ENOMEM;
+        ring->buf_dma[i] = dma_map_single(priv->dev, ring->buf[i], WALLY_ETH_BUFLEN, dir);
+        if (dma_mapping_error(priv->dev, ring->buf_dma[i])) {
+            kfree(ring->buf[i]);
+            ring->buf[i] = NULL;
+            return -ENOMEM;
+        }
+        ring->desc[i].addr = ring->buf_dma[i];
+        ring->desc[i].len = 0;
+    }
+    ring->head = 0;
+    ring->tail = 0;
+    return 0;
+}
+
+static void wally_eth_tx_complete(struct wally_eth *priv) {
+    struct net_device *ndev = priv->ndev;
+    unsigned int hw_head = eth_read(priv, ETH_TXHEAD);
+
+    while (priv->tx.head != hw_head) {
+        ndev->stats.tx_packets++;
+        ndev->stats.tx_bytes += priv->tx.desc[priv->tx.head].len;
+        priv->tx.head = ring_next(priv->tx.head);
+    }
+    if (netif_queue_stopped(ndev) && ring_next(priv->tx.tail) != priv->tx.head)
+        netif_wake_queue(ndev);
+}
+
+static int wally_eth_rx(struct wally_eth *priv, int budget) {
+    struct net_device *ndev = priv->ndev;
+    unsigned int hw_head = eth_read(priv, ETH_RXHEAD);
+    int done = 0;
+
+    while (done < budget && priv->rx.head != hw_head) {
+        unsigned int i = priv->rx.head;
+        unsigned int len = priv->rx.desc[i].len;
+        struct sk_buff *skb;
+
+        if (len == 0) {
+            // the hardware rejected the buffer and dropped the frame
+            ndev->stats.rx_errors++;
+            goto recycle;
+        }
+        dma_sync_single_for_cpu(priv->dev, priv->rx.buf_dma[i], len, DMA_FROM_DEVICE);
+        skb = netdev_alloc_skb_ip_align(ndev, len);
+        if (skb) {
+            skb_put_data(skb, priv->rx.buf[i], len);
+            skb->protocol = eth_type_trans(skb, ndev);
+            napi_gro_receive(&priv->napi, skb);
+            ndev->stats.rx_packets++;
+            ndev->stats.rx_bytes += len;
+        } else {
+            ndev->stats.rx_dropped++;
+        }
+        dma_sync_single_for_device(priv->dev, priv->rx.buf_dma[i], len, DMA_FROM_DEVICE);
+
+recycle:
+        // hand the slot back; the tail trails the head by one so the ring never looks empty when full
+        priv->rx.tail = i;
+        priv->rx.head = ring_next(i);
+        done++;
+    }
+    if (done)
+        eth_write(priv, ETH_RXTAIL, priv->rx.tail);
+    return done;
+}
+
+static int wally_eth_poll(struct napi_struct *napi, int budget) {
+    struct wally_eth *priv = container_of(napi, struct wally_eth, napi);
+    int done;
+
+    eth_write(priv, ETH_INTSTAT, ETH_INT_ALL);
+    wally_eth_tx_complete(priv);
+    done = wally_eth_rx(priv, budget);
+    if (done < budget && napi_complete_done(napi, done))
+        eth_write(priv, ETH_INTEN, ETH_INT_ALL);
+    return done;
+}
+
+static irqreturn_t wally_eth_irq(int irq, void *dev_id) {
+    struct wally_eth *priv = dev_id;
+    u32 status = eth_read(priv, ETH_INTSTAT);
+
+    if (!(status & ETH_INT_ALL))
+        return IRQ_NONE;
+    if (status & ETH_INT_DROP) {
+        priv->ndev->stats.rx_missed_errors++;
+        eth_write(priv, ETH_INTSTAT, ETH_INT_DROP);
+    }
+    if (status & ETH_INT_DESCERR)
+        netdev_err_once(priv->ndev, "descriptor buffer not aligned to the bus width\n");
+    eth_write(priv, ETH_INTEN, 0);
+    napi_schedule(&priv->napi);
+    return IRQ_HANDLED;
+}
+
+static netdev_tx_t wally_eth_start_xmit(struct sk_buff *skb, struct net_device *ndev) {
+    struct wally_eth *priv = netdev_priv(ndev);
+    unsigned int i = priv->tx.tail;
+    unsigned int len = skb->len;
+
+    if (len > WALLY_ETH_BUFLEN) {
+        ndev->stats.tx_dropped++;
+        dev_kfree_skb_any(skb);
+        return NETDEV_TX_OK;
+    }
+    if (ring_next(i) == priv->tx.head) {
+        netif_stop_queue(ndev);
+        return NETDEV_TX_BUSY;
+    }
+
+    skb_copy_bits(skb, 0, priv->tx.buf[i], len);
+    dma_sync_single_for_device(priv->dev, priv->tx.buf_dma[i], len, DMA_TO_DEVICE);
+    priv->tx.desc[i].len = len;
+    priv->tx.tail = ring_next(i);
+    wmb(); // descriptor and buffer before the doorbell
+    eth_write(priv, ETH_TXTAIL, priv->tx.tail);
+    dev_kfree_skb_any(skb);
+
+    if (ring_next(priv->tx.tail) == priv->tx.head)
+        netif_stop_queue(ndev);
+    return NETDEV_TX_OK;
+}
+
+static void wally_eth_set_rx_mode(struct net_device *ndev) {
+    struct wally_eth *priv = netdev_priv(ndev);
+    u32 ctrl = eth_read(priv, ETH_CTRL) & ~ETH_CTRL_PROMISC;
+
+    // the MAC accepts every multicast frame, so only promiscuous mode needs a change
+    if (ndev->flags & IFF_PROMISC)
+        ctrl |= ETH_CTRL_PROMISC;
+    eth_write(priv, ETH_CTRL, ctrl);
+}
+
+static int wally_eth_set_mac_address(struct net_device *ndev, void *addr) {
+    struct wally_eth *priv = netdev_priv(ndev);
+    int ret = eth_mac_addr(ndev, addr);
+
+    if (ret)
+        return ret;
+    wally_eth_set_mac(priv);
+    return 0;
+}
+
+static int wally_eth_open(struct net_device *ndev) {
+    struct wally_eth *priv = netdev_priv(ndev);
+    int ret;
+
+    ret = wally_eth_alloc_ring(priv, &priv->tx, DMA_TO_DEVICE);
+    if (!ret)
+        ret = wally_eth_alloc_ring(priv, &priv->rx, DMA_FROM_DEVICE);
+    if (ret)
+        goto err_free;
+
+    ret = request_irq(priv->irq, wally_eth_irq, 0, ndev->name, priv);
+    if (ret)
+        goto err_free;
+
+    wally_eth_set_mac(priv);
+    eth_write(priv, ETH_TXBASELO, lower_32_bits(priv->tx.desc_dma));
+    eth_write(priv, ETH_TXBASEHI, upper_32_bits(priv->tx.desc_dma));
+    eth_write(priv, ETH_TXSIZE, WALLY_ETH_RING);
+    eth_write(priv, ETH_TXTAIL, 0);
+    eth_write(priv, ETH_RXBASELO, lower_32_bits(priv->rx.desc_dma));
+    eth_write(priv, ETH_RXBASEHI, upper_32_bits(priv->rx.desc_dma));
+    eth_write(priv, ETH_RXSIZE, WALLY_ETH_RING);
+    priv->rx.tail = WALLY_ETH_RING - 1;
+    eth_write(priv, ETH_RXTAIL, priv->rx.tail);
+    eth_write(priv, ETH_INTSTAT, ETH_INT_ALL);
+
+    napi_enable(&priv->napi);
+    eth_write(priv, ETH_INTEN, ETH_INT_ALL);
+    eth_write(priv, ETH_CTRL, ETH_CTRL_TXEN | ETH_CTRL_RXEN);
+    wally_eth_set_rx_mode(ndev);
+    netif_start_queue(ndev);
+    return 0;
+
+err_free:
+    wally_eth_free_ring(priv, &priv->rx, DMA_FROM_DEVICE);
+    wally_eth_free_ring(priv, &priv->tx, DMA_TO_DEVICE);
+    return ret;
+}
+
+static int wally_eth_stop(struct net_device *ndev) {
+    struct wally_eth *priv = netdev_priv(ndev);
+
+    netif_stop_queue(ndev);
+    eth_write(priv, ETH_INTEN, 0);
+    eth_write(priv, ETH_CTRL, 0); // also resets both ring heads
+    napi_disable(&priv->napi);
+    free_irq(priv->irq, priv);
+    wally_eth_free_ring(priv, &priv->rx, DMA_FROM_DEVICE);
+    wally_eth_free_ring(priv, &priv->tx, DMA_TO_DEVICE);
+    return 0;
+}
+
+static const struct net_device_ops wally_eth_netdev_ops = {
+    .ndo_open            = wally_eth_open,
+    .ndo_stop            = wally_eth_stop,
+    .ndo_start_xmit      = wally_eth_start_xmit,
+    .ndo_set_rx_mode     = wally_eth_set_rx_mode,
+    .ndo_set_mac_address = wally_eth_set_mac_address,
+    .ndo_validate_addr   = eth_validate_addr,
+};
+
+static int wally_eth_probe(struct platform_device *pdev) {
+    struct device *dev = &pdev->dev;
+    struct net_device *ndev;
+    struct wally_eth *priv;
+    int ret;
+
+    ndev = devm_alloc_etherdev(dev, sizeof(struct wally_eth));
+    if (!ndev)
+        return -ENOMEM;
+    SET_NETDEV_DEV(ndev, dev);
+    platform_set_drvdata(pdev, ndev);
+
+    priv = netdev_priv(ndev);
+    priv->ndev = ndev;
+    priv->dev = dev;
+    priv->regs = devm_platform_ioremap_resource(pdev, 0);
+    if (IS_ERR(priv->regs))
+        return PTR_ERR(priv->regs);
+    priv->irq = platform_get_irq(pdev, 0);
+    if (priv->irq < 0)
+        return priv->irq;
+
+    ret = dma_set_mask_and_coherent(dev, DMA_BIT_MASK(56));
+    if (ret)
+        return ret;
+
+    eth_write(priv, ETH_CTRL, 0);
+    eth_write(priv, ETH_INTEN, 0);
+
+    if (of_get_ethdev_address(dev->of_node, ndev))
+        eth_hw_addr_random(ndev);
+
+    ndev->netdev_ops = &wally_eth_netdev_ops;
+    ndev->min_mtu = ETH_MIN_MTU;
+    ndev->max_mtu = WALLY_ETH_BUFLEN - ETH_HLEN - ETH_FCS_LEN;
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 1, 0)
+    netif_napi_add_weight(ndev, &priv->napi, wally_eth_poll, WALLY_ETH_NAPI_WEIGHT);
+#else
+    netif_napi_add(ndev, &priv->napi, wally_eth_poll, WALLY_ETH_NAPI_WEIGHT);
+#endif
+
+    ret = register_netdev(ndev);
+    if (ret) {
+        netif_napi_del(&priv->napi);
+        return ret;
+    }
+    dev_info(dev, "Wally Ethernet MAC at %pM, irq %d\n", ndev->dev_addr, priv->irq);
+    return 0;
+}
+
+static int wally_eth_remove(struct platform_device *pdev) {
+    struct net_device *ndev = platform_get_drvdata(pdev);
+    struct wally_eth *priv = netdev_priv(ndev);
+
+    unregister_netdev(ndev);
+    netif_napi_del(&priv->napi);
+    return 0;
+}
+
+static const struct of_device_id wally_eth_of_match_table[] = {
+    { .compatible = "wally,eth" },
+    {},
+};
+MODULE_DEVICE_TABLE(of, wally_eth_of_match_table);
+
+static struct platform_driver wally_eth_driver = {
+    .driver = {
+        .name = "wally-eth",
+        .of_match_table = wally_eth_of_match_table,
+    },
+    .probe = wally_eth_probe,
+    .remove = wally_eth_remove,
+};
+
+module_platform_driver(wally_eth_driver);
+
+MODULE_DESCRIPTION("Wally Ethernet MAC driver");
+MODULE_LICENSE("GPL v2");
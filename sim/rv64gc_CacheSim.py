@@ -36,6 +36,8 @@ import argparse
 # Add -p or --perf to report the hit/miss ratio. 
 # Add -d or --dist to report the distribution of loads, stores, and atomic ops.
 # These distributions may not add up to 100; this is because of flushes or invalidations.
+# Add -r or --replacement if Wally was built with a replacement policy other than plru.
+# Add -s or --sweep to report the miss rate of every replacement policy on each log.
 
 class bcolors:
     HEADER = '\033[95m'
@@ -63,11 +65,15 @@ if __name__ == '__main__':
     parser = argparse.ArgumentParser(description="Runs the cache simulator on all rv64gc test suites")
     parser.add_argument('-p', "--perf", action='store_true', help="Report hit/miss ratio")
     parser.add_argument('-d', "--dist", action='store_true', help="Report distribution of operations")
+    parser.add_argument('-r', "--replacement", default="plru", help="Replacement policy Wally was built with")
+    parser.add_argument('-s', "--sweep", action='store_true', help="Report the miss rate of each replacement policy")
 
     args = parser.parse_args()
 
     testcmd = "vsim -do \"do wally-batch.do rv64gc {}\" -c > /dev/null"
-    cachecmd = "CacheSim.py 64 4 56 44 -f {}"
+    cachecmd = "CacheSim.py 64 4 56 44 -f {} -r " + args.replacement
+    sweepcmd = "CacheSim.py 64 4 56 44 -f {} -p -n -r {} | tail -1"
+    policies = ["plru", "lru", "srrip", "brrip", "random"]
     
     if args.perf:
         cachecmd += " -p"
@@ -80,4 +86,7 @@ if __name__ == '__main__':
         for cache in cachetypes:
             print(f"{bcolors.OKCYAN}Running the", cache, f"simulator.{bcolors.ENDC}")
             os.system(cachecmd.format(cache+".log"))
+            if args.sweep:
+                for policy in policies:
+                    os.system(sweepcmd.format(cache+".log", policy))
         print()
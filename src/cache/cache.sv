@@ -28,8 +28,12 @@
 // and limitations under the License.
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
+`include "CacheReplacementType.vh"
+
 module cache import cvw::*; #(parameter cvw_t P,
-                              parameter PA_BITS, XLEN, LINELEN,  NUMLINES,  NUMWAYS, LOGBWPL, WORDLEN, MUXINTERVAL, READ_ONLY_CACHE) (
+                              parameter PA_BITS, XLEN, LINELEN,  NUMLINES,  NUMWAYS, LOGBWPL, WORDLEN, MUXINTERVAL, READ_ONLY_CACHE,
+                              parameter REPLACEMENT = `REPL_PLRU, // replacement policy, from CacheReplacementType.vh
+                              parameter SECTORS = 1) (   // sectors per line, each with its own valid and dirty bit (D$ only)
   input  logic                   clk,
   input  logic                   reset,
   input  logic                   Stall,             // Stall the cache, preventing new accesses. In-flight access finished but does not return to READY
@@ -41,6 +45,7 @@ module cache import cvw::*; #(parameter cvw_t P,
   input  logic [3:0]             CMOpM,              // 1: cbo.inval; 2: cbo.flush; 4: cbo.clean; 8: cbo.zero
   input  logic [11:0]            NextSet,           // Virtual address, but we only use the lower 12 bits.
   input  logic [PA_BITS-1:0]     PAdr,              // Physical address
+  input  logic                   SkipRead,          // Next access is likely served by the loop buffer; don't read the arrays (I$ only)
   input  logic [(WORDLEN-1)/8:0] ByteMask,          // Which bytes to write (D$ only)
   input  logic [WORDLEN-1:0]     CacheWriteData,    // Data to write to cache (D$ only)
   output logic                   CacheCommitted,    // Cache has started bus operation that shouldn't be interrupted
@@ -57,7 +62,7 @@ module cache import cvw::*; #(parameter cvw_t P,
   input  logic [LOGBWPL-1:0]     BeatCount,         // Beat in burst
   input  logic [LINELEN-1:0]     FetchBuffer,       // Buffer long enough to hold entire cache line arriving from bus
   output logic [1:0]             CacheBusRW,        // [1] Read (cache line fetch) or [0] write bus (cache line writeback)
-  output logic [PA_BITS-1:0]     CacheBusAdr        // Address for bus access
+  output logic [PA_BITS-1:0]     CacheBusAdr        // Address for bus access; a sector rather than a line when sectored
 );
 
   // Cache parameters
@@ -70,6 +75,9 @@ module cache import cvw::*; #(parameter cvw_t P,
   localparam                     LOGCWPL = $clog2(CACHEWORDSPERLINE);// Log2 of ^
   localparam                     FLUSHADRTHRESHOLD = NUMLINES - 1;   // Used to determine when flush is complete
   localparam                     LOGLLENBYTES = $clog2(WORDLEN/8);   // Number of bits to address a word
+  localparam                     SECTORLEN = LINELEN/SECTORS;        // Bits per sector
+  localparam                     SECTOROFFSETLEN = $clog2(SECTORLEN/8); // Number of bits in offset within a sector
+  localparam                     LOGSECTORS = $clog2(SECTORS);       // Number of bits to select a sector
 
 
   logic                          SelAdrData;
@@ -83,7 +91,14 @@ module cache import cvw::*; #(parameter cvw_t P,
   logic [LINELEN-1:0]            ReadDataLineWay [NUMWAYS-1:0];
   logic [NUMWAYS-1:0]            HitWay, ValidWay;
   logic                          CacheHit;
-  logic [NUMWAYS-1:0]            VictimWay, DirtyWay, HitDirtyWay;
+  logic [NUMWAYS-1:0]            VictimWay, ReplaceWay, DirtyWay, HitDirtyWay;
+  logic [NUMWAYS-1:0]            SectorMissWay;
+  logic                          SectorMiss;
+  logic [SECTORS-1:0]            SectorMask, WriteSectors;
+  logic [SECTORS-1:0]            DirtySectorsWay [NUMWAYS-1:0];
+  logic                          KeepSectors, LineOp;
+  logic                          MoreSectors, SectorWriteback;
+  logic [OFFSETLEN-1:0]          WritebackOffset;
   logic                          LineDirty, HitLineDirty;
   logic [TAGLEN-1:0]             TagWay [NUMWAYS-1:0];
   logic [TAGLEN-1:0]             Tag;
@@ -98,6 +113,7 @@ module cache import cvw::*; #(parameter cvw_t P,
   logic [LINELEN-1:0]            ReadDataLine, ReadDataLineCache;
   logic                          SelFetchBuffer;
   logic                          CacheEn;
+  logic                          ArrayReady;
   logic                          SelWay;
   logic [LINELEN/8-1:0]          LineByteMask;
   logic [$clog2(LINELEN/8) - $clog2(MUXINTERVAL/8) - 1:0] WordOffsetAddr;
@@ -119,21 +135,43 @@ module cache import cvw::*; #(parameter cvw_t P,
     AdrSelMuxSelTag, CacheSetTag);
 
   // Array of cache ways, along with victim, hit, dirty, and read merging logic
-  cacheway #(P, PA_BITS, XLEN, NUMLINES, LINELEN, TAGLEN, OFFSETLEN, SETLEN, READ_ONLY_CACHE) CacheWays[NUMWAYS-1:0](
+  cacheway #(P, PA_BITS, XLEN, NUMLINES, LINELEN, TAGLEN, OFFSETLEN, SETLEN, READ_ONLY_CACHE, SECTORS) CacheWays[NUMWAYS-1:0](
     .clk, .reset, .CacheEn, .CacheSetData, .CacheSetTag, .PAdr, .LineWriteData, .LineByteMask, .SelWay,
     .SetValid, .ClearValid, .SetDirty, .ClearDirty, .VictimWay,
+    .SectorMask, .WriteSectors, .KeepSectors, .LineOp, .SectorMissWay, .DirtySectorsWay,
     .FlushWay, .FlushCache, .ReadDataLineWay, .HitWay, .ValidWay, .DirtyWay, .HitDirtyWay, .TagWay, .FlushStage, .InvalidateCache);
 
-  // Select victim way for associative caches
+  // Select victim way for associative caches.  A sector miss is treated as a hit by the
+  // replacement policy, so it fills the way already holding the line.
   if(NUMWAYS > 1) begin:vict
-    cacheLRU #(NUMWAYS, SETLEN, OFFSETLEN, NUMLINES) cacheLRU(
-      .clk, .reset, .FlushStage, .CacheEn, .HitWay, .ValidWay, .VictimWay, .CacheSetData, .CacheSetTag, .LRUWriteEn,
-      .SetValid, .ClearValid, .PAdr(PAdr[SETTOP-1:OFFSETLEN]), .InvalidateCache);
+    logic [NUMWAYS-1:0] ReplHitWay;
+    logic               ReplSetValid;
+    assign ReplHitWay = HitWay | SectorMissWay;
+    assign ReplSetValid = SetValid & ~SectorMiss;
+    if (REPLACEMENT == `REPL_LRU) begin:lru
+      cacheTrueLRU #(NUMWAYS, SETLEN, NUMLINES) cacheTrueLRU(
+        .clk, .reset, .CacheEn, .HitWay(ReplHitWay), .ValidWay, .VictimWay(ReplaceWay), .CacheSetTag, .LRUWriteEn,
+        .SetValid(ReplSetValid), .PAdr(PAdr[SETTOP-1:OFFSETLEN]));
+    end else if (REPLACEMENT == `REPL_SRRIP | REPLACEMENT == `REPL_BRRIP) begin:rrip
+      cacheRRIP #(NUMWAYS, SETLEN, NUMLINES, REPLACEMENT == `REPL_BRRIP) cacheRRIP(
+        .clk, .reset, .CacheEn, .HitWay(ReplHitWay), .ValidWay, .VictimWay(ReplaceWay), .CacheSetTag, .LRUWriteEn,
+        .SetValid(ReplSetValid), .PAdr(PAdr[SETTOP-1:OFFSETLEN]));
+    end else if (REPLACEMENT == `REPL_RANDOM) begin:random
+      cacheRandom #(NUMWAYS) cacheRandom(
+        .clk, .reset, .CacheEn, .ValidWay, .VictimWay(ReplaceWay), .LRUWriteEn, .SetValid(ReplSetValid));
+    end else begin:plru
+      cacheLRU #(NUMWAYS, SETLEN, OFFSETLEN, NUMLINES) cacheLRU(
+        .clk, .reset, .FlushStage, .CacheEn, .HitWay(ReplHitWay), .ValidWay, .VictimWay(ReplaceWay), .CacheSetData, .CacheSetTag, .LRUWriteEn,
+        .SetValid(ReplSetValid), .ClearValid, .PAdr(PAdr[SETTOP-1:OFFSETLEN]), .InvalidateCache);
+    end
   end else 
-    assign VictimWay = 1'b1; // one hot.
+    assign ReplaceWay = 1'b1; // one hot.
+
+  assign SectorMiss = |SectorMissWay & ~FlushCache;
+  mux2 #(NUMWAYS) VictimWayMux(ReplaceWay, SectorMissWay, SectorMiss, VictimWay);
 
   assign CacheHit = |HitWay;
-  assign LineDirty = |DirtyWay;
+  assign LineDirty = |DirtyWay & ~SectorMiss; // a sector miss keeps the line, so nothing is evicted
   assign HitLineDirty = |HitDirtyWay;
 
   // ReadDataLineWay is a 2d array of cache line len by number of ways.
@@ -157,17 +195,58 @@ module cache import cvw::*; #(parameter cvw_t P,
   subcachelineread #(LINELEN, WORDLEN, MUXINTERVAL) subcachelineread(
     .PAdr(WordOffsetAddr), .ReadDataLine, .ReadDataWord);
   
+  /////////////////////////////////////////////////////////////////////////////////////////////
+  // Sectors
+  /////////////////////////////////////////////////////////////////////////////////////////////
+
+  // A sectored line has a valid and dirty bit per sector.  A miss to a line that is present but
+  // lacks PAdr's sector fetches only that sector, into the way already holding the line.  A miss
+  // to a new line fetches PAdr's sector and invalidates the rest.  Writebacks send only the
+  // dirty sectors, one burst each.  Cache maintenance operations act on the whole line.
+  assign LineOp = |CMOpM;
+  assign WriteSectors = CMOpM[3] ? '1 : SectorMask;
+  assign KeepSectors = SectorMiss | (SetDirty & ~SetValid);
+
+  if (SECTORS > 1) begin:sector
+    logic [SECTORS-1:0]          SelDirtySectors, WBSectors, CurrWBSectors, NextWBSectors;
+    logic [SECTORS-1:0]          WBSector, NextWBSector, BusSector;
+    logic [LOGSECTORS-1:0]       BusSectorEnc;
+    logic                        WBActive;
+
+    decoder #(LOGSECTORS) sectordec(PAdr[OFFSETLEN-1:SECTOROFFSETLEN], SectorMask);
+    or_rows #(NUMWAYS, SECTORS) DirtySectorsAOMux(.a(DirtySectorsWay), .y(SelDirtySectors));
+
+    // The dirty sectors come from the arrays in the first cycle of a writeback and are held after
+    // that, because a flush clears the dirty bits as the writeback starts.
+    mux2 #(SECTORS) WBSectorsMux(SelDirtySectors, WBSectors, WBActive, CurrWBSectors);
+    priorityonehot #(SECTORS) wbsectorpri(CurrWBSectors, WBSector);
+    assign NextWBSectors = CurrWBSectors & ~WBSector;
+    assign MoreSectors = |NextWBSectors;
+    flopr #(SECTORS+1) WBSectorsReg(clk, reset, {CacheBusAck ? NextWBSectors : CurrWBSectors, SectorWriteback},
+      {WBSectors, WBActive});
+
+    // The bus starts the next burst's address phase in the cycle the previous one is acknowledged
+    priorityonehot #(SECTORS) nextwbsectorpri(NextWBSectors, NextWBSector);
+    mux2 #(SECTORS) BusSectorMux(WBSector, NextWBSector, CacheBusAck, BusSector);
+    binencoder #(SECTORS) bussectorenc(BusSector, BusSectorEnc);
+    assign WritebackOffset = {BusSectorEnc, {SECTOROFFSETLEN{1'b0}}};
+  end else begin:sector
+    assign SectorMask = 1'b1;
+    assign MoreSectors = 1'b0;
+    assign WritebackOffset = '0;
+  end
+
   // Bus address for fetch, writeback, or flush writeback
-  mux3 #(PA_BITS) CacheBusAdrMux(.d0({PAdr[PA_BITS-1:OFFSETLEN], {OFFSETLEN{1'b0}}}),
-    .d1({Tag, PAdr[SETTOP-1:OFFSETLEN], {OFFSETLEN{1'b0}}}),
-    .d2({Tag, FlushAdr, {OFFSETLEN{1'b0}}}),
+  mux3 #(PA_BITS) CacheBusAdrMux(.d0({PAdr[PA_BITS-1:SECTOROFFSETLEN], {SECTOROFFSETLEN{1'b0}}}),
+    .d1({Tag, PAdr[SETTOP-1:OFFSETLEN], WritebackOffset}),
+    .d2({Tag, FlushAdr, WritebackOffset}),
     .s({FlushCache, SelWriteback}), .y(CacheBusAdr));
   
   /////////////////////////////////////////////////////////////////////////////////////////////
   // Write Path
   /////////////////////////////////////////////////////////////////////////////////////////////
   if(!READ_ONLY_CACHE) begin:WriteSelLogic
-    logic [LINELEN/8-1:0]          DemuxedByteMask, FetchBufferByteSel;
+    logic [LINELEN/8-1:0]          DemuxedByteMask, FetchBufferByteSel, FillByteMask;
 
     // Adjust byte mask from word to cache line
 
@@ -187,7 +266,10 @@ module cache import cvw::*; #(parameter cvw_t P,
       mux2 #(8) WriteDataMux(.d0(CacheWriteData[(8*index)%WORDLEN+7:(8*index)%WORDLEN]),
         .d1(FetchBuffer[8*index+7:8*index]), .s(FetchBufferByteSel[index] & ~CMOpM[3]), .y(LineWriteData[8*index+7:8*index]));
     end
-    assign LineByteMask = SetValid ? '1 : SetDirty ? DemuxedByteMask : '0;
+    // Filling a line writes only the sectors being filled
+    for(index = 0; index < LINELEN/8; index++)
+      assign FillByteMask[index] = WriteSectors[index/(SECTORLEN/8)];
+    assign LineByteMask = SetValid ? FillByteMask : SetDirty ? DemuxedByteMask : '0;
   end
   else
     begin:WriteSelLogic
@@ -220,16 +302,38 @@ module cache import cvw::*; #(parameter cvw_t P,
     assign FlushAdrFlag = 0;
   end
    
+  /////////////////////////////////////////////////////////////////////////////////////////////
+  // Two-cycle array access
+  /////////////////////////////////////////////////////////////////////////////////////////////
+
+  // With CACHE_LATENCY = 2 each way registers its array outputs.  Track the set read into the
+  // arrays' outputs; any write to the arrays makes them stale.  The FSM waits until the registers
+  // hold the set being accessed, so only the first access to a set costs an extra cycle;
+  // sequential fetch and loads to the same line run at full rate.
+  // The set accessed next cycle is the one the arrays read this cycle (CacheSet), or the one they
+  // hold if not enabled, so the compare is made a cycle early and registered.  This keeps it off
+  // the CacheStall path to StallF/StallM.
+  if (P.CACHE_LATENCY > 1) begin:arraylatency
+    logic [SETLEN-1:0]           ArraySetData, ArraySetTag;
+    logic                        ArrayWrite, ArrayValid, ArrayReadyNext;
+
+    assign ArrayWrite = CacheEn & (SetValid | ClearValid | SetDirty | ClearDirty | InvalidateCache);
+    flopenr #(2*SETLEN+1) ArraySetReg(clk, reset, CacheEn, {CacheSetData, CacheSetTag, ~ArrayWrite},
+      {ArraySetData, ArraySetTag, ArrayValid});
+    assign ArrayReadyNext = ArrayValid & ~ArrayWrite & (~CacheEn | ((ArraySetData == CacheSetData) & (ArraySetTag == CacheSetTag)));
+    flopr #(1) ArrayReadyReg(clk, reset, ArrayReadyNext, ArrayReady);
+  end else assign ArrayReady = 1'b1;
+
   /////////////////////////////////////////////////////////////////////////////////////////////
   // Cache FSM
   /////////////////////////////////////////////////////////////////////////////////////////////
   
-  cachefsm #(P, READ_ONLY_CACHE) cachefsm(.clk, .reset, .CacheBusRW, .CacheBusAck, 
-    .FlushStage, .CacheRW, .Stall,
+  cachefsm #(P, READ_ONLY_CACHE) cachefsm(.clk, .reset, .CacheBusRW, .CacheBusAck, .MoreSectors, .SectorWriteback,
+    .FlushStage, .CacheRW, .Stall, .SkipRead,
     .CacheHit, .LineDirty, .HitLineDirty, .CacheStall, .CacheCommitted, 
     .CacheMiss, .CacheAccess, .SelAdrData, .SelAdrTag, .SelWay,
     .ClearDirty, .SetDirty, .SetValid, .ClearValid, .SelWriteback,
     .FlushAdrCntEn, .FlushWayCntEn, .FlushCntRst,
-    .FlushAdrFlag, .FlushWayFlag, .FlushCache, .SelFetchBuffer,
+    .FlushAdrFlag, .FlushWayFlag, .ArrayReady, .FlushCache, .SelFetchBuffer,
     .InvalidateCache, .CMOpM, .CacheEn, .LRUWriteEn);
 endmodule 
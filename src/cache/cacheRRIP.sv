@@ -0,0 +1,105 @@
+///////////////////////////////////////////
+// cacheRRIP.sv
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified:
+//
+// Purpose: Re-reference interval prediction (RRIP) replacement.  Each way holds a 2-bit re-reference
+//          prediction value (RRPV); 3 predicts the line will not be reused soon.  A hit predicts
+//          near reuse (0).  The victim is the first invalid way, or else the first way with the
+//          largest RRPV; when a valid line is evicted, every way is aged so the victim's RRPV
+//          reaches 3.  SRRIP inserts new lines at 2 so a scan cannot displace lines that hit.
+//          BRRIP (BIMODAL = 1) inserts at 3 except for every 32nd fill, which helps when the
+//          working set is larger than the cache.  The fill counter advances only on fills so
+//          that bin/CacheSim.py can reproduce the policy from a cache trace.
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+//
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied. See the License for the specific language governing permissions
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+module cacheRRIP
+  #(parameter NUMWAYS = 4, SETLEN = 9, NUMLINES = 128, BIMODAL = 0) (
+  input  logic                clk, 
+  input  logic                reset,
+  input  logic                CacheEn,         // Enable the cache memory arrays.  Disable hold read data constant
+  input  logic [NUMWAYS-1:0]  HitWay,          // Which way is valid and matches PAdr's tag
+  input  logic [NUMWAYS-1:0]  ValidWay,        // Which ways for a particular set are valid, ignores tag
+  input  logic [SETLEN-1:0]   CacheSetTag,     // Cache address, the output of the address select mux, NextAdr, PAdr, or FlushAdr
+  input  logic [SETLEN-1:0]   PAdr,            // Physical address 
+  input  logic                LRUWriteEn,      // Update the replacement state
+  input  logic                SetValid,        // A line is being written into VictimWay
+  output logic [NUMWAYS-1:0]  VictimWay        // Selects a victim to evict
+);
+
+  logic [2*NUMWAYS-1:0]                LRUMemory [NUMLINES-1:0];
+  logic [2*NUMWAYS-1:0]                CurrLRU, NextLRU;
+  logic [NUMWAYS-1:0]                  Way, Distant, FirstDistant, FirstZero;
+  logic [1:0]                          MaxRRPV, Aging, InsertRRPV;
+  logic                                AllValid, Fill;
+  
+  genvar                               index;
+
+  assign AllValid = &ValidWay;
+  assign Fill = SetValid & LRUWriteEn;
+
+  // On a miss, the line is written into VictimWay
+  mux2 #(NUMWAYS) WayMux(HitWay, VictimWay, SetValid, Way);
+
+  always_comb begin
+    MaxRRPV = '0;
+    for (int way = 0; way < NUMWAYS; way++)
+      if (CurrLRU[2*way +: 2] > MaxRRPV) MaxRRPV = CurrLRU[2*way +: 2];
+  end
+  assign Aging = 2'b11 - MaxRRPV;
+
+  if (BIMODAL) begin:bimodal
+    logic [4:0] FillCount;
+    counter #(5) FillCounter(clk, reset, Fill & CacheEn, FillCount);
+    assign InsertRRPV = FillCount == '0 ? 2'b10 : 2'b11;
+  end else assign InsertRRPV = 2'b10;
+
+  for (index = 0; index < NUMWAYS; index++) begin:rrpv
+    logic [1:0] RRPV;
+    assign RRPV = CurrLRU[2*index +: 2];
+    assign Distant[index] = RRPV == MaxRRPV;
+    assign NextLRU[2*index +: 2] = Way[index] ? (SetValid ? InsertRRPV : 2'b00) :
+                                   (SetValid & AllValid) ? RRPV + Aging : RRPV;
+  end
+
+  // Fill invalid ways first, then evict the first way predicted to be reused furthest in the future
+  priorityonehot #(NUMWAYS) FirstZeroEncoder(~ValidWay, FirstZero);
+  priorityonehot #(NUMWAYS) DistantEncoder(Distant, FirstDistant);
+  mux2 #(NUMWAYS) VictimMux(FirstZero, FirstDistant, AllValid, VictimWay);
+
+  // RRIP storage must be reset for modelsim to run. However the reset value does not actually matter in practice.
+  // This is a two port memory.
+  // Every cycle must read from CacheSetTag and each load/store must write the new RRPVs.
+  always_ff @(posedge clk) begin
+    if (reset) for (int set = 0; set < NUMLINES; set++) LRUMemory[set] = '0; // exclusion-tag: initialize
+    if(CacheEn) begin
+      if(LRUWriteEn)
+        LRUMemory[PAdr] <= NextLRU;
+      if(LRUWriteEn & (PAdr == CacheSetTag))
+        CurrLRU <= #1 NextLRU;
+      else 
+        CurrLRU <= #1 LRUMemory[CacheSetTag];
+    end
+  end
+
+endmodule
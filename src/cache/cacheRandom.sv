@@ -0,0 +1,56 @@
+///////////////////////////////////////////
+// cacheRandom.sv
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified:
+//
+// Purpose: Pseudo-random replacement.  The victim is the first invalid way, or else a way chosen by
+//          the low bits of a 16-bit maximal-length LFSR (x^16 + x^14 + x^13 + x^11 + 1).  The LFSR
+//          advances on each fill rather than each cycle so that bin/CacheSim.py can reproduce the
+//          victims from a cache trace.  No per-set state is needed.
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+//
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied. See the License for the specific language governing permissions
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+module cacheRandom
+  #(parameter NUMWAYS = 4) (
+  input  logic                clk, 
+  input  logic                reset,
+  input  logic                CacheEn,         // Enable the cache memory arrays
+  input  logic [NUMWAYS-1:0]  ValidWay,        // Which ways for a particular set are valid, ignores tag
+  input  logic                LRUWriteEn,      // Update the replacement state
+  input  logic                SetValid,        // A line is being written into VictimWay
+  output logic [NUMWAYS-1:0]  VictimWay        // Selects a victim to evict
+);
+
+  localparam                           LOGNUMWAYS = $clog2(NUMWAYS);
+
+  logic [15:0]                         LFSR, NextLFSR;
+  logic [NUMWAYS-1:0]                  FirstZero, RandomWay;
+
+  assign NextLFSR = {LFSR[14:0], LFSR[15] ^ LFSR[13] ^ LFSR[12] ^ LFSR[10]};
+  flopenl #(16) LFSRReg(clk, reset, SetValid & LRUWriteEn & CacheEn, NextLFSR, 16'h0001, LFSR);
+  decoder #(LOGNUMWAYS) RandomWayDecoder(LFSR[LOGNUMWAYS-1:0], RandomWay);
+
+  // Fill invalid ways first
+  priorityonehot #(NUMWAYS) FirstZeroEncoder(~ValidWay, FirstZero);
+  mux2 #(NUMWAYS) VictimMux(FirstZero, RandomWay, &ValidWay, VictimWay);
+
+endmodule
@@ -0,0 +1,94 @@
+///////////////////////////////////////////
+// cacheTrueLRU.sv
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified:
+//
+// Purpose: True LRU replacement.  Each way of a set holds its age, its position in the recency
+//          order: 0 for the most recently used way and NUMWAYS-1 for the least.  An access makes
+//          the way the youngest and ages every way that was younger than it, so the ages remain
+//          a permutation.  The victim is the first invalid way, or else the oldest way.
+//          The comparators grow as NUMWAYS^2, so this is intended for 4 or fewer ways.
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+//
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied. See the License for the specific language governing permissions
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+module cacheTrueLRU
+  #(parameter NUMWAYS = 4, SETLEN = 9, NUMLINES = 128) (
+  input  logic                clk, 
+  input  logic                reset,
+  input  logic                CacheEn,         // Enable the cache memory arrays.  Disable hold read data constant
+  input  logic [NUMWAYS-1:0]  HitWay,          // Which way is valid and matches PAdr's tag
+  input  logic [NUMWAYS-1:0]  ValidWay,        // Which ways for a particular set are valid, ignores tag
+  input  logic [SETLEN-1:0]   CacheSetTag,     // Cache address, the output of the address select mux, NextAdr, PAdr, or FlushAdr
+  input  logic [SETLEN-1:0]   PAdr,            // Physical address 
+  input  logic                LRUWriteEn,      // Update the LRU state
+  input  logic                SetValid,        // A line is being written into VictimWay
+  output logic [NUMWAYS-1:0]  VictimWay        // LRU selects a victim to evict
+);
+
+  localparam                           LOGNUMWAYS = $clog2(NUMWAYS);
+  localparam                           AGESLEN = NUMWAYS*LOGNUMWAYS;
+
+  logic [AGESLEN-1:0]                  LRUMemory [NUMLINES-1:0];
+  logic [AGESLEN-1:0]                  CurrLRU, NextLRU, ResetLRU;
+  logic [NUMWAYS-1:0]                  Way, Oldest, FirstZero;
+  logic [LOGNUMWAYS-1:0]               WayAge;
+  
+  genvar                               index;
+
+  // On a miss, the line is written into VictimWay
+  mux2 #(NUMWAYS) WayMux(HitWay, VictimWay, SetValid, Way);
+
+  always_comb begin
+    WayAge = '0;
+    for (int way = 0; way < NUMWAYS; way++)
+      if (Way[way]) WayAge = CurrLRU[way*LOGNUMWAYS +: LOGNUMWAYS];
+  end
+
+  for (index = 0; index < NUMWAYS; index++) begin:age
+    localparam [LOGNUMWAYS-1:0] RESETAGE = index;
+    logic [LOGNUMWAYS-1:0] Age;
+    assign Age = CurrLRU[index*LOGNUMWAYS +: LOGNUMWAYS];
+    assign Oldest[index] = &Age;
+    assign NextLRU[index*LOGNUMWAYS +: LOGNUMWAYS] = Way[index] ? '0 : Age < WayAge ? Age + 1'b1 : Age;
+    assign ResetLRU[index*LOGNUMWAYS +: LOGNUMWAYS] = RESETAGE;
+  end
+
+  // Fill invalid ways first, then evict the oldest way
+  priorityonehot #(NUMWAYS) FirstZeroEncoder(~ValidWay, FirstZero);
+  mux2 #(NUMWAYS) VictimMux(FirstZero, Oldest, &ValidWay, VictimWay);
+
+  // The ages must start as a permutation, so reset each set to way 0 youngest through way NUMWAYS-1 oldest.
+  // This is a two port memory.
+  // Every cycle must read from CacheSetTag and each load/store must write the new LRU.
+  always_ff @(posedge clk) begin
+    if (reset) for (int set = 0; set < NUMLINES; set++) LRUMemory[set] = ResetLRU; // exclusion-tag: initialize
+    if(CacheEn) begin
+      if(LRUWriteEn)
+        LRUMemory[PAdr] <= NextLRU;
+      if(LRUWriteEn & (PAdr == CacheSetTag))
+        CurrLRU <= #1 NextLRU;
+      else 
+        CurrLRU <= #1 LRUMemory[CacheSetTag];
+    end
+  end
+
+endmodule
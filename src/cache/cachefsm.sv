@@ -34,6 +34,7 @@ module cachefsm import cvw::*; #(parameter cvw_t P,
   input  logic       reset,
   // hazard and privilege unit
   input  logic       Stall,             // Stall the cache, preventing new accesses. In-flight access finished but does not return to READY
+  input  logic       SkipRead,          // Next access is likely served by the loop buffer; don't read the arrays
   input  logic       FlushStage,        // Pipeline flush of second stage (prevent writes and bus operations)
   output logic       CacheCommitted,    // Cache has started bus operation that shouldn't be interrupted
   output logic       CacheStall,        // Cache stalls pipeline during multicycle operation
@@ -44,6 +45,8 @@ module cachefsm import cvw::*; #(parameter cvw_t P,
   input  logic [3:0] CMOpM,             // 0001: cbo.inval; 0010: cbo.flush; 0100: cbo.clean; 1000: cbo.zero
   // Bus controls
   input  logic       CacheBusAck,       // Bus operation completed
+  input  logic       MoreSectors,       // More dirty sectors of the line remain to be written back after this burst
+  output logic       SectorWriteback,   // Writing back a line, one dirty sector per burst
   output logic [1:0] CacheBusRW,        // [1] Read (cache line fetch) or [0] write bus (cache line writeback)
   // performance counter outputs
   output logic       CacheMiss,         // Cache miss  
@@ -55,6 +58,7 @@ module cachefsm import cvw::*; #(parameter cvw_t P,
   input  logic       HitLineDirty,   // The cache hit way is dirty
   input  logic       FlushAdrFlag,      // On last set of a cache flush
   input  logic       FlushWayFlag,      // On the last way for any set of a cache flush
+  input  logic       ArrayReady,        // Registered array outputs hold the set being accessed (always 1 unless CACHE_LATENCY = 2)
   output logic       SelAdrData,            // [0] SRAM reads from NextAdr, [1] SRAM reads from PAdr
   output logic       SelAdrTag,            // [0] SRAM reads from NextAdr, [1] SRAM reads from PAdr
   output logic       SetValid,          // Set the valid bit in the selected way and set
@@ -72,12 +76,19 @@ module cachefsm import cvw::*; #(parameter cvw_t P,
 );
   
   logic              resetDelay;
+  logic              ArrayWait;
+  logic              SkipArrayRead, ReadSkipped;
+  logic              FlushStep;
+  logic [1:0]        CacheRWReq;
+  logic [3:0]        CMOpReq;
   logic              AnyUpdateHit, AnyHit;
   logic              AnyMiss;
   logic              FlushFlag;
   logic              CMOWriteback;
   logic              CMOZeroNoEviction;
   logic              StallConditions;
+  logic              HoldArrays;
+  logic              WritebackDone;
 
   typedef enum logic [3:0]{STATE_READY, // hit states
                            // miss states
@@ -92,16 +103,29 @@ module cachefsm import cvw::*; #(parameter cvw_t P,
 
   statetype CurrState, NextState;
 
-  assign AnyMiss = (CacheRW[0] | CacheRW[1]) & ~CacheHit & ~InvalidateCache; // exclusion-tag: cache AnyMiss
-  assign AnyUpdateHit = (CacheRW[0]) & CacheHit;                            // exclusion-tag: icache storeAMO1
-  assign AnyHit = AnyUpdateHit | (CacheRW[1] & CacheHit);                  // exclusion-tag: icache AnyUpdateHit
-  assign CMOZeroNoEviction = CMOpM[3] & ~LineDirty;   // (hit or miss) with no writeback store zeros now
-  assign CMOWriteback = ((CMOpM[1] | CMOpM[2]) & CacheHit & HitLineDirty) | CMOpM[3] & LineDirty;
+  // With CACHE_LATENCY = 2 a request in READY, or a step of a flush, waits until the registered
+  // array outputs hold its set.  The request is hidden from the rest of the FSM while it waits.
+  // A read skipped for the loop buffer also leaves the arrays holding an old set, so a request
+  // that needs the cache after all waits a cycle while the arrays read PAdr.
+  assign ArrayWait = (~ArrayReady | ReadSkipped) & ((CurrState == STATE_READY & ((|CacheRW) | (|CMOpM))) | CurrState == STATE_FLUSH);
+  assign CacheRWReq = ArrayWait ? 2'b00 : CacheRW;
+  assign CMOpReq = ArrayWait ? 4'b0000 : CMOpM;
+  assign FlushStep = CurrState == STATE_FLUSH & ~ArrayWait;
+
+  assign AnyMiss = (CacheRWReq[0] | CacheRWReq[1]) & ~CacheHit & ~InvalidateCache; // exclusion-tag: cache AnyMiss
+  assign AnyUpdateHit = (CacheRWReq[0]) & CacheHit;                            // exclusion-tag: icache storeAMO1
+  assign AnyHit = AnyUpdateHit | (CacheRWReq[1] & CacheHit);                  // exclusion-tag: icache AnyUpdateHit
+  assign CMOZeroNoEviction = CMOpReq[3] & ~LineDirty;   // (hit or miss) with no writeback store zeros now
+  assign CMOWriteback = ((CMOpReq[1] | CMOpReq[2]) & CacheHit & HitLineDirty) | CMOpReq[3] & LineDirty;
   
   assign FlushFlag = FlushAdrFlag & FlushWayFlag;
 
+  // A writeback of a sectored line takes one burst per dirty sector
+  assign SectorWriteback = CurrState == STATE_WRITEBACK | CurrState == STATE_FLUSH_WRITEBACK;
+  assign WritebackDone = CacheBusAck & ~MoreSectors;
+
   // outputs for the performance counters.
-  assign CacheAccess = (|CacheRW) & ((CurrState == STATE_READY & ~Stall & ~FlushStage) | (CurrState == STATE_READ_HOLD & ~Stall & ~FlushStage)); // exclusion-tag: icache CacheW
+  assign CacheAccess = (|CacheRWReq) & ((CurrState == STATE_READY & ~Stall & ~FlushStage) | (CurrState == STATE_READ_HOLD & ~Stall & ~FlushStage)); // exclusion-tag: icache CacheW
   assign CacheMiss = CacheAccess & ~CacheHit;
 
   // special case on reset. When the fsm first exists reset the
@@ -127,15 +151,16 @@ module cachefsm import cvw::*; #(parameter cvw_t P,
       STATE_READ_HOLD:       if(Stall)                                         NextState = STATE_READ_HOLD;
                              else                                              NextState = STATE_READY;
       // exclusion-tag-start: icache case
-      STATE_WRITEBACK:       if(CacheBusAck & ~(|CMOpM[3:1]))                  NextState = STATE_FETCH;
-                             else if(CacheBusAck)                              NextState = STATE_READ_HOLD; // Read_hold lowers CacheStall
+      STATE_WRITEBACK:       if(WritebackDone & ~(|CMOpM[3:1]))                NextState = STATE_FETCH;
+                             else if(WritebackDone)                            NextState = STATE_READ_HOLD; // Read_hold lowers CacheStall
                              else                                              NextState = STATE_WRITEBACK;
       // eviction needs a delay as the bus fsm does not correctly handle sending the write command at the same time as getting back the bus ack.
-      STATE_FLUSH:           if(LineDirty)                                     NextState = STATE_FLUSH_WRITEBACK;
+      STATE_FLUSH:           if(ArrayWait)                                     NextState = STATE_FLUSH;
+                             else if(LineDirty)                                NextState = STATE_FLUSH_WRITEBACK;
                              else if (FlushFlag)                               NextState = STATE_READ_HOLD;
                              else                                              NextState = STATE_FLUSH;
-      STATE_FLUSH_WRITEBACK: if(CacheBusAck & ~FlushFlag)                      NextState = STATE_FLUSH;
-                             else if(CacheBusAck)                              NextState = STATE_READ_HOLD;
+      STATE_FLUSH_WRITEBACK: if(WritebackDone & ~FlushFlag)                    NextState = STATE_FLUSH;
+                             else if(WritebackDone)                            NextState = STATE_READ_HOLD;
                              else                                              NextState = STATE_FLUSH_WRITEBACK;
       // exclusion-tag-end: icache case
       default:                                                                 NextState = STATE_READY;
@@ -144,7 +169,7 @@ module cachefsm import cvw::*; #(parameter cvw_t P,
 
   // com back to CPU
   assign CacheCommitted = (CurrState != STATE_READY) & ~(READ_ONLY_CACHE & (CurrState == STATE_READ_HOLD));
-  assign StallConditions =  FlushCache | AnyMiss | CMOWriteback;
+  assign StallConditions =  FlushCache | AnyMiss | CMOWriteback | ArrayWait;
   assign CacheStall = (CurrState == STATE_READY & StallConditions) | // exclusion-tag: icache StallStates
                       (CurrState == STATE_FETCH) |
                       (CurrState == STATE_WRITEBACK) |
@@ -154,58 +179,61 @@ module cachefsm import cvw::*; #(parameter cvw_t P,
   // write enables internal to cache
   assign SetValid = CurrState == STATE_WRITE_LINE | 
                     (CurrState == STATE_READY & CMOZeroNoEviction) |
-                    (CurrState == STATE_WRITEBACK & CacheBusAck & CMOpM[3]); 
-  assign ClearValid = (CurrState == STATE_READY & CMOpM[0]) |
-                      (CurrState == STATE_WRITEBACK & CMOpM[2] & CacheBusAck);
+                    (CurrState == STATE_WRITEBACK & WritebackDone & CMOpM[3]); 
+  assign ClearValid = (CurrState == STATE_READY & CMOpReq[0]) |
+                      (CurrState == STATE_WRITEBACK & CMOpM[2] & WritebackDone);
   assign LRUWriteEn = (((CurrState == STATE_READY & (AnyHit | CMOZeroNoEviction)) |
                        (CurrState == STATE_WRITE_LINE)) & ~FlushStage) |
-                      (CurrState == STATE_WRITEBACK & CMOpM[3] & CacheBusAck);
+                      (CurrState == STATE_WRITEBACK & CMOpM[3] & WritebackDone);
   // exclusion-tag-start: icache flushdirtycontrols
   assign SetDirty = (CurrState == STATE_READY & (AnyUpdateHit | CMOZeroNoEviction)) |         // exclusion-tag: icache SetDirty  
                     (CurrState == STATE_WRITE_LINE & (CacheRW[0])) |
-                    (CurrState == STATE_WRITEBACK & (CMOpM[3] & CacheBusAck));                    
+                    (CurrState == STATE_WRITEBACK & (CMOpM[3] & WritebackDone));                    
   assign ClearDirty = (CurrState == STATE_WRITE_LINE & ~(CacheRW[0])) |   // exclusion-tag: icache ClearDirty
-                      (CurrState == STATE_FLUSH & LineDirty) | // This is wrong in a multicore snoop cache protocal.  Dirty must be cleared concurrently and atomically with writeback.  For single core cannot clear after writeback on bus ack and change flushadr.  Clears the wrong set.
+                      (FlushStep & LineDirty) | // This is wrong in a multicore snoop cache protocal.  Dirty must be cleared concurrently and atomically with writeback.  For single core cannot clear after writeback on bus ack and change flushadr.  Clears the wrong set.
   // Flush and eviction controls
-                      CurrState == STATE_WRITEBACK & (CMOpM[1] | CMOpM[2]) & CacheBusAck;
-  assign SelWay = (CurrState == STATE_WRITEBACK & ((~CacheBusAck & ~(CMOpM[1] | CMOpM[2])) | (CacheBusAck & CMOpM[3]))) |
+                      CurrState == STATE_WRITEBACK & (CMOpM[1] | CMOpM[2]) & WritebackDone;
+  assign SelWay = (CurrState == STATE_WRITEBACK & ((~WritebackDone & ~(CMOpM[1] | CMOpM[2])) | (WritebackDone & CMOpM[3]))) |
                   (CurrState == STATE_READY & ((AnyMiss & LineDirty) | (CMOZeroNoEviction & ~CacheHit))) | 
                   (CurrState == STATE_WRITE_LINE);
-  assign SelWriteback = (CurrState == STATE_WRITEBACK & (CMOpM[1] | CMOpM[2] | ~CacheBusAck)) |
+  assign SelWriteback = (CurrState == STATE_WRITEBACK & (CMOpM[1] | CMOpM[2] | ~WritebackDone)) |
                         (CurrState == STATE_READY & AnyMiss & LineDirty);
   // coverage off -item e 1 -fecexprrow 1
-  // (state is always FLUSH_WRITEBACK when FlushWayFlag & CacheBusAck)
-  assign FlushAdrCntEn = (CurrState == STATE_FLUSH_WRITEBACK & FlushWayFlag & CacheBusAck) |
-             (CurrState == STATE_FLUSH & FlushWayFlag & ~LineDirty);
-  assign FlushWayCntEn = (CurrState == STATE_FLUSH & ~LineDirty) |
-             (CurrState == STATE_FLUSH_WRITEBACK & CacheBusAck);
-  assign FlushCntRst = (CurrState == STATE_FLUSH & FlushFlag & ~LineDirty) |
-              (CurrState == STATE_FLUSH_WRITEBACK & FlushFlag & CacheBusAck);
+  // (state is always FLUSH_WRITEBACK when FlushWayFlag & WritebackDone)
+  assign FlushAdrCntEn = (CurrState == STATE_FLUSH_WRITEBACK & FlushWayFlag & WritebackDone) |
+             (FlushStep & FlushWayFlag & ~LineDirty);
+  assign FlushWayCntEn = (FlushStep & ~LineDirty) |
+             (CurrState == STATE_FLUSH_WRITEBACK & WritebackDone);
+  assign FlushCntRst = (FlushStep & FlushFlag & ~LineDirty) |
+              (CurrState == STATE_FLUSH_WRITEBACK & FlushFlag & WritebackDone);
   // exclusion-tag-end: icache flushdirtycontrols
   // Bus interface controls
   assign CacheBusRW[1] = (CurrState == STATE_READY & AnyMiss & ~LineDirty) | // exclusion-tag: icache CacheBusRCauses
                          (CurrState == STATE_FETCH & ~CacheBusAck) | 
-                         (CurrState == STATE_WRITEBACK & CacheBusAck & ~(|CMOpM));
+                         (CurrState == STATE_WRITEBACK & WritebackDone & ~(|CMOpM));
 
   logic LoadMiss;
-  assign LoadMiss = (CacheRW[1]) & ~CacheHit & ~InvalidateCache; // exclusion-tag: cache AnyMiss
+  assign LoadMiss = (CacheRWReq[1]) & ~CacheHit & ~InvalidateCache; // exclusion-tag: cache AnyMiss
 
   assign CacheBusRW[0] = (CurrState == STATE_READY & LoadMiss & LineDirty) | // exclusion-tag: icache CacheBusW
-                         (CurrState == STATE_WRITEBACK & ~CacheBusAck) |
-                         (CurrState == STATE_FLUSH_WRITEBACK & ~CacheBusAck) |
-                         (CurrState == STATE_WRITEBACK & (CMOpM[1] | CMOpM[2]) & ~CacheBusAck);
+                         (CurrState == STATE_WRITEBACK & ~WritebackDone) |
+                         (CurrState == STATE_FLUSH_WRITEBACK & ~WritebackDone) |
+                         (CurrState == STATE_WRITEBACK & (CMOpM[1] | CMOpM[2]) & ~WritebackDone);
 
-  assign SelAdrData = (CurrState == STATE_READY & (CacheRW[0] | AnyMiss | (|CMOpM))) | // exclusion-tag: icache SelAdrCauses // changes if store delay hazard removed
+  assign SelAdrData = (CurrState == STATE_READY & (CacheRWReq[0] | AnyMiss | (|CMOpReq) | ArrayWait)) | // exclusion-tag: icache SelAdrCauses // changes if store delay hazard removed
                   (CurrState == STATE_FETCH) |
                   (CurrState == STATE_WRITEBACK) |
                   (CurrState == STATE_WRITE_LINE) |
                   resetDelay;
-  assign SelAdrTag = (CurrState == STATE_READY & (AnyMiss | (|CMOpM))) | // exclusion-tag: icache SelAdrTag // changes if store delay hazard removed
+  assign SelAdrTag = (CurrState == STATE_READY & (AnyMiss | (|CMOpReq) | ArrayWait)) | // exclusion-tag: icache SelAdrTag // changes if store delay hazard removed
                   (CurrState == STATE_FETCH) |
                   (CurrState == STATE_WRITEBACK) |
                   (CurrState == STATE_WRITE_LINE) |
                   resetDelay;
   assign SelFetchBuffer = CurrState == STATE_WRITE_LINE | CurrState == STATE_READ_HOLD;
-  assign CacheEn = (~Stall | StallConditions) | (CurrState != STATE_READY) | reset | InvalidateCache; // exclusion-tag: dcache CacheEn
+  assign HoldArrays = Stall | SkipRead; // SkipRead is tied low in the D$, so CacheEn's coverage rows are unchanged
+  assign CacheEn = (~HoldArrays | StallConditions) | (CurrState != STATE_READY) | reset | InvalidateCache; // exclusion-tag: dcache CacheEn
+  assign SkipArrayRead = ~CacheEn & ~Stall;
+  flopr #(1) ReadSkippedReg(clk, reset, SkipArrayRead | (ReadSkipped & ~CacheEn), ReadSkipped);
                        
 endmodule // cachefsm
@@ -30,7 +30,7 @@
 
 module cacheway import cvw::*; #(parameter cvw_t P, 
                   parameter PA_BITS, XLEN, NUMLINES=512, LINELEN = 256, TAGLEN = 26,
-                  OFFSETLEN = 5, INDEXLEN = 9, READ_ONLY_CACHE = 0) (
+                  OFFSETLEN = 5, INDEXLEN = 9, READ_ONLY_CACHE = 0, SECTORS = 1) (
   input  logic                        clk,
   input  logic                        reset,
   input  logic                        FlushStage,     // Pipeline flush of second stage (prevent writes and bus operations)
@@ -49,9 +49,15 @@ module cacheway import cvw::*; #(parameter cvw_t P,
   input  logic                        FlushWay,       // This way is selected for flush and possible writeback if dirty
   input  logic                        InvalidateCache,// Clear all valid bits
   input  logic [LINELEN/8-1:0]        LineByteMask,   // Final byte enables to cache (D$ only)
+  input  logic [SECTORS-1:0]          SectorMask,     // Sector holding PAdr
+  input  logic [SECTORS-1:0]          WriteSectors,   // Sectors whose valid or dirty bits are set or cleared
+  input  logic                        KeepSectors,    // Keep the other sectors' valid and dirty bits on a write
+  input  logic                        LineOp,         // Cache maintenance operation acts on the whole line regardless of sector
 
   output logic [LINELEN-1:0]          ReadDataLineWay,// This way's read data if valid
   output logic                        HitWay,         // This way hits
+  output logic                        SectorMissWay,  // This way holds PAdr's line but not its sector
+  output logic [SECTORS-1:0]          DirtySectorsWay,// This way's dirty sectors if selected
   output logic                        ValidWay,       // This way is valid
   output logic                        HitDirtyWay,    // The hit way is dirty
   output logic                        DirtyWay   ,    // The selected way is dirty
@@ -63,10 +69,14 @@ module cacheway import cvw::*; #(parameter cvw_t P,
   localparam                          LOGXLENBYTES = $clog2(XLEN/8);
   localparam                          BYTESPERWORD = XLEN/8;
 
-  logic [NUMLINES-1:0]                ValidBits;
-  logic [NUMLINES-1:0]                DirtyBits;
-  logic [LINELEN-1:0]                 ReadDataLine;
-  logic [TAGLEN-1:0]                  ReadTag;
+  logic [NUMLINES-1:0][SECTORS-1:0]  ValidBits;
+  logic [NUMLINES-1:0][SECTORS-1:0]  DirtyBits;
+  logic [SECTORS-1:0]                 ValidSectors, ValidSectorsArray;
+  logic [SECTORS-1:0]                 DirtySectors, DirtySectorsArray;
+  logic [SECTORS-1:0]                 KeptValid, KeptDirty;
+  logic                               TagMatch, SectorValid;
+  logic [LINELEN-1:0]                 ReadDataLine, ReadDataLineArray;
+  logic [TAGLEN-1:0]                  ReadTag, ReadTagArray;
   logic                               Dirty;
   logic                               SelDirty;
   logic                               SelectedWriteWordEn;
@@ -108,22 +118,25 @@ module cacheway import cvw::*; #(parameter cvw_t P,
   assign SetValidEN = SetValidWay & ~FlushStage;                           // exclusion-tag: cache SetValidEN
   assign ClearValidEN = ClearValidWay & ~FlushStage;                       // exclusion-tag: cache ClearValidEN
 
-  // If writing the whole line set all write enables to 1, else only set the correct word.
-  assign FinalByteMask = SetValidWay ? '1 : LineByteMask; // OR
+  // cache.sv enables the whole line, or the sectors being filled, when writing a line, else only the correct word.
+  assign FinalByteMask = LineByteMask;
 
   /////////////////////////////////////////////////////////////////////////////////////////////
   // Tag Array
   /////////////////////////////////////////////////////////////////////////////////////////////
 
   ram1p1rwe #(.USE_SRAM(P.USE_SRAM), .DEPTH(NUMLINES), .WIDTH(TAGLEN)) CacheTagMem(.clk, .ce(CacheEn),
-    .addr(CacheSetTag), .dout(ReadTag),
+    .addr(CacheSetTag), .dout(ReadTagArray),
     .din(PAdr[PA_BITS-1:OFFSETLEN+INDEXLEN]), .we(SetValidEN));
 
   // AND portion of distributed tag multiplexer
   assign TagWay = SelData ? ReadTag : '0; // AND part of AOMux
   assign HitDirtyWay = Dirty & ValidWay;
   assign DirtyWay = SelDirty & HitDirtyWay;                               // exclusion-tag: icache DirtyWay
-  assign HitWay = ValidWay & (ReadTag == PAdr[PA_BITS-1:OFFSETLEN+INDEXLEN]) & ~InvalidateCacheDelay; // exclusion-tag: dcache HitWay
+  assign TagMatch = ValidWay & (ReadTag == PAdr[PA_BITS-1:OFFSETLEN+INDEXLEN]) & ~InvalidateCacheDelay;
+  assign SectorValid = |(ValidSectors & SectorMask);
+  assign HitWay = TagMatch & (SectorValid | LineOp);                      // exclusion-tag: dcache HitWay
+  assign SectorMissWay = TagMatch & ~SectorValid & ~LineOp;
 
   flop #(1) InvalidateCacheReg(clk, InvalidateCache, InvalidateCacheDelay);
 
@@ -140,17 +153,38 @@ module cacheway import cvw::*; #(parameter cvw_t P,
   for(words = 0; words < NUMSRAM; words++) begin: word
     if (!READ_ONLY_CACHE) begin:wordram
       ram1p1rwbe #(.USE_SRAM(P.USE_SRAM), .DEPTH(NUMLINES), .WIDTH(P.CACHE_SRAMLEN)) CacheDataMem(.clk, .ce(CacheEn), .addr(CacheSetData),
-      .dout(ReadDataLine[P.CACHE_SRAMLEN*(words+1)-1:P.CACHE_SRAMLEN*words]),
+      .dout(ReadDataLineArray[P.CACHE_SRAMLEN*(words+1)-1:P.CACHE_SRAMLEN*words]),
       .din(LineWriteData[P.CACHE_SRAMLEN*(words+1)-1:P.CACHE_SRAMLEN*words]),
       .we(SelectedWriteWordEn), .bwe(FinalByteMask[SRAMLENINBYTES*(words+1)-1:SRAMLENINBYTES*words]));
     end else begin:wordram // no byte-enable needed for i$.
       ram1p1rwe #(.USE_SRAM(P.USE_SRAM), .DEPTH(NUMLINES), .WIDTH(P.CACHE_SRAMLEN)) CacheDataMem(.clk, .ce(CacheEn), .addr(CacheSetData),
-      .dout(ReadDataLine[P.CACHE_SRAMLEN*(words+1)-1:P.CACHE_SRAMLEN*words]),
+      .dout(ReadDataLineArray[P.CACHE_SRAMLEN*(words+1)-1:P.CACHE_SRAMLEN*words]),
       .din(LineWriteData[P.CACHE_SRAMLEN*(words+1)-1:P.CACHE_SRAMLEN*words]),
       .we(SelectedWriteWordEn));
     end
   end
 
+  /////////////////////////////////////////////////////////////////////////////////////////////
+  // Array output registers
+  /////////////////////////////////////////////////////////////////////////////////////////////
+
+  // With CACHE_LATENCY = 2 the tag compare and way mux see the arrays a cycle after they are read.
+  // The registers load every cycle; cache.sv tracks which set they hold and stalls until it is PAdr's.
+  if (P.CACHE_LATENCY > 1) begin:arrayreg
+    flop #(TAGLEN)  ReadTagReg(clk, ReadTagArray, ReadTag);
+    flop #(LINELEN) ReadDataLineReg(clk, ReadDataLineArray, ReadDataLine);
+    flop #(2*SECTORS) ValidDirtyReg(clk, {ValidSectorsArray, DirtySectorsArray}, {ValidSectors, DirtySectors});
+  end else begin:arrayreg
+    assign ReadTag = ReadTagArray;
+    assign ReadDataLine = ReadDataLineArray;
+    assign {ValidSectors, DirtySectors} = {ValidSectorsArray, DirtySectorsArray};
+  end
+
+  // A line is valid if any of its sectors is.  Only valid sectors can be dirty.
+  assign ValidWay = |ValidSectors;
+  assign Dirty = |(DirtySectors & ValidSectors);
+  assign DirtySectorsWay = SelData ? DirtySectors & ValidSectors : '0;
+
   // AND portion of distributed read multiplexers
   assign ReadDataLineWay = SelData ? ReadDataLine : '0;  // AND part of AO mux.
 
@@ -158,12 +192,17 @@ module cacheway import cvw::*; #(parameter cvw_t P,
   // Valid Bits
   /////////////////////////////////////////////////////////////////////////////////////////////
   
+  // Filling a new line clears the valid and dirty bits of its other sectors; filling a sector
+  // of a line already present, or storing to it, keeps them.
+  assign KeptValid = KeepSectors ? ValidBits[CacheSetData] : '0;
+  assign KeptDirty = KeepSectors ? DirtyBits[CacheSetData] : '0;
+
   always_ff @(posedge clk) begin // Valid bit array, 
     if (reset) ValidBits        <= #1 '0;
     if(CacheEn) begin 
-      ValidWay <= #1 ValidBits[CacheSetTag];
+      ValidSectorsArray <= #1 ValidBits[CacheSetTag];
       if(InvalidateCache)                    ValidBits <= #1 '0; // exclusion-tag: dcache invalidateway
-      else if (SetValidEN) ValidBits[CacheSetData] <= #1 SetValidWay;
+      else if (SetValidEN) ValidBits[CacheSetData] <= #1 KeptValid | WriteSectors;
       else if (ClearValidEN) ValidBits[CacheSetData] <= #1 '0; // exclusion-tag: icache ClearValidBits
     end
   end
@@ -178,9 +217,9 @@ module cacheway import cvw::*; #(parameter cvw_t P,
       // reset is optional.  Consider merging with TAG array in the future.
       //if (reset) DirtyBits <= #1 {NUMLINES{1'b0}}; 
       if(CacheEn) begin
-        Dirty <= #1 DirtyBits[CacheSetTag];
-        if((SetDirtyWay | ClearDirtyWay) & ~FlushStage) DirtyBits[CacheSetData] <= #1 SetDirtyWay; // exclusion-tag: cache UpdateDirty
+        DirtySectorsArray <= #1 DirtyBits[CacheSetTag];
+        if((SetDirtyWay | ClearDirtyWay) & ~FlushStage) DirtyBits[CacheSetData] <= #1 SetDirtyWay ? KeptDirty | WriteSectors : KeptDirty & ~WriteSectors; // exclusion-tag: cache UpdateDirty
       end
     end
-  end else assign Dirty = 1'b0;
+  end else assign DirtySectorsArray = '0;
 endmodule
@@ -35,6 +35,7 @@
 package cvw;
 
   `include "BranchPredictorType.vh"
+  `include "CacheReplacementType.vh"
 
 typedef struct packed {
   int           XLEN;     // Machine width (32 or 64)
@@ -43,6 +44,7 @@ typedef struct packed {
   int           AHBW;     // AHB bus width (usually = XLEN)
   int           RAM_LATENCY; // Latency to stress AHB 
   logic         BURST_EN; // Support AHB Burst Mode
+  int           EBU_ARB;  // EBU arbitration policy between IFU and LSU
 
   // RISC-V Features
   logic         ZICSR_SUPPORTED;
@@ -81,24 +83,34 @@ typedef struct packed {
   int           DCACHE_NUMWAYS;
   int           DCACHE_WAYSIZEINBYTES;
   int           DCACHE_LINELENINBITS;
+  int           DCACHE_REPLACEMENT;
+  int           DCACHE_SECTORS;
   int           ICACHE_NUMWAYS;
   int           ICACHE_WAYSIZEINBYTES;
   int           ICACHE_LINELENINBITS;
+  int           ICACHE_REPLACEMENT;
+  logic         LOOPBUF_SUPPORTED;
+  int           LOOPBUF_ENTRIES;
   int           CACHE_SRAMLEN;
+  int           CACHE_LATENCY;
 
 // Integer Divider Configuration
 // IDIV_BITSPERCYCLE must be 1, 2, or 4
   int           IDIV_BITSPERCYCLE;
   logic         IDIV_ON_FPU;
+  logic         CSRFWD_SUPPORTED;
+  logic         LOADFWD_SUPPORTED;
 
 // Legal number of PMP entries are 0, 16, or 64
   int           PMP_ENTRIES;
+  logic         PMPCACHE_SUPPORTED;
 
 // Address space
   logic [63:0]  RESET_VECTOR;
 
 // WFI Timeout Wait
   int           WFI_TIMEOUT_BIT;
+  int           WFI_CLOCKGATE;
 
 // Peripheral Addresses
 // Peripheral memory space extends from BASE to BASE+RANGE
@@ -138,6 +150,13 @@ typedef struct packed {
   logic         SPI_SUPPORTED;
   logic [63:0]  SPI_BASE;
   logic [63:0]  SPI_RANGE;
+  logic         TRACE_SUPPORTED;
+  logic [63:0]  TRACE_BASE;
+  logic [63:0]  TRACE_RANGE;
+  int           TRACE_ENTRIES;
+  logic         ETH_SUPPORTED;
+  logic [63:0]  ETH_BASE;
+  logic [63:0]  ETH_RANGE;
 
 // Test modes
 
@@ -155,6 +174,7 @@ typedef struct packed {
   int           PLIC_UART_ID;
   int           PLIC_SPI_ID;
   int           PLIC_SDC_ID;
+  int           PLIC_ETH_ID;
 
   logic                BPRED_SUPPORTED;
   logic [31:0]         BPRED_TYPE;
@@ -162,6 +182,7 @@ typedef struct packed {
   int                  BPRED_SIZE;
   int                  BTB_SIZE;
   int                  RAS_SIZE;
+  int                  IBTB_SIZE;        // log2 entries in indirect jump target predictor; 0 disables
   logic                INSTR_CLASS_PRED; // is class predictor enabled
 
 // FPU division architecture
@@ -34,7 +34,8 @@ module ahbcacheinterface import cvw::*; #(
   parameter AHBWLOGBWPL,   // Log2 of ^
   parameter LINELEN,       // Number of bits in cacheline
   parameter LLENPOVERAHBW, // Number of AHB beats in a LLEN word. AHBW cannot be larger than LLEN. (implementation limitation)
-  parameter READ_ONLY_CACHE
+  parameter READ_ONLY_CACHE,
+  parameter SECTORS = 1    // Cache fetches and writebacks move one sector of the line
 )(
   input  logic                HCLK, HRESETn,
   // bus interface controls
@@ -76,8 +77,10 @@ module ahbcacheinterface import cvw::*; #(
   
 
   localparam                  BeatCountThreshold = BEATSPERLINE - 1;  // Largest beat index
+  localparam                  SectorBeatCountThreshold = BEATSPERLINE/SECTORS - 1; // Largest beat index in a sector
   logic [P.PA_BITS-1:0]         LocalHADDR;                             // Address after selecting between cached and uncached operation
   logic [AHBWLOGBWPL-1:0]     BeatCountDelayed;                       // Beat within the cache line in the second (Data) cache stage
+  logic [AHBWLOGBWPL-1:0]     BusBeatCount, BusBeatCountDelayed;      // Beat within the burst
   logic                       CaptureEn;                              // Enable updating the Fetch buffer with valid data from HRDATA
   logic [P.AHBW/8-1:0]          BusByteMaskM;                           // Byte enables within a word. For cache request all 1s
   logic [P.AHBW-1:0]            PreHWDATA;                              // AHB Address phase write data
@@ -95,7 +98,19 @@ module ahbcacheinterface import cvw::*; #(
 
   assign PAdrZero = BusCMOZero ? {PAdr[P.PA_BITS-1:$clog2(LINELEN/8)], {$clog2(LINELEN/8){1'b0}}} : PAdr;
   mux2 #(P.PA_BITS) localadrmux(PAdrZero, CacheBusAdr, Cacheable, LocalHADDR);
-  assign HADDR = ({{P.PA_BITS-AHBWLOGBWPL{1'b0}}, BeatCount} << $clog2(P.AHBW/8)) + LocalHADDR;
+  assign HADDR = ({{P.PA_BITS-AHBWLOGBWPL{1'b0}}, BusBeatCount} << $clog2(P.AHBW/8)) + LocalHADDR;
+
+  // A sectored cache moves one sector per burst.  CacheBusAdr points at the sector, so the beat
+  // within the line is the sector's first beat plus the beat within the burst.
+  if (SECTORS > 1) begin:sectorbeat
+    logic [AHBWLOGBWPL-1:0]   SectorBeat;                             // First beat of the sector being moved
+    assign SectorBeat = Cacheable ? CacheBusAdr[$clog2(LINELEN/8)-1:$clog2(P.AHBW/8)] : '0;
+    assign BeatCount = SectorBeat | BusBeatCount;
+    assign BeatCountDelayed = SectorBeat | BusBeatCountDelayed;
+  end else begin:sectorbeat
+    assign BeatCount = BusBeatCount;
+    assign BeatCountDelayed = BusBeatCountDelayed;
+  end
 
   mux2 #(3) sizemux(.d0(Funct3), .d1(P.AHBW == 32 ? 3'b010 : 3'b011), .s(Cacheable | BusCMOZero), .y(HSIZE));
 
@@ -120,8 +135,8 @@ module ahbcacheinterface import cvw::*; #(
   
   flopen #(P.AHBW/8) HWSTRBReg(HCLK, HREADY, BusByteMaskM[P.AHBW/8-1:0], HWSTRB);
   
-  buscachefsm #(BeatCountThreshold, AHBWLOGBWPL, READ_ONLY_CACHE, P.BURST_EN) AHBBuscachefsm(
+  buscachefsm #(BeatCountThreshold, SectorBeatCountThreshold, AHBWLOGBWPL, READ_ONLY_CACHE, P.BURST_EN) AHBBuscachefsm(
     .HCLK, .HRESETn, .Flush, .BusRW, .BusAtomic, .Stall, .BusCommitted, .BusStall, .CaptureEn, .SelBusBeat,
-    .CacheBusRW, .BusCMOZero, .CacheBusAck, .BeatCount, .BeatCountDelayed,
+    .CacheBusRW, .BusCMOZero, .CacheBusAck, .BeatCount(BusBeatCount), .BeatCountDelayed(BusBeatCountDelayed),
     .HREADY, .HTRANS, .HWRITE, .HBURST);
 endmodule
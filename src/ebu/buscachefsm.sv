@@ -31,6 +31,7 @@
 // HCLK and clk must be the same clock!
 module buscachefsm #(
   parameter BeatCountThreshold,                      // Largest beat index
+  parameter SectorBeatCountThreshold,                // Largest beat index of a cache fetch or writeback, which moves one sector
   parameter AHBWLOGBWPL,                             // Log2 of BEATSPERLINE
   parameter READ_ONLY_CACHE,                         // 1 for read-only instruction cache
   parameter BURST_EN                                 // burst mode supported
@@ -55,8 +56,8 @@ module buscachefsm #(
   output logic                   CacheBusAck,        // Handshack to $ indicating bus transaction completed
   
   // lsu interface
-  output logic [AHBWLOGBWPL-1:0] BeatCount,          // Beat position within the cache line in the Address Phase
-  output logic [AHBWLOGBWPL-1:0] BeatCountDelayed,   // Beat within the cache line in the second (Data) cache stage
+  output logic [AHBWLOGBWPL-1:0] BeatCount,          // Beat position within the burst in the Address Phase
+  output logic [AHBWLOGBWPL-1:0] BeatCountDelayed,   // Beat within the burst in the second (Data) cache stage
   output logic                   SelBusBeat,         // Tells the cache to select the word from ReadData or WriteData from BeatCount rather than PAdr
 
   // BUS interface
@@ -72,6 +73,7 @@ module buscachefsm #(
   busstatetype CurrState, NextState;
 
   logic [AHBWLOGBWPL-1:0] NextBeatCount;
+  logic [AHBWLOGBWPL-1:0] FinalBeat;
   logic                   FinalBeatCount;
   logic [2:0]             LocalBurstType;
   logic                   BeatCntEn;
@@ -117,9 +119,12 @@ module buscachefsm #(
   // Used to store data from data phase of AHB.
   flopenr #(AHBWLOGBWPL) BeatCountReg(HCLK, ~HRESETn | BeatCntReset, BeatCntEn, NextBeatCount, BeatCount);  
   flopenr #(AHBWLOGBWPL) BeatCountDelayedReg(HCLK, ~HRESETn | BeatCntReset, BeatCntEn, BeatCount, BeatCountDelayed);
-  assign NextBeatCount = BeatCount + 1'b1;
+  // Uncached cbo.zero writes a whole line; cache fetches and writebacks move one sector.
+  // Sectors are a power of 2 beats, so the count wraps to 0 for the next burst.
+  assign FinalBeat = BusCMOZero ? BeatCountThreshold[AHBWLOGBWPL-1:0] : SectorBeatCountThreshold[AHBWLOGBWPL-1:0];
+  assign NextBeatCount = (BeatCount + 1'b1) & FinalBeat;
 
-  assign FinalBeatCount = BeatCountDelayed == BeatCountThreshold[AHBWLOGBWPL-1:0];
+  assign FinalBeatCount = BeatCountDelayed == FinalBeat;
   assign BeatCntEn = (((NextState == CACHE_WRITEBACK | NextState == CACHE_FETCH) & HREADY & ~Flush) |
                      (NextState == ADR_PHASE & |CacheBusRW & HREADY)) & ~Flush;
   assign BeatCntReset = NextState == ADR_PHASE;
@@ -148,7 +153,7 @@ module buscachefsm #(
   assign HBURST = BURST_EN & ((|CacheBusRW & ~Flush) | (CacheAccess & |BeatCount)) ? LocalBurstType : 3'b0;  
   
   always_comb begin
-    case(BeatCountThreshold)
+    case(FinalBeat)
       0:        LocalBurstType = 3'b000;
       3:        LocalBurstType = 3'b011; // INCR4
       7:        LocalBurstType = 3'b101; // INCR8
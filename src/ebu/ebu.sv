@@ -48,7 +48,13 @@ module ebu import cvw::*;  #(parameter cvw_t P) (
   input  logic [P.PA_BITS-1:0]  LSUHADDR,  // LSU AHB address
   input  logic [P.XLEN-1:0]     LSUHWDATA, // initially support AHBW = XLEN
   input  logic [P.XLEN/8-1:0]   LSUHWSTRB, // AHB byte mask
-  output logic                LSUHREADY, // AHB peripheral. Never gated as LSU always has priority
+  output logic                LSUHREADY, // AHB peripheral ready gated by possible non-grant
+  // Pipeline state for critical-first arbitration
+  input  logic                FetchEmpty, // Decode holds no instruction
+  input  logic                FetchStall, // Memory stage holds no memory access
+  // Performance counter events
+  output logic                IFUArbWait, // IFU waits for the bus held by the LSU
+  output logic                LSUArbWait, // LSU waits for the bus held by the IFU
 
   // AHB-Lite external signals
   output logic                HCLK, HRESETn, 
@@ -91,7 +97,8 @@ module ebu import cvw::*;  #(parameter cvw_t P) (
   assign HRESETn = ~reset;
 
   // if two requests come in at once pick one to select and save the others Address phase
-  // inputs.  Abritration scheme is LSU always goes first.
+  // inputs.  Abritration scheme is LSU always goes first unless P.EBU_ARB lets the IFU go first,
+  // in which case the LSU is held off before it reaches the bus.
 
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   // input stages and muxing for IFU and LSU
@@ -103,7 +110,7 @@ module ebu import cvw::*;  #(parameter cvw_t P) (
     .HWRITEOut(IFUHWRITEOut), .HSIZEOut(IFUHSIZEOut), .HBURSTOut(IFUHBURSTOut), .HREADYOut(IFUHREADY),
     .HTRANSOut(IFUHTRANSOut), .HADDROut(IFUHADDROut), .HREADYIn(HREADY));
 
-  // LSU always has priority so there should never be a need to save and restore the address phase inputs.
+  // LSU either goes first or is held off before it is granted, so there is never a need to save and restore the address phase inputs.
   controllerinput #(P.PA_BITS, 0) LSUInput(.HCLK, .HRESETn, .Save(1'b0), .Restore(1'b0), .Disable(LSUDisable),
     .Request(LSUReq),
     .HWRITEIn(LSUHWRITE), .HSIZEIn(LSUHSIZE), .HBURSTIn(LSUHBURST), .HTRANSIn(LSUHTRANS), .HADDRIn(LSUHADDR), .HREADYOut(LSUHREADY),
@@ -124,8 +131,8 @@ module ebu import cvw::*;  #(parameter cvw_t P) (
   assign HWSTRB = LSUHWSTRB;
   // HRDATA is sent to all controllers at the core level.
 
-  ebufsmarb ebufsmarb(.HCLK, .HRESETn, .HBURST, .HREADY, .LSUReq, .IFUReq, .IFUSave,
-          .IFURestore, .IFUDisable, .IFUSelect, .LSUDisable, .LSUSelect);
+  ebufsmarb #(P.EBU_ARB) ebufsmarb(.HCLK, .HRESETn, .HBURST, .HREADY, .LSUReq, .IFUReq, .FetchEmpty, .FetchStall, .IFUSave,
+          .IFURestore, .IFUDisable, .IFUSelect, .LSUDisable, .LSUSelect, .IFUArbWait, .LSUArbWait);
   
 endmodule
 
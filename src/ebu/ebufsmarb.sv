@@ -3,10 +3,10 @@
 //
 // Written: Ross Thompson ross1728@gmail.com
 // Created: 23 January 2023
-// Modified: 23 January 2023
+// Modified: 19 October 2026 - selectable arbitration policy and wait-cycle events
 //
 // Purpose: Arbitrates requests from instruction and data streams
-//          LSU has priority.
+//          LSU has priority unless ARB selects a policy that lets the IFU go first.
 // 
 // Documentation: RISC-V System on Chip Design Chapter 6 (Figures 6.25 and 6.26)
 //
@@ -29,7 +29,9 @@
 // and limitations under the License.
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
-module ebufsmarb (
+module ebufsmarb #(
+  parameter ARB = 0                              // 0: LSU first, 1: round robin, 2: oldest first, 3: critical first
+)(
   input  logic       HCLK,
   input  logic       HRESETn,
   input  logic [2:0] HBURST,
@@ -39,13 +41,17 @@ module ebufsmarb (
 
   input  logic       LSUReq,
   input  logic       IFUReq,
+  input  logic       FetchEmpty,                 // Decode holds no instruction, so nothing is queued behind the fetch
+  input  logic       FetchStall,                 // No memory access in the Memory stage, so the pipeline waits only on the fetch
   
   output logic       IFUSave,
   output logic       IFURestore,
   output logic       IFUDisable,
   output logic       IFUSelect,
   output logic       LSUDisable,
-  output logic       LSUSelect);
+  output logic       LSUSelect,
+  output logic       IFUArbWait,                 // IFU requests but another manager holds the bus
+  output logic       LSUArbWait);                // LSU requests but another manager holds the bus
   
   typedef enum       logic [1:0] {IDLE, ARBITRATE} statetype;
   statetype          CurrState, NextState;
@@ -57,6 +63,42 @@ module ebufsmarb (
   logic [3:0]        BeatCount;                  // Position within a burst transfer
   logic              BeatCntReset;
   logic [3:0]        Threshold;                  // Number of beats derived from HBURST
+  logic              LSUReqArb;                  // LSU request after deferral to the IFU
+  logic              DeferLSU;                   // Hold the LSU off the bus until the IFU transaction completes
+
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+  // Arbitration policy
+  // The IFU wins by deferring a new LSU transaction.  An LSU that has not yet been granted holds its
+  // address phase while HREADY is gated, so no save and restore is needed.  Deferral lasts until the
+  // IFU drops its request after its final address phase, and is never applied to an LSU already
+  // on the bus.  When the LSU wins, the FSM below preempts the IFU as before.
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+  if (ARB == 0) begin:policy
+    assign DeferLSU = 1'b0;
+  end else begin:policy
+    logic IFUWins;                               // Policy grants the IFU when both contend
+    logic Contend;                               // A new LSU transaction contends with the IFU
+    logic DeferLSUD;                             // LSU was deferred last cycle
+    logic LSUOnBusD;                             // LSU held the bus last cycle
+
+    flopr #(2) policyreg(HCLK, ~HRESETn, {DeferLSU, LSUSelect & LSUReqArb}, {DeferLSUD, LSUOnBusD});
+    assign Contend = (CurrState == IDLE) & LSUReq & IFUReq & ~LSUOnBusD;
+
+    if (ARB == 1) begin:rr                     // round robin: alternate the winner on each contention
+      logic IFUWonLast;
+      flopenr #(1) lastwinnerreg(HCLK, ~HRESETn, Contend & ~DeferLSUD, IFUWins, IFUWonLast);
+      assign IFUWins = ~IFUWonLast;
+    end else if (ARB == 2) begin:oldest       // oldest first: the IFU wins if it was already waiting; ties go to the LSU
+      assign IFUWins = IFUReqD;
+    end else begin:critical                   // the IFU wins when the front end has drained or only the fetch holds the pipeline
+      assign IFUWins = FetchEmpty | FetchStall;
+    end
+
+    assign DeferLSU = Contend & (DeferLSUD | IFUWins);
+  end
+
+  assign LSUReqArb = LSUReq & ~DeferLSU;
 
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   // Aribtration scheme
@@ -64,19 +106,18 @@ module ebufsmarb (
   // a burst is completed.
   ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-  assign both = LSUReq & IFUReq;
+  assign both = LSUReqArb & IFUReq;
   flopenl #(.TYPE(statetype)) busreg(HCLK, ~HRESETn, 1'b1, NextState, IDLE, CurrState);
   always_comb 
     case (CurrState) 
       IDLE:      if (both)                                      NextState = ARBITRATE; 
                  else                                           NextState = IDLE;
-      ARBITRATE: if (HREADY & FinalBeatD & ~(LSUReq & IFUReq))  NextState = IDLE;
+      ARBITRATE: if (HREADY & FinalBeatD & ~both)               NextState = IDLE;
                  else                                           NextState = ARBITRATE;
       default:                                                  NextState = IDLE;
     endcase
 
-  // basic arb always selects LSU when both
-  // replace this block for more sophisticated arbitration as needed.
+  // The FSM always selects the LSU when both reach it; the policy above decides whether the LSU is deferred instead.
   // Controller 0 (IFU)
   assign IFUSave = CurrState == IDLE & both;
   assign IFURestore = CurrState == ARBITRATE;
@@ -89,8 +130,12 @@ module ebufsmarb (
   // This is necessary because the pipeline is stalled for the entire duration of both transactions,
   // and the LSU memory request will stil be active.
   flopr #(1) ifureqreg(HCLK, ~HRESETn, IFUReq, IFUReqD);
-  assign LSUDisable = (CurrState == ARBITRATE) ? 1'b0 : (IFUReqD & ~(HREADY & FinalBeatD));
-  assign LSUSelect = (NextState == ARBITRATE) ? 1'b1: LSUReq;
+  assign LSUDisable = (CurrState == ARBITRATE) ? 1'b0 : (IFUReqD & ~(HREADY & FinalBeatD)) | DeferLSU;
+  assign LSUSelect = (NextState == ARBITRATE) ? 1'b1: LSUReqArb;
+
+  // Arbitration wait cycles for performance counters: requesting but off the bus or with HREADY withheld
+  assign IFUArbWait = IFUReq & (LSUSelect | IFUDisable);
+  assign LSUArbWait = LSUReq & (~LSUSelect | LSUDisable);
 
   ////////////////////////////////////////////////////////////////////////////////////////////////////
   // Burst mode logic
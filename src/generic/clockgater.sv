@@ -34,10 +34,9 @@ module clockgater #(parameter FPGA) (
 
   if (FPGA) BUFGCE bufgce_i0 (.I(CLK), .CE(E | SE), .O(ECLK));
   else begin
-    // *** BUG 
-    // VERY IMPORTANT.
-    // This part functionally models a clock gater, but does not necessarily meet the timing constrains a real standard cell would.
-    // Do not use this in synthesis!
+    // This part functionally models a latch-based clock gater, but does not necessarily meet the timing constraints a
+    // real standard cell would.  synthDC replaces it with the library's integrated clock gate (replace_clock_gates)
+    // when WFI_CLOCKGATE = 1; do not synthesize it as discrete gates.
     logic   enable_q;
     always_latch begin
       if(~CLK) begin
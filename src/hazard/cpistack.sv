@@ -0,0 +1,102 @@
+///////////////////////////////////////////
+// cpistack.sv
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified:
+//
+// Purpose: Top-down CPI stack accounting.  Every cycle is charged to exactly one cause from the
+//          point of view of the Memory stage, where instructions retire: either an instruction
+//          retires, or the cycle is lost to whatever holds up the head of the pipeline.  Stalls
+//          of the whole pipeline are charged to the IFU or LSU.  Bubbles are tagged with the
+//          reason they were inserted (flush, Decode or Execute stall) and the tag travels with
+//          the bubble, so the cycle is charged when the bubble reaches the Memory stage.
+//          Causes are grouped as frontend bound (ICacheMiss, Fetch), bad speculation
+//          (Mispredict, Clear), and backend bound (the rest).  Any HPM counter can count a cause
+//          by writing its code + 1 to the counter's mhpmevent register (see csrc.sv).
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+//
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied. See the License for the specific language governing permissions
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+module cpistack import cvw::*;  #(parameter cvw_t P) (
+  input  logic        clk, reset,
+  input  logic        StallD, StallE, StallM, StallW,
+  input  logic        FlushD, FlushE, FlushM, FlushW,
+  input  logic        InstrValidM,                      // Instruction in Memory stage is valid
+  input  logic        BPWrongE, TrapM, RetM, CSRWriteFenceM,
+  input  logic        FPUStallD, DivBusyE,
+  input  logic        LSUStallM, DCacheStallM, HPTWStall,
+  input  logic        IFUStallF, ICacheStallF,
+  input  logic        wfiM, IntPendingM,
+  output logic [11:0] CPIStackM                         // One-hot cause of this cycle, indexed by the codes below
+);
+
+  // Cause codes
+  localparam RETIRE     = 4'd0;   // an instruction retires
+  localparam ICACHEMISS = 4'd1;   // I$ miss
+  localparam FETCH      = 4'd2;   // other IFU stalls (bus, spill) or no instruction fetched
+  localparam MISPREDICT = 4'd3;   // bubbles from a branch misprediction
+  localparam CLEAR      = 4'd4;   // bubbles from a trap, trap return, CSR write or fence
+  localparam DCACHEMISS = 4'd5;   // D$ miss
+  localparam TLBWALK    = 4'd6;   // hardware page table walk for either TLB
+  localparam LSUBUS     = 4'd7;   // other LSU stalls (uncached bus access, misaligned spill)
+  localparam DEPEND     = 4'd8;   // Decode stalls on a data dependency: load use, CSR read, multiply, FP convert
+  localparam DIVIDE     = 4'd9;   // integer divide busy
+  localparam FPU        = 4'd10;  // FPU stalls in Decode and FP divide busy
+  localparam WFI        = 4'd11;  // waiting for interrupt
+
+  logic       ClearM;
+  logic [3:0] BubbleD, BubbleE, BubbleM;
+  logic [3:0] NextBubbleD, NextBubbleE, NextBubbleM;
+  logic [3:0] CauseM;
+
+  // Tag the bubble inserted into each stage with its reason.  Valid instructions are tagged RETIRE.
+  assign ClearM = TrapM | RetM | CSRWriteFenceM;
+  always_comb begin
+    if (~FlushD)             NextBubbleD = RETIRE;
+    else if (ClearM)         NextBubbleD = CLEAR;
+    else if (BPWrongE)       NextBubbleD = MISPREDICT;
+    else                     NextBubbleD = FETCH;
+    if (~FlushE)             NextBubbleE = BubbleD;
+    else if (ClearM)         NextBubbleE = CLEAR;
+    else if (BPWrongE)       NextBubbleE = MISPREDICT;
+    else if (FPUStallD)      NextBubbleE = FPU;
+    else                     NextBubbleE = DEPEND;
+    if (~FlushM)             NextBubbleM = BubbleE;
+    else if (ClearM)         NextBubbleM = CLEAR;
+    else if (DivBusyE)       NextBubbleM = DIVIDE;
+    else                     NextBubbleM = FPU;     // FP divide busy
+  end
+
+  flopenr #(4) BubbleDReg(clk, reset, ~StallD, NextBubbleD, BubbleD);
+  flopenr #(4) BubbleEReg(clk, reset, ~StallE, NextBubbleE, BubbleE);
+  flopenr #(4) BubbleMReg(clk, reset, ~StallM, NextBubbleM, BubbleM);
+
+  // Charge this cycle.  Whole-pipeline stalls take priority over the bubble tag.
+  always_comb
+    if (InstrValidM & ~StallW & ~FlushW) CauseM = RETIRE;
+    else if (LSUStallM)                  CauseM = HPTWStall ? TLBWALK : DCacheStallM ? DCACHEMISS : LSUBUS;
+    else if (IFUStallF)                  CauseM = ICacheStallF ? ICACHEMISS : FETCH;
+    else if (wfiM & ~IntPendingM)        CauseM = WFI;
+    else if (InstrValidM)                CauseM = CLEAR;  // instruction flushed by a trap
+    else if (BubbleM == RETIRE)          CauseM = FETCH;  // invalid instruction from the IFU
+    else                                 CauseM = BubbleM;
+
+  assign CPIStackM = 12'b1 << CauseM;
+endmodule
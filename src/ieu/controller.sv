@@ -81,6 +81,7 @@ module controller import cvw::*;  #(parameter cvw_t P) (
   output logic [1:0]  AtomicM,                 // Atomic (AMO) instruction
   output logic [2:0]  Funct3M,                 // Instruction's funct3 field
   output logic        RegWriteM,               // Instruction writes a register (needed for Hazard unit)
+  output logic        LoadFwdM,                // Word-sized load or AMO in Memory stage forwards its read data
   output logic        InvalidateICacheM, FlushDCacheM, // Invalidate I$, flush D$
   output logic        InstrValidD, InstrValidE, InstrValidM, // Instruction is valid
   output logic        FWriteIntM,              // FPU controller writes integer register file
@@ -135,9 +136,11 @@ module controller import cvw::*;  #(parameter cvw_t P) (
   logic        BRegWriteE;                     // Register write from BMU controller in Execute Stage
   logic        IllegalERegAdrD;                // RV32E attempts to write upper 16 registers
   logic [1:0]  AtomicE;                        // Atomic instruction 
-  logic        FenceD, FenceE;                 // Fence instruction
+  logic        FenceD, FenceE;                 // Fence or CSR write that must flush the following instructions
+  logic        CSRNoFlushD;                    // CSR write that cannot affect the following instructions
   logic        SFenceVmaD;                     // sfence.vma instruction
   logic        IntDivM;                        // Integer divide instruction
+  logic        FastLoadE;                      // Word-sized load or AMO whose read data can be forwarded from Memory stage
   logic [1:0]  BSelectD;                       // One-Hot encoding if it's ZBA_ZBB_ZBC_ZBS instruction in decode stage
   logic [2:0]  ZBBSelectD;                     // ZBB Mux Select Signal
   logic [1:0]  CZeroD;
@@ -150,7 +153,7 @@ module controller import cvw::*;  #(parameter cvw_t P) (
   logic        AFunctD, AMOFunctD;             // Detect atomic instructions
   logic        RWFunctD, MWFunctD;             // detect RW/MW instructions
   logic        PFunctD, CSRFunctD;             // detect privileged / CSR instruction
-  logic        FenceM;                         // Fence.I or sfence.VMA instruction in memory stage
+  logic        FenceM;                         // Fence.I, sfence.VMA, or flushing CSR write in memory stage
   logic [2:0]  PreALUSelectD;                  // ALU Output selection mux control (before possible Zicond logic)
   logic [2:0]  ALUSelectD;                     // ALU Output selection mux control
   logic        IWValidFunct3D;                 // Detects if Funct3 is valid for IW instructions
@@ -307,8 +310,22 @@ module controller import cvw::*;  #(parameter cvw_t P) (
   
   assign CSRZeroSrcD = InstrD[14] ? (InstrD[19:15] == 0) : (Rs1D == 0); // Is a CSR instruction using zero as the source?
   assign CSRWriteD = CSRReadD & !(CSRZeroSrcD & InstrD[13]);            // Don't write if setting or clearing zeros
-  assign SFenceVmaD = PrivilegedD & (InstrD[31:25] ==  7'b0001001);
-  assign FenceD = SFenceVmaD | FenceXD; // possible sfence.vma or fence.i
+  assign SFenceVmaD = PrivilegedD & (InstrD[31:25] ==  7'b0001001 | 
+                      (P.SVINVAL_SUPPORTED & InstrD[31:20] == 12'b000110000001)); // sfence.vma or sfence.inval.ir
+  // Only fence.i, sfence.vma, and CSR writes that can change fetch, translation, decode, or interrupts flush the pipeline.
+  // An ordinary fence (Funct3 = 000) is a nop because memory operations complete in order before the next begins.
+  // Writes to trap handler scratch and state registers, fflags, and counters are only read by instructions in the
+  // Memory stage, after the write, so they don't flush.  frm and fcsr must flush because the FPU reads the rounding mode in Decode.
+  always_comb
+    casez (InstrD[31:20])
+      12'h001,                                                    // fflags
+      12'h140, 12'h141, 12'h142, 12'h143,                         // sscratch, sepc, scause, stval
+      12'h320,                                                    // mcountinhibit
+      12'h340, 12'h341, 12'h342, 12'h343,                         // mscratch, mepc, mcause, mtval
+      12'b1011_?00?_????: CSRNoFlushD = 1;                        // mcycle, minstret, mhpmcounters, and their upper halves
+      default:            CSRNoFlushD = 0;
+    endcase
+  assign FenceD = SFenceVmaD | (FenceXD & Funct3D[0]) | (CSRWriteD & ~CSRNoFlushD); // sfence.vma, fence.i, or flushing CSR write
   
   // ALU Decoding is lazy, only using func7[5] to distinguish add/sub and srl/sra
   assign sltuD = (Funct3D == 3'b011); 
@@ -452,8 +469,8 @@ module controller import cvw::*;  #(parameter cvw_t P) (
                          {RegWriteW, ResultSrcW, IntDivW});  
   flopenrc #(5) RdWReg(clk, reset, FlushW, ~StallW, RdM, RdW);
 
-  // Flush F, D, and E stages on a CSR write or Fence.I or SFence.VMA
-  assign CSRWriteFenceM = CSRWriteM | FenceM;
+  // Flush F, D, and E stages on a CSR write that needs it or Fence.I or SFence.VMA
+  assign CSRWriteFenceM = FenceM;
 
   // Forwarding logic
   always_comb begin
@@ -468,12 +485,21 @@ module controller import cvw::*;  #(parameter cvw_t P) (
       else if ((Rs2E == RdW) & RegWriteW) ForwardBE = 2'b01;
   end
 
+  // Word-sized integer loads (lw on RV32, ld on RV64) bypass their aligned read data from the Memory stage
+  // when LOADFWD_SUPPORTED, removing the load-use bubble.  Subword loads still stall for sign extension.
+  // AMOs of the same size return the old memory value the same way; the D$ completes them in the Memory
+  // stage on a hit, so only the read data needs forwarding.  LR/SC keep the stall.
+  localparam logic [2:0] FWDLOADFUNCT3 = (P.XLEN == 64) ? 3'b011 : 3'b010;
+  assign FastLoadE = P.LOADFWD_SUPPORTED & IEURegWriteE & ((MemRWE == 2'b10) & (AtomicE == 2'b00) | (AtomicE == 2'b10)) & (Funct3E == FWDLOADFUNCT3);
+  assign LoadFwdM  = P.LOADFWD_SUPPORTED & ((MemRWM == 2'b10) & (AtomicM == 2'b00) | (AtomicM == 2'b10)) & (Funct3M == FWDLOADFUNCT3);
+
   // Stall on dependent operations that finish in Mem Stage and can't bypass in time
   // Structural hazard causes stall if any of these events occur
   assign MatchDE = ((Rs1D == RdE) | (Rs2D == RdE)) & (RdE != 5'b0); // Decode-stage instruction source depends on result from execute stage instruction
-  assign LoadStallD = (MemReadE|SCE) & MatchDE;  
+  // Branches and jumps still stall so forwarded load data never reaches the branch resolution and next PC in the same cycle
+  assign LoadStallD = ((MemReadE & ~(FastLoadE & ~(BranchD | JumpD))) | SCE) & MatchDE; // word-sized load data is forwarded from Memory stage if supported
   assign StoreStallD = MemRWD[1] & MemRWE[0];   // Store or AMO followed by load or AMO
-  assign CSRRdStallD = CSRReadE & MatchDE;
+  assign CSRRdStallD = CSRReadE & MatchDE & ~P.CSRFWD_SUPPORTED; // CSR read value is forwarded from Memory stage if supported
   assign MDUStallD = MDUE & MatchDE; // Int mult/div is at least two cycle latency, even when coming from the FDIV
   assign FCvtIntStallD = FCvtIntE & MatchDE; // FPU to Integer transfers have single-cycle latency except fcvt
   assign StructuralStallD = LoadStallD | StoreStallD | CSRRdStallD | MDUStallD | FCvtIntStallD;
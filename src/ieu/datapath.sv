@@ -59,6 +59,10 @@ module datapath import cvw::*;  #(parameter cvw_t P) (
   input  logic              StallM, FlushM,          // Stall, flush Memory stage
   input  logic              FWriteIntM, FCvtIntW,    // FPU writes integer register file, FPU converts float to int
   input  logic [P.XLEN-1:0] FIntResM,                // FPU integer result
+  input  logic              CSRReadM,                // CSR read instruction
+  input  logic [P.XLEN-1:0] CSRReadValM,             // CSR read result, forwarded when CSRFWD_SUPPORTED
+  input  logic              LoadFwdM,                // Word-sized load in Memory stage
+  input  logic [P.XLEN-1:0] LoadFwdDataM,            // Load read data, forwarded when LOADFWD_SUPPORTED
   output logic [P.XLEN-1:0] SrcAM,                   // ALU's Source A in Memory stage to privilege unit for CSR writes
   output logic [P.XLEN-1:0] WriteDataM,              // Write data in Memory stage
   // Writeback stage signals
@@ -88,6 +92,8 @@ module datapath import cvw::*;  #(parameter cvw_t P) (
   // Memory stage signals
   logic [P.XLEN-1:0] IEUResultM;                     // Result from execution stage
   logic [P.XLEN-1:0] IFResultM;                      // Result from either IEU or single-cycle FPU op writing an integer register
+  logic [P.XLEN-1:0] ForwardResultM;                 // Result forwarded from Memory stage to Execute stage
+  logic [P.XLEN-1:0] CSRFwdResultM;                  // Memory stage result after CSR read forwarding
   // Writeback stage signals
   logic [P.XLEN-1:0] SCResultW;                      // Store Conditional result
   logic [P.XLEN-1:0] ResultW;                        // Result to write to register file
@@ -104,8 +110,8 @@ module datapath import cvw::*;  #(parameter cvw_t P) (
   flopenrc #(P.XLEN) RD2EReg(clk, reset, FlushE, ~StallE, R2D, R2E);
   flopenrc #(P.XLEN) ImmExtEReg(clk, reset, FlushE, ~StallE, ImmExtD, ImmExtE);
   
-  mux3  #(P.XLEN)  faemux(R1E, ResultW, IFResultM, ForwardAE, ForwardedSrcAE);
-  mux3  #(P.XLEN)  fbemux(R2E, ResultW, IFResultM, ForwardBE, ForwardedSrcBE);
+  mux3  #(P.XLEN)  faemux(R1E, ResultW, ForwardResultM, ForwardAE, ForwardedSrcAE);
+  mux3  #(P.XLEN)  fbemux(R2E, ResultW, ForwardResultM, ForwardBE, ForwardedSrcBE);
   comparator #(P.XLEN) comp(ForwardedSrcAE, ForwardedSrcBE, BranchSignedE, FlagsE);
   mux2  #(P.XLEN)  srcamux(ForwardedSrcAE, PCE, ALUSrcAE, SrcAE);
   mux2  #(P.XLEN)  srcbmux(ForwardedSrcBE, ImmExtE, ALUSrcBE, SrcBE);
@@ -118,6 +124,20 @@ module datapath import cvw::*;  #(parameter cvw_t P) (
   flopenrc #(P.XLEN) IEUResultMReg(clk, reset, FlushM, ~StallM, IEUResultE, IEUResultM);
   flopenrc #(P.XLEN) WriteDataMReg(clk, reset, FlushM, ~StallM, ForwardedSrcBE, WriteDataM); 
   
+  // CSR reads complete in the Memory stage.  Forwarding them removes the stall on a dependent instruction.
+  if (P.CSRFWD_SUPPORTED) begin:csrfwd
+    mux2  #(P.XLEN)  csrfwdmuxM(IFResultM, CSRReadValM, CSRReadM, CSRFwdResultM);
+  end else begin:csrfwd
+    assign CSRFwdResultM = IFResultM;
+  end
+
+  // Word-sized loads forward their aligned read data so a dependent instruction need not stall
+  if (P.LOADFWD_SUPPORTED) begin:loadfwd
+    mux2  #(P.XLEN)  loadfwdmuxM(CSRFwdResultM, LoadFwdDataM, LoadFwdM, ForwardResultM);
+  end else begin:loadfwd
+    assign ForwardResultM = CSRFwdResultM;
+  end
+  
   // Writeback stage pipeline register and logic
   flopenrc #(P.XLEN) IFResultWReg(clk, reset, FlushW, ~StallW, IFResultM, IFResultW);
 
@@ -5,7 +5,7 @@
 // Created: 15 February 2021
 // Modified: 25 January 2023
 //
-// Purpose: 2 bit saturating counter predictor with parameterized table depth.
+// Purpose: Return address stack with speculative pops and checkpoint repair on flush.
 // 
 // Documentation: RISC-V System on Chip Design Chapter 10 (Figure ***)
 //
@@ -37,66 +37,92 @@ module RASPredictor import cvw::*;  #(parameter cvw_t P)(
   input  logic             ReturnE, CallE,                  // Instr class
   input  logic             BPReturnF,
   input  logic [P.XLEN-1:0] PCLinkE,                                   // PC of instruction after a call
-  output logic [P.XLEN-1:0] RASPCF                                     // Top of the stack
+  output logic [P.XLEN-1:0] RASPCF,                                    // Top of the stack
+  output logic             RASValidF                                   // Stack holds at least one return address
    );
 
-  logic                     CounterEn;
   localparam Depth = $clog2(P.RAS_SIZE);
 
-  logic [Depth-1:0]         NextPtr, Ptr, P1, M1, IncDecPtr;
+  logic [Depth-1:0]         Ptr, NextPtr, CommitPtr, NextCommitPtr;
+  logic [Depth:0]           Count, NextCount, CommitCount, NextCommitCount;
   logic [P.RAS_SIZE-1:0]     [P.XLEN-1:0] memory;
   integer        index;
 
   logic      PopF;
-  logic      PushE;
-  logic      RepairD;
+  logic      PushE, PopE;
   logic      IncrRepairD, DecRepairD;
-  
-  logic      DecrementPtr;
-  logic      FlushedReturnDE;
   logic      WrongPredReturnD;
+  logic      KillD, KillE, Restore;
+  logic signed [2:0] Offset, CommitOffset;
+
+  // Add a small signed offset to a stack pointer, wrapping if the stack is not a power of 2
+  function automatic logic [Depth-1:0] PtrAdd(input logic [Depth-1:0] Base, input logic signed [2:0] Delta);
+    int Sum;
+    Sum = int'(Base) + int'(Delta);
+    if (Sum < 0)                Sum = Sum + P.RAS_SIZE;
+    else if (Sum >= P.RAS_SIZE) Sum = Sum - P.RAS_SIZE;
+    return Sum[Depth-1:0];
+  endfunction
+
+  // Add a small signed offset to the occupancy, saturating at empty and full
+  function automatic logic [Depth:0] CountAdd(input logic [Depth:0] Base, input logic signed [2:0] Delta);
+    int Sum;
+    Sum = int'(Base) + int'(Delta);
+    if (Sum < 0)               Sum = 0;
+    else if (Sum > P.RAS_SIZE) Sum = P.RAS_SIZE;
+    return Sum[Depth:0];
+  endfunction
   
-  
+  // Returns pop speculatively as they leave Fetch.  Calls push as they leave Execute, once no older
+  // branch can redirect them, so the stack contents are never corrupted by wrong path instructions.
   assign PopF = BPReturnF & ~StallD & ~FlushD;
   assign PushE = CallE & ~StallM & ~FlushM;
+  assign PopE = ReturnE & ~StallM & ~FlushM;
 
+  // Fix the class prediction as the instruction leaves Decode.
   assign WrongPredReturnD = (BPReturnWrongD) & ~StallE & ~FlushE;
-  assign FlushedReturnDE = (~StallE & FlushE & ReturnD) | (FlushM & ReturnE); // flushed return
+  assign IncrRepairD = WrongPredReturnD & ~ReturnD; // Guessed it was a return, but its not
+  assign DecRepairD =  WrongPredReturnD & ReturnD;  // Guessed non return but is a return.
 
-  assign RepairD = WrongPredReturnD | FlushedReturnDE ;
+  // Several calls and returns can pop, push, and repair in the same cycle.
+  assign Offset = {2'b0, PushE} + {2'b0, IncrRepairD} - {2'b0, PopF} - {2'b0, DecRepairD};
 
-  assign IncrRepairD = FlushedReturnDE | (WrongPredReturnD & ~ReturnD); // Guessed it was a return, but its not
+  // Checkpoint: the pointer and occupancy after every instruction which has left Execute.
+  // By then each instruction's pop has been accounted for, by PopF or DecRepairD.
+  assign CommitOffset = {2'b0, PushE} - {2'b0, PopE};
+  assign NextCommitPtr = PtrAdd(CommitPtr, CommitOffset);
+  assign NextCommitCount = CountAdd(CommitCount, CommitOffset);
+  flopr #(Depth) CommitPtrReg(clk, reset, NextCommitPtr, CommitPtr);
+  flopr #(Depth+1) CommitCountReg(clk, reset, NextCommitCount, CommitCount);
 
-  assign DecRepairD =  WrongPredReturnD & ReturnD; // Guessed non return but is a return.
-    
-  assign CounterEn = PopF | PushE | RepairD;
+  // Restore the checkpoint whenever the instruction in Decode or Execute is flushed, no matter how many
+  // speculative pops it and younger instructions made.  A flush which only inserts a bubble behind a
+  // stalled stage kills nothing and must not restore.
+  assign KillD = FlushE & ~StallD;
+  assign KillE = FlushM & ~StallE;
+  assign Restore = KillD | KillE;
 
-  assign DecrementPtr = (PopF | DecRepairD) & ~IncrRepairD;
-
-  assign P1 = 1;
-  assign M1 = '1; // -1
-  mux2 #(Depth) PtrMux(P1, M1, DecrementPtr, IncDecPtr);
-  logic [Depth-1:0] Sum;
-  assign Sum = Ptr + IncDecPtr;
-  if(|P.RAS_SIZE[Depth-1:0])
-    assign NextPtr = Sum >= P.RAS_SIZE[Depth-1:0] ? 0 : Sum; // wrap back around if our stack is not a power of 2
-  else
-    assign NextPtr = Sum;
-  //assign NextPtr = Ptr + IncDecPtr;
-
-  flopenr #(Depth) PTR(clk, reset, CounterEn, NextPtr, Ptr);
+  assign NextPtr = Restore ? NextCommitPtr : PtrAdd(Ptr, Offset);
+  assign NextCount = Restore ? NextCommitCount : CountAdd(Count, Offset);
+  flopr #(Depth) PTR(clk, reset, NextPtr, Ptr);
+  flopr #(Depth+1) CountReg(clk, reset, NextCount, Count);
 
   // RAS must be reset. 
+  // The push lands above the checkpoint rather than the speculative pointer, which younger returns may
+  // already have popped.  When the stack is full the oldest entry is overwritten.
   always_ff @ (posedge clk) begin
     if(reset) begin
       for(index=0; index<P.RAS_SIZE; index++)
     memory[index] <= {P.XLEN{1'b0}};
     end else if(PushE) begin
-      memory[NextPtr] <= #1 PCLinkE;
+      memory[NextCommitPtr] <= #1 PCLinkE;
     end
   end
 
   assign RASPCF = memory[Ptr];
-  
+
+  // Once deeper returns than RAS_SIZE have popped every valid entry, the remaining entries are stale.
+  // Let the BTB predict these returns instead.
+  assign RASValidF = |Count;
   
 endmodule
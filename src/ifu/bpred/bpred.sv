@@ -67,12 +67,15 @@ module bpred import cvw::*;  #(parameter cvw_t P) (
   output logic             BPDirPredWrongM,           // Prediction direction is wrong
   output logic             BTAWrongM,                 // Prediction target wrong
   output logic             RASPredPCWrongM,           // RAS prediction is wrong
+  output logic             IndTargetWrongM,           // Indirect jump target prediction is wrong
   output logic             IClassWrongM               // Class prediction is wrong
   );
 
   logic [1:0]              BPDirPredF;
 
   logic [P.XLEN-1:0]        BPBTAF, RASPCF;
+  logic [P.XLEN-1:0]        BPTargetF;
+  logic                     RASValidF, BPRASF;
   logic                    BPPCWrongE;
   logic                    IClassWrongE;
   logic                    BPDirPredWrongE;
@@ -172,7 +175,22 @@ module bpred import cvw::*;  #(parameter cvw_t P) (
   // Part 3 RAS
   RASPredictor #(P) RASPredictor(.clk, .reset, .StallF, .StallD, .StallE, .StallM, .FlushD, .FlushE, .FlushM,
     .BPReturnF, .ReturnD, .ReturnE, .CallE,
-    .BPReturnWrongD, .RASPCF, .PCLinkE);
+    .BPReturnWrongD, .RASPCF, .RASValidF, .PCLinkE);
+
+  // Part 4 indirect jump target predictor
+  // Overrides the BTB's target for jalr (not return) when its tag hits.
+  if (P.IBTB_SIZE != 0) begin:IndPredictor
+    logic                   IndPredF;
+    logic [P.XLEN-1:0]      IndTargetF;
+    indpred #(P, P.IBTB_SIZE) IndirectPredictor(.clk, .reset, .StallF, .StallD, .StallE, .StallM, .StallW, 
+      .FlushD, .FlushE, .FlushM, .FlushW,
+      .PCNextF, .PCF, .PCM, .BPJumpF, .BPReturnF, .InstrD, .JumpD, .ReturnD,
+      .BranchM, .JumpM, .PCSrcM, .BPWrongM, .IEUAdrM, .IndPredF, .IndTargetF, .IndTargetWrongM);
+    mux2 #(P.XLEN) pcmuxind(BPBTAF, IndTargetF, IndPredF, BPTargetF);
+  end else begin
+    assign BPTargetF = BPBTAF;
+    assign IndTargetWrongM = '0;
+  end
 
   // Check the prediction
   // if it is a CFI then check if the next instruction address (PCD) matches the branch's target or fallthrough address.
@@ -186,7 +204,9 @@ module bpred import cvw::*;  #(parameter cvw_t P) (
   
   // Output the predicted PC or corrected PC on miss-predict.
   assign BPPCSrcF = (BPBranchF & BPDirPredF[1]) | BPJumpF;
-  mux2 #(P.XLEN) pcmuxbp(BPBTAF, RASPCF, BPReturnF, BPPCF);
+  // Returns deeper than the RAS fall back on the BTB.
+  assign BPRASF = BPReturnF & RASValidF;
+  mux2 #(P.XLEN) pcmuxbp(BPTargetF, RASPCF, BPRASF, BPPCF);
   // Selects the BP or PC+2/4.
   mux2 #(P.XLEN) pcmux0(PCPlus2or4F, BPPCF, BPPCSrcF, PC0NextF);
   // If the prediction is wrong select the correct address.
@@ -200,7 +220,7 @@ module bpred import cvw::*;  #(parameter cvw_t P) (
   else  assign NextValidPCE = PCE;
 
   if(P.ZIHPM_SUPPORTED) begin
-    logic [P.XLEN-1:0]       RASPCD, RASPCE;
+    logic [P.XLEN-1:0]       ReturnPCF, RASPCD, RASPCE;
     logic                    RASPredPCWrongE;  
     // performance counters
     // 1. class         (class wrong / minstret) (IClassWrongM / csr)                    // Correct now
@@ -215,7 +235,8 @@ module bpred import cvw::*;  #(parameter cvw_t P) (
     // **** use BPBTAWrongM from BTB.
     assign RASPredPCWrongE = (RASPCE != IEUAdrE) & ReturnE & PCSrcE;
 
-    flopenrc #(P.XLEN) RASTargetDReg(clk, reset, FlushD, ~StallD, RASPCF, RASPCD);
+    mux2 #(P.XLEN) returnpcmux(BPTargetF, RASPCF, RASValidF, ReturnPCF);
+    flopenrc #(P.XLEN) RASTargetDReg(clk, reset, FlushD, ~StallD, ReturnPCF, RASPCD);
     flopenrc #(P.XLEN) RASTargetEReg(clk, reset, FlushE, ~StallE, RASPCD, RASPCE);
     flopenrc #(2) BPPredWrongRegM(clk, reset, FlushM, ~StallM, 
       {BPDirPredWrongE, RASPredPCWrongE},
@@ -0,0 +1,110 @@
+///////////////////////////////////////////
+// indpred.sv
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified: 
+//
+// Purpose: Indirect jump target predictor. A tagged table indexed by the PC hashed with a path history
+//          of recent taken control flow targets.  Supplies the target of jalr instructions which are
+//          not returns, such as switch tables, function pointers, and interpreter dispatch, whose target
+//          changes from one execution to the next and so defeats the BTB.
+//
+// Documentation: RISC-V System on Chip Design Chapter 10
+// 
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+// 
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file 
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You 
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the 
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, 
+// either express or implied. See the License for the specific language governing permissions 
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+module indpred import cvw::*;  #(parameter cvw_t P, 
+                                 parameter Depth = 8,
+                                 parameter TagBits = 8) (
+  input  logic             clk,
+  input  logic             reset,
+  input  logic             StallF, StallD, StallE, StallM, StallW, FlushD, FlushE, FlushM, FlushW,
+  input  logic [P.XLEN-1:0] PCNextF, PCF, PCM,            // PC at various stages
+  input  logic             BPJumpF, BPReturnF,           // Class prediction; only jumps which are not returns use the table
+  input  logic [31:0]      InstrD,                      // Decompressed decode stage instruction. Used to find jalr
+  input  logic             JumpD, ReturnD,
+  input  logic             BranchM, JumpM, PCSrcM,      // Memory stage control flow outcome for the path history
+  input  logic             BPWrongM,                    // Prediction is wrong
+  input  logic [P.XLEN-1:0] IEUAdrM,                     // Branch/jump target address to insert into table
+  output logic             IndPredF,                    // Table supplies the fetch stage target
+  output logic [P.XLEN-1:0] IndTargetF,                  // Table's guess at PC
+  output logic             IndTargetWrongM              // Indirect jump target was mispredicted
+);
+
+  logic [Depth-1:0]        PHR, PHRNextM;
+  logic [Depth-1:0]        IndexNextF, IndexF, IndexD, IndexE, IndexM;
+  logic [TagBits-1:0]      TagF, TagM, TableTagF;
+  logic                    TableValidF;
+  logic                    IndPredD, IndPredE, IndPredM;
+  logic                    IndirectD, IndirectE, IndirectM;
+  logic                    TakenM, TableWriteM;
+  logic [Depth-1:0]        ReadIndexF;
+  logic                    FwdNextF, FwdF;
+  logic                    TableReadValidF, FwdValidF;
+  logic [TagBits-1:0]      TableReadTagF, FwdTagF;
+  logic [P.XLEN-1:0]       TableTargetF, FwdTargetF;
+
+  // Path history register.  Each taken branch or jump shifts the history by two and folds in its target.
+  // The history is updated as the control flow instruction leaves the Memory stage, so it is never
+  // corrupted by wrong path instructions and needs no repair.
+  assign TakenM = (BranchM | JumpM) & PCSrcM;
+  assign PHRNextM = {PHR[Depth-3:0], 2'b00} ^ IEUAdrM[Depth+1:2];
+  flopenr #(Depth) PHRReg(clk, reset, ~StallW & ~FlushW & TakenM, PHRNextM, PHR);
+
+  // hash the PC in the same way as the BTB, then mix in the path history.
+  // The fetch index is captured with the same enable as the table's read address and carried down the
+  // pipeline because the history may change before the jump reaches the Memory stage.
+  assign IndexNextF = {PCNextF[Depth+1] ^ PCNextF[1], PCNextF[Depth:2]} ^ PHR;
+  flopen #(Depth) IndexFReg(clk, ~StallF | reset, IndexNextF, IndexF);
+  assign TagF = PCF[Depth+TagBits+1:Depth+2];
+  assign TagM = PCM[Depth+TagBits+1:Depth+2];
+
+  ram2p1r1wbe #(.USE_SRAM(P.USE_SRAM), .DEPTH(2**Depth), .WIDTH(P.XLEN+TagBits+1)) memory(
+    .clk, .ce1(~StallF | reset), .ra1(IndexNextF), .rd1({TableReadValidF, TableReadTagF, TableTargetF}),
+     .ce2(~StallW & ~FlushW), .wa2(IndexM), .wd2({IndirectM, TagM, IEUAdrM}), .we2(TableWriteM), .bwe2('1));
+
+  // A read of the entry being written returns the old contents, so back-to-back indirect jumps through
+  // the same entry would see a stale target.  Forward the written entry instead.  While the Fetch stage
+  // is stalled the read is held, so compare against the index already read.
+  mux2 #(Depth) readindexmux(IndexNextF, IndexF, StallF, ReadIndexF);
+  assign FwdNextF = TableWriteM & ~StallW & ~FlushW & (ReadIndexF == IndexM);
+  flopenr #(1) FwdFReg(clk, reset, ~StallF | FwdNextF, FwdNextF, FwdF);
+  flopen #(P.XLEN+TagBits+1) FwdDataReg(clk, FwdNextF, {IndirectM, TagM, IEUAdrM}, {FwdValidF, FwdTagF, FwdTargetF});
+  mux2 #(P.XLEN+TagBits+1) fwdmux({TableReadValidF, TableReadTagF, TableTargetF}, {FwdValidF, FwdTagF, FwdTargetF}, FwdF,
+    {TableValidF, TableTagF, IndTargetF});
+
+  // Only override the BTB when the class predictor also expects a jump which is not a return.
+  assign IndPredF = TableValidF & (TableTagF == TagF) & BPJumpF & ~BPReturnF;
+
+  // jalr which is not a return.  Indirect calls are included.
+  assign IndirectD = JumpD & ~ReturnD & (InstrD[6:0] == 7'b1100111);
+
+  flopenrc #(Depth+1) IndPredDReg(clk, reset, FlushD, ~StallD, {IndexF, IndPredF}, {IndexD, IndPredD});
+  flopenrc #(Depth+2) IndPredEReg(clk, reset, FlushE, ~StallE, {IndexD, IndPredD, IndirectD}, {IndexE, IndPredE, IndirectE});
+  flopenrc #(Depth+2) IndPredMReg(clk, reset, FlushM, ~StallM, {IndexE, IndPredE, IndirectE}, {IndexM, IndPredM, IndirectM});
+
+  // Allocate or replace the entry when an indirect jump is mispredicted.  If the table supplied a wrong
+  // target to any other instruction (an alias), invalidate the entry by writing IndirectM = 0.
+  // Correctly predicted jumps do not write the table.
+  assign TableWriteM = (IndirectM | IndPredM) & BPWrongM;
+  assign IndTargetWrongM = IndirectM & BPWrongM;
+
+endmodule
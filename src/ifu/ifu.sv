@@ -69,6 +69,7 @@ module ifu import cvw::*;  #(parameter cvw_t P) (
   output logic                 BPDirPredWrongM,                          // Prediction direction is wrong
   output logic                 BTAWrongM,                                // Prediction target wrong
   output logic                 RASPredPCWrongM,                          // RAS prediction is wrong
+  output logic                 IndTargetWrongM,                          // Indirect jump target prediction is wrong
   output logic                 IClassWrongM,                             // Class prediction is wrong
   output logic                 ICacheStallF,                             // I$ busy with multicycle operation
   // Faults
@@ -90,6 +91,10 @@ module ifu import cvw::*;  #(parameter cvw_t P) (
   input  logic                 ENVCFG_PBMTE,                             // Page-based memory types enabled
   input  logic                 ENVCFG_ADUE,                              // HPTW A/D Update enable
   input  logic                 sfencevmaM,                               // Virtual memory address fence, invalidate TLB entries
+  input  logic                 SfenceByVAM, SfenceByASIDM,               // Only invalidate entries for SfenceVAdrM / SfenceASIDM
+  input  logic [P.XLEN-1:0]    SfenceVAdrM,                              // Virtual address to invalidate, from rs1
+  input  logic [P.ASID_BITS-1:0] SfenceASIDM,                            // Address space to invalidate, from rs2
+  input  logic                 WritePMPM,                                // PMP CSR written, invalidate cached PMP permissions
   output logic                 ITLBMissF,                                // ITLB miss causes HPTW (hardware pagetable walker) walk
   output logic                 InstrUpdateDAF,                           // ITLB hit needs to update dirty or access bits
   input  var logic [7:0]       PMPCFG_ARRAY_REGW[P.PMP_ENTRIES-1:0],     // PMP configuration from privileged unit
@@ -130,8 +135,11 @@ module ifu import cvw::*;  #(parameter cvw_t P) (
 
   logic                        CacheableF;                               // PMA indicates instruction address is cacheable
   logic                        SelSpillNextF;                            // In a spill, stall pipeline and gate local stallF
+  logic                        LoopHitF;                                 // Instruction comes from the loop buffer rather than the I$
   logic                        BusStall;                                 // Bus interface busy with multicycle operation
   logic                        IFUCacheBusStallF;                        // EIther I$ or bus busy with multicycle operation
+  logic                        PMPCacheMissF;                            // PMP and PMA checks of the fetch address are being filled
+  logic                        IFUMMUMissF;                              // ITLB or PMP cache miss; hold the fetch until it is replayed
   logic                        GatedStallD;                              // StallD gated by selected next spill
   // branch predictor signal
   logic                        BusCommittedF;                            // Bus memory operation in flight, delay interrupts
@@ -148,7 +156,7 @@ module ifu import cvw::*;  #(parameter cvw_t P) (
   /////////////////////////////////////////////////////////////////////////////////////////////
 
   if(P.COMPRESSED_SUPPORTED) begin : Spill
-    spill #(P) spill(.clk, .reset, .StallD, .FlushD, .PCF, .PCPlus4F, .PCNextF, .InstrRawF, .InstrUpdateDAF, .CacheableF, 
+    spill #(P) spill(.clk, .reset, .StallD, .FlushD, .PCF, .PCPlus4F, .PCNextF, .InstrRawF, .InstrUpdateDAF, .CacheableF, .LoopHitF,
       .IFUCacheBusStallF, .ITLBMissF, .PCSpillNextF, .PCSpillF, .SelSpillNextF, .PostSpillInstrRawF, .CompressedF);
   end else begin : NoSpill
     assign PCSpillNextF = PCNextF;
@@ -182,9 +190,10 @@ module ifu import cvw::*;  #(parameter cvw_t P) (
          .PTE(PTE),
          .PageTypeWriteVal(PageType),
          .TLBWrite(ITLBWriteF),
-         .TLBFlush,
+         .TLBFlush, .TLBFlushByVA(SfenceByVAM), .TLBFlushByASID(SfenceByASIDM),
+         .TLBFlushVAdr(SfenceVAdrM), .TLBFlushASID(SfenceASIDM), .WritePMPM,
          .PhysicalAddress(PCPF),
-         .TLBMiss(ITLBMissF),
+         .TLBMiss(ITLBMissF), .PMPCacheMiss(PMPCacheMissF),
          .Cacheable(CacheableF), .Idempotent(), .SelTIM(SelIROM),
          .InstrAccessFaultF, .LoadAccessFaultM(), .StoreAmoAccessFaultM(),
          .InstrPageFaultF, .LoadPageFaultM(), .StoreAmoPageFaultM(),
@@ -194,7 +203,7 @@ module ifu import cvw::*;  #(parameter cvw_t P) (
          .PMPCFG_ARRAY_REGW, .PMPADDR_ARRAY_REGW);
 
   end else begin
-    assign {ITLBMissF, InstrAccessFaultF, InstrPageFaultF, InstrUpdateDAF} = '0;
+    assign {ITLBMissF, PMPCacheMissF, InstrAccessFaultF, InstrPageFaultF, InstrUpdateDAF} = '0;
     assign PCPF = PCFExt[P.PA_BITS-1:0];
     assign CacheableF = '1;
     assign SelIROM = '0;
@@ -211,8 +220,10 @@ module ifu import cvw::*;  #(parameter cvw_t P) (
   // delay the interrupt until the LSU is in a clean state.
   assign CommittedF = CacheCommittedF | BusCommittedF;
 
+  assign IFUMMUMissF = ITLBMissF | PMPCacheMissF;
+
   logic  IgnoreRequest;
-  assign IgnoreRequest = ITLBMissF | FlushD;
+  assign IgnoreRequest = IFUMMUMissF | FlushD;
 
   // The IROM uses untranslated addresses, so it is not compatible with virtual memory.
   if (P.IROM_SUPPORTED) begin : irom
@@ -233,13 +244,15 @@ module ifu import cvw::*;  #(parameter cvw_t P) (
       logic [P.PA_BITS-1:0] ICacheBusAdr;
       logic                 ICacheBusAck;
       logic [1:0]           CacheBusRW, BusRW, CacheRWF;
+      logic [31:0]          FetchInstrF, LoopInstrF;
       
-      assign BusRW = ~ITLBMissF & ~CacheableF & ~SelIROM ? IFURWF : '0;
-      assign CacheRWF = ~ITLBMissF & CacheableF & ~SelIROM ? IFURWF : '0;
+      assign BusRW = ~IFUMMUMissF & ~CacheableF & ~SelIROM ? IFURWF : '0;
+      assign CacheRWF = ~IFUMMUMissF & CacheableF & ~SelIROM & ~LoopHitF ? IFURWF : '0;
       // *** RT: PAdr and NextSet are replaced with mux between PCPF/IEUAdrM and PCSpillNextF/IEUAdrE.
       cache #(.P(P), .PA_BITS(P.PA_BITS), .XLEN(P.XLEN), .LINELEN(P.ICACHE_LINELENINBITS),
               .NUMLINES(P.ICACHE_WAYSIZEINBYTES*8/P.ICACHE_LINELENINBITS),
-              .NUMWAYS(P.ICACHE_NUMWAYS), .LOGBWPL(LOGBWPL), .WORDLEN(32), .MUXINTERVAL(16), .READ_ONLY_CACHE(1))
+              .NUMWAYS(P.ICACHE_NUMWAYS), .LOGBWPL(LOGBWPL), .WORDLEN(32), .MUXINTERVAL(16), .READ_ONLY_CACHE(1),
+              .REPLACEMENT(P.ICACHE_REPLACEMENT))
       icache(.clk, .reset, .FlushStage(FlushD), .Stall(GatedStallD),
              .FetchBuffer, .CacheBusAck(ICacheBusAck),
              .CacheBusAdr(ICacheBusAdr), .CacheStall(ICacheStallF), 
@@ -252,7 +265,7 @@ module ifu import cvw::*;  #(parameter cvw_t P) (
              .CacheRW(CacheRWF),
              .FlushCache('0),
              .NextSet(PCSpillNextF[11:0]),
-             .PAdr(PCPF),
+             .PAdr(PCPF), .SkipRead(LoopHitF),
              .CacheCommitted(CacheCommittedF), .InvalidateCache(InvalidateICacheM), .CMOpM('0)); 
 
       ahbcacheinterface #(P, WORDSPERLINE, LOGBWPL, LINELEN, LLENPOVERAHBW, 1) 
@@ -267,11 +280,24 @@ module ifu import cvw::*;  #(parameter cvw_t P) (
             .BusStall, .BusCommitted(BusCommittedF));
 
       mux3 #(32) UnCachedDataMux(.d0(ICacheInstrF), .d1(ShiftUncachedInstr), .d2(IROMInstrF),
-                                 .s({SelIROM, ~CacheableF}), .y(InstrRawF[31:0]));
+                                 .s({SelIROM, ~CacheableF}), .y(FetchInstrF));
+
+      // Small loops are replayed from the loop buffer without accessing the I$
+      if (P.LOOPBUF_SUPPORTED) begin : loopbuf
+        logic ClearLoopBuf, CaptureValidF;
+        assign ClearLoopBuf = InvalidateICacheM | sfencevmaM | CSRWriteFenceM | TrapM | RetM;
+        assign CaptureValidF = CacheableF & ~SelIROM & ~(IFUMMUMissF | InstrUpdateDAF | InstrPageFaultF | InstrAccessFaultF);
+        loopbuf #(P) loopbuf(.clk, .reset, .StallF, .StallD, .StallE, .FlushD, .ClearLoopBuf, .PCNextF, .PCF, .PCPlus2or4F, .PostSpillInstrRawF,
+          .CaptureValidF, .LoopHitF, .LoopInstrF, .BranchE, .PCSrcE, .PCE, .PCLinkE, .IEUAdrE);
+      end else begin
+        assign LoopHitF = 1'b0;
+        assign LoopInstrF = '0;
+      end
+      mux2 #(32) LoopBufMux(FetchInstrF, LoopInstrF, LoopHitF, InstrRawF);
     end else begin : passthrough
       assign IFUHADDR = PCPF;
       logic [1:0] BusRW;
-      assign BusRW = ~ITLBMissF & ~SelIROM ? IFURWF : '0;
+      assign BusRW = ~IFUMMUMissF & ~SelIROM ? IFURWF : '0;
       assign IFUHSIZE = 3'b010;
 
       ahbinterface #(P.XLEN, 1'b0) ahbinterface(.HCLK(clk), .Flush(FlushD), .HRESETn(~reset), .HREADY(IFUHREADY), 
@@ -284,10 +310,12 @@ module ifu import cvw::*;  #(parameter cvw_t P) (
       else assign InstrRawF = ShiftUncachedInstr;
       assign IFUHBURST = 3'b0;
       assign {ICacheMiss, ICacheAccess, ICacheStallF} = '0;
+      assign LoopHitF = '0;
     end
   end else begin : nobus // block: bus
     assign {BusStall, CacheCommittedF} = '0;   
     assign {ICacheStallF, ICacheMiss, ICacheAccess} = '0;
+    assign LoopHitF = '0;
     assign InstrRawF = IROMInstrF;
   end
 
@@ -296,7 +324,7 @@ module ifu import cvw::*;  #(parameter cvw_t P) (
                                                     PCSpillF[2:1], ShiftUncachedInstr);
   else mux2 #(32) UncachedShiftInstrMux(FetchBuffer[32-1:0], {16'b0, FetchBuffer[32-1:16]}, PCSpillF[1], ShiftUncachedInstr);
   
-  assign IFUCacheBusStallF = ICacheStallF | BusStall;
+  assign IFUCacheBusStallF = ICacheStallF | BusStall | PMPCacheMissF;
   assign IFUStallF = IFUCacheBusStallF | SelSpillNextF;
   assign GatedStallD = StallD & ~SelSpillNextF;
   
@@ -340,7 +368,7 @@ module ifu import cvw::*;  #(parameter cvw_t P) (
                 .BranchD, .BranchE, .JumpD, .JumpE,
                 .InstrD, .PCNextF, .PCPlus2or4F, .PC1NextF, .PCE, .PCM, .PCSrcE, .IEUAdrE, .IEUAdrM, .PCF, .NextValidPCE,
                 .PCD, .PCLinkE, .InstrClassM, .BPWrongE, .PostSpillInstrRawF, .BPWrongM,
-                .BPDirPredWrongM, .BTAWrongM, .RASPredPCWrongM, .IClassWrongM);
+                .BPDirPredWrongM, .BTAWrongM, .RASPredPCWrongM, .IndTargetWrongM, .IClassWrongM);
 
   end else begin : bpred
     mux2 #(P.XLEN) pcmux1(.d0(PCPlus2or4F), .d1(IEUAdrE), .s(PCSrcE), .y(PC1NextF));    
@@ -356,6 +384,7 @@ module ifu import cvw::*;  #(parameter cvw_t P) (
       .IClassWrongE(), .BPReturnWrongD());
     flopenrc #(1) PCSrcMReg(clk, reset, FlushM, ~StallM, PCSrcE, BPWrongM);
     assign RASPredPCWrongM = '0;
+    assign IndTargetWrongM = '0;
     assign BPDirPredWrongM = BPWrongM;
     assign BTAWrongM = BPWrongM;
     assign InstrClassM = {CallM, ReturnM, JumpM, BranchM};
@@ -0,0 +1,129 @@
+///////////////////////////////////////////
+// loopbuf.sv
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified:
+//
+// Purpose: L0 loop buffer in front of the I$.  A taken backward branch in the Execute stage
+//          whose loop body fits in the buffer sets the loop's address range.  Instructions in
+//          that range are captured as they leave the Fetch stage, and later fetches of them are
+//          served from the buffer instead of the I$.  Instructions are stored as 16-bit parcels
+//          indexed by the low PC bits, so a 32-bit instruction that crosses an I$ line is
+//          replayed whole without a spill.  Whether PCNextF is in the buffer is registered, and
+//          while PCF hits, the I$ skips its array read on the guess that PCNextF hits too.  A
+//          fetch that leaves the loop costs a bubble while the I$ reads it.  The buffer only
+//          bypasses the I$; the ITLB and PMP still check every fetch.  It is cleared on fence.i,
+//          sfence.vma, CSR writes, traps, and trap returns, which may change the instructions or
+//          their translation.
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+//
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied. See the License for the specific language governing permissions
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+module loopbuf import cvw::*;  #(parameter cvw_t P) (
+  input  logic              clk, reset,
+  input  logic              StallF, StallD, StallE, FlushD,
+  input  logic              ClearLoopBuf,      // Instructions or their translation may have changed
+  // Fetch
+  input  logic [P.XLEN-1:0] PCNextF,           // Next Fetch stage instruction address
+  input  logic [P.XLEN-1:0] PCF,               // Fetch stage instruction address
+  input  logic [P.XLEN-1:0] PCPlus2or4F,       // Address of the next sequential instruction
+  input  logic [31:0]       PostSpillInstrRawF,// Instruction leaving the Fetch stage
+  input  logic              CaptureValidF,     // Instruction came from the I$ without a fault, so it can be captured
+  output logic              LoopHitF,          // Instruction at PCF is in the buffer
+  output logic [31:0]       LoopInstrF,        // Instruction at PCF from the buffer
+  // Execute
+  input  logic              BranchE, PCSrcE,   // Taken branch in Execute stage
+  input  logic [P.XLEN-1:0] PCE,               // Branch address
+  input  logic [P.XLEN-1:0] PCLinkE,           // Address following the branch, the end of the loop
+  input  logic [P.XLEN-1:0] IEUAdrE            // Branch target, the start of the loop
+);
+
+  localparam PARCELS = 2*P.LOOPBUF_ENTRIES;                // 16-bit parcels in the buffer
+  localparam LOGPARCELS = $clog2(PARCELS);
+  localparam [P.XLEN:0] MAXBACK = 2*PARCELS - 4;           // Largest branch offset whose loop fits
+
+  logic [15:0]              Parcels [PARCELS-1:0];
+  logic [PARCELS-1:0]       ParcelValid;
+  logic [P.XLEN-1:0]        LoopStart, LoopEnd;
+  logic                     LoopValid;
+  logic [P.XLEN:0]          BackE;
+  logic                     NewLoopE, SameLoopE;
+  logic [LOGPARCELS-1:0]    NextIndex, Index, IndexP1;
+  logic                     InLoopNextF, InLoopF;
+  logic                     InRangeF, FitsF, CompressedParcelF, CaptureF;
+
+  /////////////////////////////////////////////////////////////////////////////////////////////
+  // Loop detection
+  /////////////////////////////////////////////////////////////////////////////////////////////
+
+  // A taken backward branch whose target is at most MAXBACK bytes back starts a loop.
+  // Seeing the same loop again keeps the buffer's contents.  A stalled branch may not have
+  // resolved yet, so it waits until Execute advances.
+  assign BackE = {1'b0, PCE} - {1'b0, IEUAdrE};
+  assign NewLoopE = BranchE & PCSrcE & ~StallE & ~BackE[P.XLEN] & (BackE <= MAXBACK);
+  assign SameLoopE = LoopValid & (IEUAdrE == LoopStart) & (PCLinkE == LoopEnd);
+
+  always_ff @(posedge clk)
+    if (reset | ClearLoopBuf) LoopValid <= #1 1'b0;
+    else if (NewLoopE & ~SameLoopE) begin
+      LoopValid <= #1 1'b1;
+      LoopStart <= #1 IEUAdrE;
+      LoopEnd   <= #1 PCLinkE;
+    end
+
+  /////////////////////////////////////////////////////////////////////////////////////////////
+  // Replay
+  /////////////////////////////////////////////////////////////////////////////////////////////
+
+  // The loop body is no larger than the buffer, so indexing by the low PC bits never collides.
+  // Registering the range check on PCNextF keeps it off the I$ read enable; clearing the
+  // buffer clears it too.
+  assign NextIndex = PCNextF[LOGPARCELS:1];
+  assign InLoopNextF = LoopValid & (PCNextF >= LoopStart) & (PCNextF < LoopEnd) & ParcelValid[NextIndex];
+  flopenr #(1) InLoopReg(clk, reset | ClearLoopBuf | (NewLoopE & ~SameLoopE), ~StallF, InLoopNextF, InLoopF);
+
+  assign Index = PCF[LOGPARCELS:1];
+  assign IndexP1 = Index + 1'b1;
+  assign CompressedParcelF = ~(&Parcels[Index][1:0]);
+  assign LoopHitF = InLoopF & (CompressedParcelF | ParcelValid[IndexP1]);
+  assign LoopInstrF = {Parcels[IndexP1], Parcels[Index]};
+
+  /////////////////////////////////////////////////////////////////////////////////////////////
+  // Capture
+  /////////////////////////////////////////////////////////////////////////////////////////////
+
+  // Capture each instruction of the loop body as it moves to Decode, unless it already hit
+  assign InRangeF = LoopValid & (PCF >= LoopStart) & (PCF < LoopEnd);
+  assign FitsF = PCPlus2or4F <= LoopEnd;
+  assign CaptureF = InRangeF & FitsF & CaptureValidF & ~LoopHitF & ~StallD & ~FlushD;
+
+  always_ff @(posedge clk)
+    if (CaptureF) begin
+      Parcels[Index] <= #1 PostSpillInstrRawF[15:0];
+      if (&PostSpillInstrRawF[1:0]) Parcels[IndexP1] <= #1 PostSpillInstrRawF[31:16];
+    end
+
+  always_ff @(posedge clk)
+    if (reset | ClearLoopBuf | (NewLoopE & ~SameLoopE)) ParcelValid <= #1 '0;
+    else if (CaptureF) begin
+      ParcelValid[Index] <= #1 1'b1;
+      if (&PostSpillInstrRawF[1:0]) ParcelValid[IndexP1] <= #1 1'b1;
+    end
+endmodule
@@ -42,6 +42,7 @@ module spill import cvw::*;  #(parameter cvw_t P) (
   input logic               ITLBMissF,         // ITLB miss, ignore memory request
   input logic               InstrUpdateDAF,    // Ignore memory request if the hptw support write and a DA page fault occurs (hptw is still active)
   input logic               CacheableF,        // Is the instruction from the cache?
+  input logic               LoopHitF,          // Whole instruction comes from the loop buffer, so it never spills
   output logic [P.XLEN-1:0] PCSpillNextF,      // The next PCF for one of the two memory addresses of the spill
   output logic [P.XLEN-1:0] PCSpillF,          // PCF for one of the two memory addresses of the spill
   output logic              SelSpillNextF,     // During the transition between the two spill operations, the IFU should stall the pipeline
@@ -86,7 +87,7 @@ module spill import cvw::*;  #(parameter cvw_t P) (
   end else
     assign SpillF = PCF[1];
   // Don't take the spill if there is a stall, TLB miss, or hardware update to the D/A bits
-  assign TakeSpillF = SpillF & ~EarlyCompressedF & ~IFUCacheBusStallF & ~(ITLBMissF | (P.SVADU_SUPPORTED & InstrUpdateDAF));
+  assign TakeSpillF = SpillF & ~EarlyCompressedF & ~LoopHitF & ~IFUCacheBusStallF & ~(ITLBMissF | (P.SVADU_SUPPORTED & InstrUpdateDAF));
   
   always_ff @(posedge clk)
     if (reset | FlushD)    CurrState <= #1 STATE_READY;
@@ -57,8 +57,9 @@ module align import cvw::*;  #(parameter cvw_t P) (
   output logic                    SpillStallM);
 
   localparam LLENINBYTES = P.LLEN/8;
-  localparam OFFSET_BIT_POS =  $clog2(P.DCACHE_LINELENINBITS/8);
+  localparam OFFSET_BIT_POS =  $clog2(P.DCACHE_LINELENINBITS/8/P.DCACHE_SECTORS);
   // Spill threshold occurs when all the cache offset PC bits are 1 (except [0]).  Without a cache this is just PCF[1]
+  // A sectored D$ checks only one sector per access, so accesses spill at sector boundaries.
   typedef enum logic [1:0]  {STATE_READY, STATE_SPILL, STATE_STORE_DELAY} statetype;
 
   statetype          CurrState, NextState;
@@ -47,15 +47,21 @@ module lsu import cvw::*;  #(parameter cvw_t P) (
   output logic                    SquashSCW,                            // Store conditional failed disable write to GPR
   output logic                    DCacheMiss,                           // D cache miss for performance counters
   output logic                    DCacheAccess,                         // D cache memory access for performance counters
+  output logic                    HPTWStall,                            // HPTW busy with multicycle operation, for performance counters
   // address and write data
   input  logic [P.XLEN-1:0]       IEUAdrE,                              // Execution stage memory address
   output logic [P.XLEN-1:0]       IEUAdrM,                              // Memory stage memory address
   input  logic [P.XLEN-1:0]       WriteDataM,                           // Write data from IEU
   output logic [P.LLEN-1:0]       ReadDataW,                            // Read data to IEU or FPU
+  output logic [P.XLEN-1:0]       LoadFwdDataM,                         // Word-sized read data forwarded to IEU in Memory stage
   // cpu privilege
   input  logic [1:0]              PrivilegeModeW,                       // Current privilege mode
   input  logic                    BigEndianM,                           // Swap byte order to big endian
   input  logic                    sfencevmaM,                           // Virtual memory address fence, invalidate TLB entries
+  input  logic                    SfenceByVAM, SfenceByASIDM,           // Only invalidate entries for SfenceVAdrM / SfenceASIDM
+  input  logic [P.XLEN-1:0]       SfenceVAdrM,                          // Virtual address to invalidate, from rs1
+  input  logic [P.ASID_BITS-1:0]  SfenceASIDM,                          // Address space to invalidate, from rs2
+  input  logic                    WritePMPM,                            // PMP CSR written, invalidate cached PMP permissions
   output logic                    DCacheStallM,                         // D$ busy with multicycle operation
   // fpu
   input  logic [P.FLEN-1:0]       FWriteDataM,                          // Write data from FPU
@@ -91,6 +97,7 @@ module lsu import cvw::*;  #(parameter cvw_t P) (
   output logic [P.XLEN-1:0]       PTE,                                  // Page table entry write to ITLB
   output logic [1:0]              PageType,                             // Type of page table entry to write to ITLB
   output logic                    ITLBWriteF,                           // Write PTE to ITLB
+  output logic                    DTLBWriteM,                           // Write PTE to DTLB, for performance counters
   output logic                    SelHPTW,                              // During a HPTW walk the effective privilege mode becomes S_MODE
   input var logic [7:0]           PMPCFG_ARRAY_REGW[P.PMP_ENTRIES-1:0], // PMP configuration from privileged unit
   input var logic [P.PA_BITS-3:0] PMPADDR_ARRAY_REGW[P.PMP_ENTRIES-1:0] // PMP address from privileged unit
@@ -112,8 +119,7 @@ module lsu import cvw::*;  #(parameter cvw_t P) (
   logic                  GatedStallW;                            // Hazard unit StallW gated when SelHPTW = 1
   
   logic                  BusStall;                               // Bus interface busy with multicycle operation
-  logic                  LSUBusStallM;                           // Bus interface busy with multicycle operation masked by IgnoreRequestTLB
-  logic                  HPTWStall;                              // HPTW busy with multicycle operation
+  logic                  LSUBusStallM;                           // Bus interface busy with multicycle operation masked by IgnoreRequestMMU
   logic                  DCacheBusStallM;                        // Cache or bus stall
   logic                  CacheBusHPWTStall;                      // Cache, bus, or hptw is requesting a stall
   logic                  SelSpillE;                              // Align logic detected a spill and needs to stall
@@ -146,11 +152,12 @@ module lsu import cvw::*;  #(parameter cvw_t P) (
   logic                  SelStoreDelay;
   
   logic                  DTLBMissM;                              // DTLB miss causes HPTW walk
-  logic                  DTLBWriteM;                             // Writes PTE and PageType to DTLB
   logic                  DataUpdateDAM;                          // DTLB hit needs to update dirty or access bits
   logic                  LSULoadAccessFaultM;                    // Load acces fault
   logic                  LSUStoreAmoAccessFaultM;                // Store access fault
   logic                  IgnoreRequestTLB;                       // On either ITLB or DTLB miss, ignore miss so HPTW can handle
+  logic                  PMPCacheMissM;                          // PMP and PMA checks of the address are being filled
+  logic                  IgnoreRequestMMU;                       // On a TLB or PMP cache miss, ignore the memory operation until it is replayed
   logic                  IgnoreRequest;                          // On FlushM or TLB miss ignore memory operation
   logic                  SelDTIM;                                // Select DTIM rather than bus or D$
   logic [P.XLEN-1:0]     WriteDataZM;
@@ -228,7 +235,7 @@ module lsu import cvw::*;  #(parameter cvw_t P) (
   // the trap module.
   assign CommittedM = SelHPTW | DCacheCommittedM | BusCommittedM;
   assign GatedStallW = StallW & ~SelHPTW;
-  assign DCacheBusStallM = DCacheStallM | LSUBusStallM;
+  assign DCacheBusStallM = DCacheStallM | LSUBusStallM | PMPCacheMissM; // the HPTW also waits for the PMP cache
   assign CacheBusHPWTStall = DCacheBusStallM | HPTWStall;
   assign LSUStallM = CacheBusHPWTStall | SpillStallM;
 
@@ -243,8 +250,9 @@ module lsu import cvw::*;  #(parameter cvw_t P) (
     mmu #(.P(P), .TLB_ENTRIES(P.DTLB_ENTRIES), .IMMU(0))
     dmmu(.clk, .reset, .SATP_REGW, .STATUS_MXR, .STATUS_SUM, .STATUS_MPRV, .STATUS_MPP, .ENVCFG_PBMTE, .ENVCFG_ADUE,
       .PrivilegeModeW, .DisableTranslation, .VAdr(IHAdrM), .Size(LSUFunct3M[1:0]),
-      .PTE, .PageTypeWriteVal(PageType), .TLBWrite(DTLBWriteM), .TLBFlush(sfencevmaM),
-      .PhysicalAddress(PAdrM), .TLBMiss(DTLBMissM), .Cacheable(CacheableM), .Idempotent(), .SelTIM(SelDTIM), 
+      .PTE, .PageTypeWriteVal(PageType), .TLBWrite(DTLBWriteM), .TLBFlush(sfencevmaM), .TLBFlushByVA(SfenceByVAM), .TLBFlushByASID(SfenceByASIDM),
+      .TLBFlushVAdr(SfenceVAdrM), .TLBFlushASID(SfenceASIDM), .WritePMPM,
+      .PhysicalAddress(PAdrM), .TLBMiss(DTLBMissM), .PMPCacheMiss(PMPCacheMissM), .Cacheable(CacheableM), .Idempotent(), .SelTIM(SelDTIM), 
       .InstrAccessFaultF(), .LoadAccessFaultM(LSULoadAccessFaultM), 
       .StoreAmoAccessFaultM(LSUStoreAmoAccessFaultM), .InstrPageFaultF(), .LoadPageFaultM(LSULoadPageFaultM), 
     .StoreAmoPageFaultM(LSUStoreAmoPageFaultM),
@@ -255,7 +263,7 @@ module lsu import cvw::*;  #(parameter cvw_t P) (
       .PMPCFG_ARRAY_REGW, .PMPADDR_ARRAY_REGW);
 
   end else begin  // No MMU, so no PMA/page faults and no address translation
-    assign {DTLBMissM, LSULoadAccessFaultM, LSUStoreAmoAccessFaultM, LoadMisalignedFaultM, StoreAmoMisalignedFaultM} = '0;
+    assign {DTLBMissM, PMPCacheMissM, LSULoadAccessFaultM, LSUStoreAmoAccessFaultM, LoadMisalignedFaultM, StoreAmoMisalignedFaultM} = '0;
     assign {LSULoadPageFaultM, LSUStoreAmoPageFaultM} = '0;
     assign PAdrM = IHAdrM[P.PA_BITS-1:0];
     assign CacheableM = 1'b1;
@@ -271,9 +279,10 @@ module lsu import cvw::*;  #(parameter cvw_t P) (
   // 4. Cache and bus
   /////////////////////////////////////////////////////////////////////////////////////////////
 
-  // Pause IEU memory request if TLB miss.  After TLB fill, replay request.
+  // Pause IEU memory request if TLB or PMP cache miss.  After the fill, replay request.
   // Discard memory request on pipeline flush
-  assign IgnoreRequest = IgnoreRequestTLB | FlushW;
+  assign IgnoreRequestMMU = IgnoreRequestTLB | PMPCacheMissM;
+  assign IgnoreRequest = IgnoreRequestMMU | FlushW;
   
   if (P.DTIM_SUPPORTED) begin : dtim
     logic [P.PA_BITS-1:0] DTIMAdr;
@@ -281,7 +290,7 @@ module lsu import cvw::*;  #(parameter cvw_t P) (
     
     // The DTIM uses untranslated addresses, so it is not compatible with virtual memory.
     mux2 #(P.PA_BITS) DTIMAdrMux(IEUAdrExtE[P.PA_BITS-1:0], IEUAdrExtM[P.PA_BITS-1:0], MemRWM[0], DTIMAdr);
-    assign DTIMMemRWM = SelDTIM & ~IgnoreRequestTLB ? LSURWM : '0;
+    assign DTIMMemRWM = SelDTIM & ~IgnoreRequestMMU ? LSURWM : '0;
     // **** fix ReadDataWordM to be LLEN. ByteMask is wrong length.
     // **** create config to support DTIM with floating point.
     // Add support for cboz
@@ -331,10 +340,11 @@ module lsu import cvw::*;  #(parameter cvw_t P) (
       assign FlushDCache = FlushDCacheM & ~(SelHPTW);
       
       cache #(.P(P), .PA_BITS(P.PA_BITS), .XLEN(P.XLEN), .LINELEN(P.DCACHE_LINELENINBITS), .NUMLINES(P.DCACHE_WAYSIZEINBYTES*8/LINELEN),
-              .NUMWAYS(P.DCACHE_NUMWAYS), .LOGBWPL(LLENLOGBWPL), .WORDLEN(CACHEWORDLEN), .MUXINTERVAL(P.LLEN), .READ_ONLY_CACHE(0)) dcache(
-        .clk, .reset, .Stall(GatedStallW & ~SelSpillE), .SelBusBeat, .FlushStage(FlushW | IgnoreRequestTLB),
+              .NUMWAYS(P.DCACHE_NUMWAYS), .LOGBWPL(LLENLOGBWPL), .WORDLEN(CACHEWORDLEN), .MUXINTERVAL(P.LLEN), .READ_ONLY_CACHE(0),
+              .REPLACEMENT(P.DCACHE_REPLACEMENT), .SECTORS(P.DCACHE_SECTORS)) dcache(
+        .clk, .reset, .Stall(GatedStallW & ~SelSpillE), .SelBusBeat, .FlushStage(FlushW | IgnoreRequestMMU),
         .CacheRW(SelStoreDelay ? 2'b00 : CacheRWM), 
-        .FlushCache(FlushDCache), .NextSet(IEUAdrExtE[11:0]), .PAdr(PAdrM), 
+        .FlushCache(FlushDCache), .NextSet(IEUAdrExtE[11:0]), .PAdr(PAdrM), .SkipRead(1'b0),
         .ByteMask(ByteMaskSpillM), .BeatCount(BeatCount[AHBWLOGBWPL-1:AHBWLOGBWPL-LLENLOGBWPL]),
         .CacheWriteData(LSUWriteDataSpillM), .SelHPTW,
         .CacheStall, .CacheMiss(DCacheMiss), .CacheAccess(DCacheAccess),
@@ -343,11 +353,12 @@ module lsu import cvw::*;  #(parameter cvw_t P) (
         .FetchBuffer, .CacheBusRW(CacheBusRWTemp), 
         .CacheBusAck(DCacheBusAck), .InvalidateCache(1'b0), .CMOpM(CacheCMOpM));
 
-      assign DCacheStallM = CacheStall & ~IgnoreRequestTLB;
+      assign DCacheStallM = CacheStall & ~IgnoreRequestMMU;
       assign CacheBusRW = CacheBusRWTemp;
 
-      ahbcacheinterface #(.P(P), .BEATSPERLINE(BEATSPERLINE), .AHBWLOGBWPL(AHBWLOGBWPL), .LINELEN(LINELEN),  .LLENPOVERAHBW(LLENPOVERAHBW), .READ_ONLY_CACHE(0)) ahbcacheinterface(
-        .HCLK(clk), .HRESETn(~reset), .Flush(FlushW | IgnoreRequestTLB),
+      ahbcacheinterface #(.P(P), .BEATSPERLINE(BEATSPERLINE), .AHBWLOGBWPL(AHBWLOGBWPL), .LINELEN(LINELEN),  .LLENPOVERAHBW(LLENPOVERAHBW), .READ_ONLY_CACHE(0),
+        .SECTORS(P.DCACHE_SECTORS)) ahbcacheinterface(
+        .HCLK(clk), .HRESETn(~reset), .Flush(FlushW | IgnoreRequestMMU),
         .HRDATA, .HWDATA(LSUHWDATA), .HWSTRB(LSUHWSTRB),
         .HSIZE(LSUHSIZE), .HBURST(LSUHBURST), .HTRANS(LSUHTRANS), .HWRITE(LSUHWRITE), .HREADY(LSUHREADY),
         .BeatCount, .SelBusBeat, .CacheReadDataWordM(DCacheReadDataWordM[P.LLEN-1:0]), .WriteDataM(LSUWriteDataM),
@@ -367,7 +378,7 @@ module lsu import cvw::*;  #(parameter cvw_t P) (
     end else begin : passthrough // No Cache, use simple ahbinterface instad of ahbcacheinterface
       logic [1:0] BusRW;                    // Non-DTIM memory access, ignore cacheableM
       logic [P.XLEN-1:0] FetchBuffer;
-      assign BusRW = ~IgnoreRequestTLB & ~SelDTIM ? LSURWM : '0;
+      assign BusRW = ~IgnoreRequestMMU & ~SelDTIM ? LSURWM : '0;
       
       assign LSUHADDR = PAdrM;
       assign LSUHSIZE = LSUFunct3M;
@@ -391,7 +402,7 @@ module lsu import cvw::*;  #(parameter cvw_t P) (
     assign {DCacheStallM, DCacheCommittedM} = '0;
   end
 
-  assign LSUBusStallM = BusStall & ~IgnoreRequestTLB;
+  assign LSUBusStallM = BusStall & ~IgnoreRequestMMU;
   
   /////////////////////////////////////////////////////////////////////////////////////////////
   // Atomic operations
@@ -419,6 +430,11 @@ module lsu import cvw::*;  #(parameter cvw_t P) (
   
   subwordread #(P.LLEN) subwordread(.ReadDataWordMuxM(LittleEndianReadDataWordM), .PAdrM(PAdrM[2:0]), .BigEndianM,
     .FpLoadStoreM, .Funct3M(LSUFunct3M), .ReadDataM);
+
+  // XLEN-sized loads need no extension, so their data bypasses subwordread for early forwarding
+  if (P.LLEN == P.XLEN) assign LoadFwdDataM = LittleEndianReadDataWordM;
+  else mux2 #(P.XLEN) loadfwdmux(LittleEndianReadDataWordM[P.XLEN-1:0], LittleEndianReadDataWordM[2*P.XLEN-1:P.XLEN], 
+                                 PAdrM[2] ^ BigEndianM, LoadFwdDataM);
   subwordwrite #(P.LLEN) subwordwrite(.LSUFunct3M, .IMAFWriteDataM, .LittleEndianWriteDataM);
 
   // Compute byte masks
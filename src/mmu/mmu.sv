@@ -44,9 +44,15 @@ module mmu import cvw::*;  #(parameter cvw_t P,
   input  logic [P.XLEN-1:0]    PTE,                // page table entry
   input  logic [1:0]           PageTypeWriteVal,   // page type
   input  logic                 TLBWrite,           // write TLB entry
-  input  logic                 TLBFlush,           // Invalidate all TLB entries
+  input  logic                 TLBFlush,           // Invalidate TLB entries
+  input  logic                 TLBFlushByVA,       // Only invalidate entries translating TLBFlushVAdr
+  input  logic                 TLBFlushByASID,     // Only invalidate non-global entries of address space TLBFlushASID
+  input  logic [P.XLEN-1:0]    TLBFlushVAdr,       // Virtual address to invalidate
+  input  logic [P.ASID_BITS-1:0] TLBFlushASID,     // Address space to invalidate
+  input  logic                 WritePMPM,          // PMP CSR written; invalidate cached PMP permissions
   output logic [P.PA_BITS-1:0] PhysicalAddress,    // PAdr when no translation, or translated VAdr (TLBPAdr) when there is translation
   output logic                 TLBMiss,            // Miss TLB
+  output logic                 PMPCacheMiss,       // PMP and PMA checks of the address are not cached yet; stall the access
   output logic                 Cacheable,          // PMA indicates memory address is cachable
   output logic                 Idempotent,         // PMA indicates memory address is idempotent
   output logic                 SelTIM,             // Select a tightly integrated memory
@@ -77,6 +83,11 @@ module mmu import cvw::*;  #(parameter cvw_t P,
   logic [1:0]                  PBMemoryType;             // PBMT field of PTE during TLB hit, or 00 otherwise
   logic                        AmoMisalignedCausesAccessFaultM; // Misaligned AMO is not handled by hardware even with ZICCLSM, so it throws an access fault instead of misaligned with ZICCLSM
   logic                        AmoAccessM;               // AMO access detected when ReadAccessM and WriteAccessM are simultaneously asserted
+  logic                        TLBPMPHit;                // TLB hit holds a PMP record
+  logic [16:0]                 TLBPMPRecord;             // {L, X, W, R, PMA regions 13:1} held in the TLB
+  logic                        TLBPMPWrite;              // store the PMP record in the TLB entry that hit
+  logic [16:0]                 PMPFillRecord;            // PMP record computed by the PMP cache
+  logic [16:0]                 PMPRecord;                // {L, X, W, R, PMA regions 13:1} of the access from the PMP cache
   
   // only instantiate TLB if Virtual Memory is supported
   if (P.VIRTMEM_SUPPORTED) begin:tlb
@@ -90,14 +101,16 @@ module mmu import cvw::*;  #(parameter cvw_t P,
           .VAdr(VAdr[P.XLEN-1:0]), .STATUS_MXR, .STATUS_SUM, .STATUS_MPRV, .STATUS_MPP, .ENVCFG_PBMTE, .ENVCFG_ADUE,
           .PrivilegeModeW, .ReadAccess, .WriteAccess, .CMOpM,
           .DisableTranslation, .PTE, .PageTypeWriteVal,
-          .TLBWrite, .TLBFlush, .TLBPAdr, .TLBMiss, .TLBHit, 
-          .Translate, .TLBPageFault, .UpdateDA, .PBMemoryType);
+          .TLBWrite, .TLBFlush, .TLBFlushByVA, .TLBFlushByASID, .TLBFlushVAdr, .TLBFlushASID, .PMPFlush(WritePMPM), .PMPWrite(TLBPMPWrite), .PMPWriteVal(PMPFillRecord), .TLBPAdr, .TLBMiss, .TLBHit, 
+          .Translate, .TLBPageFault, .UpdateDA, .PBMemoryType, .TLBPMPHit, .TLBPMPRecord);
   end else begin:tlb // just pass address through as physical
     assign Translate    = 0;
     assign TLBMiss      = 0;
     assign TLBHit       = 1; // *** is this necessary
     assign TLBPageFault = 0;
     assign PBMemoryType = 2'b00;
+    assign TLBPMPHit    = 0;
+    assign TLBPMPRecord = 0;
   end
 
   // If translation is occuring, select translated physical address from TLB
@@ -110,15 +123,33 @@ module mmu import cvw::*;  #(parameter cvw_t P,
   // Check physical memory accesses
   ///////////////////////////////////////////
 
+  if (P.PMPCACHE_SUPPORTED) begin : pmpcache
+    // The PMP permissions and PMA regions of the address come from the TLB entry that hit or a
+    // one-entry cache.  On a miss the access stalls while the PMP and PMA decoders fill the cache,
+    // so the decoders are a multicycle path.  PMP CSR writes and sfence.vma flush all records.
+    logic Check;  // access needs its PMP and PMA checks
+    assign Check = (ExecuteAccessF | ReadAccessM | WriteAccessM | (|CMOpM)) & ~TLBMiss;
+    pmpcache #(P) pmpcache(.clk, .reset, .PhysicalAddress, .Check, .Translate, .TLBPMPHit, .TLBPMPRecord, 
+      .Flush(WritePMPM | TLBFlush), .PMPCFG_ARRAY_REGW, .PMPADDR_ARRAY_REGW,
+      .PMPCacheMiss, .PMPRecord, .TLBPMPWrite, .FillRecord(PMPFillRecord));
+  end else begin
+    assign PMPCacheMiss  = 0;
+    assign PMPRecord     = 0;
+    assign TLBPMPWrite   = 0;
+    assign PMPFillRecord = 0;
+  end
+
   pmachecker #(P) pmachecker(.PhysicalAddress, .Size, .CMOpM, 
-    .AtomicAccessM, .ExecuteAccessF, .WriteAccessM, .ReadAccessM, .PBMemoryType,
+    .AtomicAccessM, .ExecuteAccessF, .WriteAccessM, .ReadAccessM, .PBMemoryType, .CachedRegions(PMPRecord[12:0]),
     .Cacheable, .Idempotent, .SelTIM, 
     .PMAInstrAccessFaultF, .PMALoadAccessFaultM, .PMAStoreAmoAccessFaultM);
  
   if (P.PMP_ENTRIES > 0) begin : pmp
-    pmpchecker #(P) pmpchecker(.PhysicalAddress, .PrivilegeModeW,
-      .PMPCFG_ARRAY_REGW, .PMPADDR_ARRAY_REGW,
-      .ExecuteAccessF, .WriteAccessM, .ReadAccessM, .CMOpM, 
+    logic [3:0] PMPPerm; // {L, X, W, R} of the first PMP region matching the address
+    if (P.PMPCACHE_SUPPORTED) assign PMPPerm = PMPRecord[16:13]; // the PMP cache decoded the address ahead of time
+    else pmpmatch #(P) pmpmatch(.PhysicalAddress, .PMPCFG_ARRAY_REGW, .PMPADDR_ARRAY_REGW, .PMPPerm);
+    pmpchecker #(P) pmpchecker(.PrivilegeModeW, .PMPPerm,
+      .ExecuteAccessF, .WriteAccessM, .ReadAccessM, .CMOpM,
       .PMPInstrAccessFaultF, .PMPLoadAccessFaultM, .PMPStoreAmoAccessFaultM);
   end else begin
     assign PMPInstrAccessFaultF     = 0;
@@ -138,18 +169,19 @@ module mmu import cvw::*;  #(parameter cvw_t P,
       2'b11:  DataMisalignedM = |VAdr[2:0];        // ld, sd, fld, fsd
     endcase 
   // When ZiCCLSM_SUPPORTED, misalgined cachable loads and stores are handled in hardware so they do not throw a misaligned fault
-  assign LoadMisalignedFaultM     = DataMisalignedM & ReadNoAmoAccessM & ~(P.ZICCLSM_SUPPORTED & Cacheable); 
-  assign StoreAmoMisalignedFaultM = DataMisalignedM & WriteAccessM & ~(P.ZICCLSM_SUPPORTED & Cacheable); // Store and AMO both assert WriteAccess
+  // Cacheable is not known until the PMP cache has the address
+  assign LoadMisalignedFaultM     = DataMisalignedM & ReadNoAmoAccessM & ~(P.ZICCLSM_SUPPORTED & Cacheable) & ~PMPCacheMiss; 
+  assign StoreAmoMisalignedFaultM = DataMisalignedM & WriteAccessM & ~(P.ZICCLSM_SUPPORTED & Cacheable) & ~PMPCacheMiss; // Store and AMO both assert WriteAccess
 
   // Access faults
-  // If TLB miss and translating we want to not have faults from the PMA and PMP checkers.
-  assign InstrAccessFaultF    = (PMAInstrAccessFaultF    | PMPInstrAccessFaultF)    & ~TLBMiss;
-  assign LoadAccessFaultM     = (PMALoadAccessFaultM     | PMPLoadAccessFaultM)     & ~TLBMiss;
+  // If TLB miss and translating, or the checks are still being filled, we want to not have faults from the PMA and PMP checkers.
+  assign InstrAccessFaultF    = (PMAInstrAccessFaultF    | PMPInstrAccessFaultF)    & ~TLBMiss & ~PMPCacheMiss;
+  assign LoadAccessFaultM     = (PMALoadAccessFaultM     | PMPLoadAccessFaultM)     & ~TLBMiss & ~PMPCacheMiss;
   // a misaligned AMO causes an access fault rather than a misaligned fault if a misaligned load/store is handled in hardware
   // this is subtle - see privileged spec 3.6.3.3
   // AMO is detected as ReadAccess & WriteAccess
   assign AmoMisalignedCausesAccessFaultM = DataMisalignedM & AmoAccessM & (P.ZICCLSM_SUPPORTED & Cacheable);
-  assign StoreAmoAccessFaultM = (PMAStoreAmoAccessFaultM | PMPStoreAmoAccessFaultM | AmoMisalignedCausesAccessFaultM) & ~TLBMiss;
+  assign StoreAmoAccessFaultM = (PMAStoreAmoAccessFaultM | PMPStoreAmoAccessFaultM | AmoMisalignedCausesAccessFaultM) & ~TLBMiss & ~PMPCacheMiss;
 
   // Specify which type of page fault is occurring
   assign InstrPageFaultF    = TLBPageFault & ExecuteAccessF;
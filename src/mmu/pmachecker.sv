@@ -38,6 +38,7 @@ module pmachecker import cvw::*;  #(parameter cvw_t P) (
   input  logic                 WriteAccessM,   // Write access 
   input  logic                 ReadAccessM,    // Read access
   input  logic [1:0]           PBMemoryType,     // PBMT field of PTE during TLB hit, or 00 otherwise
+  input  logic [13:1]          CachedRegions,    // regions holding the address from the PMP cache when PMPCACHE_SUPPORTED
   output logic                 Cacheable, Idempotent, SelTIM,
   output logic                 PMAInstrAccessFaultF,
   output logic                 PMALoadAccessFaultM,
@@ -46,7 +47,7 @@ module pmachecker import cvw::*;  #(parameter cvw_t P) (
 
   logic                        PMAAccessFault;
   logic                        AccessRW, AccessRWXC, AccessRX;
-  logic [11:0]                 SelRegions;
+  logic [13:0]                 SelRegions;
   logic                        AtomicAllowed;
   logic                        CacheableRegion, IdempotentRegion;
 
@@ -56,7 +57,23 @@ module pmachecker import cvw::*;  #(parameter cvw_t P) (
   assign AccessRX  = ReadAccessM | ExecuteAccessF;
 
   // Determine which region of physical memory (if any) is being accessed
-  adrdecs #(P) adrdecs(PhysicalAddress, AccessRW, AccessRX, AccessRWXC, Size, SelRegions);
+  if (P.PMPCACHE_SUPPORTED) begin: cached 
+    // The PMP cache already matched the address; apply the access type and size checks of adrdecs
+    localparam logic [3:0]     SUPPORTED_SIZE = (P.LLEN == 32 ? 4'b0111 : 4'b1111);
+    logic [13:1]               AccessValid;
+    logic [3:0]                SizeMask [13:1];
+
+    assign AccessValid = {AccessRW, AccessRW, AccessRW, AccessRW, AccessRW, AccessRW, AccessRW, AccessRW, 
+                          AccessRWXC, AccessRX, AccessRWXC, AccessRX, AccessRW};
+    assign SizeMask = '{4'b0100, 4'b0100, 4'b0100, SUPPORTED_SIZE & 4'b1100, 4'b0100, 4'b0001, 4'b0100, SUPPORTED_SIZE,
+                        SUPPORTED_SIZE, SUPPORTED_SIZE, SUPPORTED_SIZE, SUPPORTED_SIZE, SUPPORTED_SIZE};
+    genvar i;
+    for (i = 1; i <= 13; i++)
+      assign SelRegions[i] = CachedRegions[i] & AccessValid[i] & SizeMask[i][Size];
+    assign SelRegions[0] = ~|(SelRegions[13:1]); // none of the regions are selected
+  end else begin: uncached
+    adrdecs #(P) adrdecs(PhysicalAddress, AccessRW, AccessRX, AccessRWXC, Size, SelRegions);
+  end
 
   // Only non-core RAM/ROM memory regions are cacheable. PBMT can override cachable; NC and IO are uncachable
   assign CacheableRegion = SelRegions[3] | SelRegions[4] | SelRegions[5];  // exclusion-tag: unused-cachable
@@ -0,0 +1,67 @@
+///////////////////////////////////////////
+// pmapage.sv
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified:
+//
+// Purpose: Finds the physical memory regions holding a physical address to fill the PMP cache,
+//          and whether the match applies to the entire 4 KiB page holding it.  It does unless a
+//          region smaller than a page lies in the page.  The access type and size checks of
+//          adrdecs depend on the access, so they are left to the pmachecker.
+//
+// Documentation: RISC-V System on Chip Design Chapter 8
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+//
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied. See the License for the specific language governing permissions
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+module pmapage import cvw::*;  #(parameter cvw_t P) (
+  input  logic [P.PA_BITS-1:0] Adr,          // physical address being filled
+  output logic [13:1]          RegionMatch,  // Adr lies in region i, numbered as SelRegions in adrdecs
+  output logic                 PageUniform   // every byte of the page lies in the same regions
+);
+
+  logic [P.PA_BITS-1:0]        Base  [13:1];
+  logic [P.PA_BITS-1:0]        Range [13:1];
+  logic [13:1]                 Supported;
+  logic [13:1]                 SmallInPage;  // region i is smaller than a page and lies in the page
+
+  // Regions in the order of adrdecs
+  assign Base  = '{P.ETH_BASE[P.PA_BITS-1:0], P.TRACE_BASE[P.PA_BITS-1:0], P.SPI_BASE[P.PA_BITS-1:0], P.SDC_BASE[P.PA_BITS-1:0],
+                   P.PLIC_BASE[P.PA_BITS-1:0], P.UART_BASE[P.PA_BITS-1:0], P.GPIO_BASE[P.PA_BITS-1:0], P.CLINT_BASE[P.PA_BITS-1:0],
+                   P.UNCORE_RAM_BASE[P.PA_BITS-1:0], P.BOOTROM_BASE[P.PA_BITS-1:0], P.EXT_MEM_BASE[P.PA_BITS-1:0],
+                   P.IROM_BASE[P.PA_BITS-1:0], P.DTIM_BASE[P.PA_BITS-1:0]};
+  assign Range = '{P.ETH_RANGE[P.PA_BITS-1:0], P.TRACE_RANGE[P.PA_BITS-1:0], P.SPI_RANGE[P.PA_BITS-1:0], P.SDC_RANGE[P.PA_BITS-1:0],
+                   P.PLIC_RANGE[P.PA_BITS-1:0], P.UART_RANGE[P.PA_BITS-1:0], P.GPIO_RANGE[P.PA_BITS-1:0], P.CLINT_RANGE[P.PA_BITS-1:0],
+                   P.UNCORE_RAM_RANGE[P.PA_BITS-1:0], P.BOOTROM_RANGE[P.PA_BITS-1:0], P.EXT_MEM_RANGE[P.PA_BITS-1:0],
+                   P.IROM_RANGE[P.PA_BITS-1:0], P.DTIM_RANGE[P.PA_BITS-1:0]};
+  assign Supported = {P.ETH_SUPPORTED, P.TRACE_SUPPORTED, P.SPI_SUPPORTED, P.SDC_SUPPORTED, P.PLIC_SUPPORTED, P.UART_SUPPORTED,
+                      P.GPIO_SUPPORTED, P.CLINT_SUPPORTED, P.UNCORE_RAM_SUPPORTED, P.BOOTROM_SUPPORTED, P.EXT_MEM_SUPPORTED,
+                      P.IROM_SUPPORTED, P.DTIM_SUPPORTED};
+
+  // Match the address alone; any access type and size is accepted here
+  genvar i;
+  for (i = 1; i <= 13; i++) begin : region
+    adrdec #(P.PA_BITS) regiondec(Adr, Base[i], Range[i], Supported[i], 1'b1, 2'b00, 4'b0001, RegionMatch[i]);
+    // Regions are naturally aligned, so one of at least a page never ends inside a page
+    assign SmallInPage[i] = Supported[i] & ~(&Range[i][11:0]) & (Base[i][P.PA_BITS-1:12] == Adr[P.PA_BITS-1:12]);
+  end
+
+  assign PageUniform = ~|SmallInPage;
+endmodule
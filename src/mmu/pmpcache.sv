@@ -0,0 +1,117 @@
+///////////////////////////////////////////
+// pmpcache.sv
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified:
+//
+// Purpose: Supplies the PMP permissions and PMA regions of a physical address from the TLB or a
+//          one-entry cache, so the PMP and PMA decoders are off the single-cycle access path.
+//          On a miss, the access stalls while the decoders work on the registered address for
+//          two cycles.  The result fills the cache and, for a 4 KiB page with uniform
+//          permissions, the TLB entry that hit.  A cache entry covers the whole page when the
+//          permissions are uniform across it, or else only the word holding the address.
+//
+// Documentation: RISC-V System on Chip Design Chapter 8
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+//
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied. See the License for the specific language governing permissions
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+module pmpcache import cvw::*;  #(parameter cvw_t P) (
+  input  logic                     clk, reset,
+  input  logic [P.PA_BITS-1:0]     PhysicalAddress,
+  input  logic                     Check,            // access needs its permissions
+  input  logic                     Translate,        // address was translated by the TLB
+  input  logic                     TLBPMPHit,        // TLB hit on an entry holding permissions
+  input  logic [16:0]              TLBPMPRecord,     // {L, X, W, R, PMA regions 13:1} held in the hit TLB entry
+  input  logic                     Flush,            // PMP CSR written or sfence.vma; cached permissions are stale
+  input  var logic [7:0]           PMPCFG_ARRAY_REGW[P.PMP_ENTRIES-1:0],
+  input  var logic [P.PA_BITS-3:0] PMPADDR_ARRAY_REGW [P.PMP_ENTRIES-1:0],
+  output logic                     PMPCacheMiss,     // permissions are not cached; stall the access
+  output logic [16:0]              PMPRecord,        // {L, X, W, R, PMA regions 13:1} of the access
+  output logic                     TLBPMPWrite,      // store the filled record in the TLB entry that hit
+  output logic [16:0]              FillRecord        // record computed by the fill
+);
+
+  typedef enum logic [1:0] {STATE_READY, STATE_FILL, STATE_WRITE} statetype;
+
+  statetype                        CurrState, NextState;
+  logic [P.PA_BITS-1:0]            FillAdr;          // address being filled, held for the whole fill
+  logic [3:0]                      FillPerm;
+  logic [13:1]                     FillRegions;
+  logic                            FillPMPUniform, FillPMAUniform, FillUniform;
+  logic                            CacheWrite;
+  logic                            EntryValid, EntryUniform, EntryHit, PMPCacheHit;
+  logic [P.PA_BITS-1:2]            EntryAdr;
+  logic [16:0]                     EntryRecord;
+
+  ///////////////////////////////////////////
+  // Fill
+  ///////////////////////////////////////////
+
+  // The decoders only see FillAdr and the PMP CSRs, which hold still from STATE_FILL through
+  // STATE_WRITE, giving them two cycles.  A PMP CSR write or sfence.vma abandons the fill.
+  always_ff @(posedge clk)
+    if (reset | Flush) CurrState <= #1 STATE_READY;
+    else               CurrState <= #1 NextState;
+
+  always_comb
+    case (CurrState)
+      STATE_READY: if (PMPCacheMiss) NextState = STATE_FILL;
+                   else              NextState = STATE_READY;
+      STATE_FILL:                    NextState = STATE_WRITE;
+      default:                       NextState = STATE_READY; // STATE_WRITE
+    endcase
+
+  flopen #(P.PA_BITS) filladrreg(clk, CurrState == STATE_READY, PhysicalAddress, FillAdr);
+
+  if (P.PMP_ENTRIES > 0) begin : pmp
+    pmppage #(P) pmppage(.Adr(FillAdr), .PMPCFG_ARRAY_REGW, .PMPADDR_ARRAY_REGW, .Perm(FillPerm), .PageUniform(FillPMPUniform));
+  end else begin
+    assign FillPerm = '0;
+    assign FillPMPUniform = 1'b1;
+  end
+  pmapage #(P) pmapage(.Adr(FillAdr), .RegionMatch(FillRegions), .PageUniform(FillPMAUniform));
+
+  assign FillRecord = {FillPerm, FillRegions};
+  assign FillUniform = FillPMPUniform & FillPMAUniform;
+  assign CacheWrite = (CurrState == STATE_WRITE);
+
+  // The TLB entry may only take the record if the access still translates to the filled page
+  assign TLBPMPWrite = CacheWrite & ~Flush & Translate & FillUniform & (PhysicalAddress[P.PA_BITS-1:12] == FillAdr[P.PA_BITS-1:12]);
+
+  ///////////////////////////////////////////
+  // One-entry cache, tagged by page or by word when the page is not uniform
+  ///////////////////////////////////////////
+
+  flopenr #(1) entryvalidreg(clk, reset, CacheWrite | Flush, ~Flush, EntryValid);
+  flopenr #(P.PA_BITS+16) entryreg(clk, reset, CacheWrite, {FillAdr[P.PA_BITS-1:2], FillUniform, FillRecord},
+    {EntryAdr, EntryUniform, EntryRecord});
+
+  assign EntryHit = EntryValid & (EntryAdr[P.PA_BITS-1:12] == PhysicalAddress[P.PA_BITS-1:12]) &
+                    (EntryUniform | (EntryAdr[11:2] == PhysicalAddress[11:2]));
+
+  ///////////////////////////////////////////
+  // Lookup
+  ///////////////////////////////////////////
+
+  assign PMPCacheHit = Translate & TLBPMPHit | EntryHit;
+  assign PMPCacheMiss = Check & ~PMPCacheHit;
+  mux2 #(17) recordmux(EntryRecord, TLBPMPRecord, Translate & TLBPMPHit, PMPRecord);
+endmodule
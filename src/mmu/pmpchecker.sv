@@ -31,17 +31,8 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 module pmpchecker import cvw::*;  #(parameter cvw_t P) (
-  input  logic [P.PA_BITS-1:0]     PhysicalAddress,  
   input  logic [1:0]               PrivilegeModeW,
-  // ModelSim has a switch -svinputport which controls whether input ports
-  // are nets (wires) or vars by default. The default setting of this switch is
-  // `relaxed`, which means that signals are nets if and only if they are
-  // scalars or one-dimensional vectors. Since this is a two-dimensional vector,
-  // this will be understood as a var. However, if we don't supply the `var`
-  // keyword, the compiler warns us that it's interpreting the signal as a var,
-  // which we might not intend.
-  input  var logic [7:0]           PMPCFG_ARRAY_REGW[P.PMP_ENTRIES-1:0],
-  input  var logic [P.PA_BITS-3:0] PMPADDR_ARRAY_REGW [P.PMP_ENTRIES-1:0],
+  input  logic [3:0]               PMPPerm,          // {L, X, W, R} of the first PMP region matching the address
   input  logic                     ExecuteAccessF, WriteAccessM, ReadAccessM,
   input  logic [3:0]               CMOpM,
   output logic                     PMPInstrAccessFaultF,
@@ -49,35 +40,20 @@ module pmpchecker import cvw::*;  #(parameter cvw_t P) (
   output logic                     PMPStoreAmoAccessFaultM
 );
 
-  // Bit i is high when the address falls in PMP region i
   logic                            EnforcePMP; // should PMP be checked in this privilege level
-  logic [P.PMP_ENTRIES-1:0]        Match;      // physical address matches one of the pmp ranges
-  logic [P.PMP_ENTRIES-1:0]        FirstMatch; // onehot encoding for the first pmpaddr to match the current address.
-  logic [P.PMP_ENTRIES-1:0]        L, X, W, R; // PMP matches and has flag set
-  logic [P.PMP_ENTRIES-1:0]        PAgePMPAdr; // for TOR PMP matching, PhysicalAddress > PMPAdr[i]
+  logic                            MatchL, MatchX, MatchW, MatchR; // flags of the first matching region
   logic                            PMPCMOAccessFault, PMPCBOMAccessFault, PMPCBOZAccessFault;
   
-
-  if (P.PMP_ENTRIES > 0) begin: pmp // prevent complaints about array of no elements when PMP_ENTRIES = 0
-    pmpadrdec #(P) pmpadrdecs[P.PMP_ENTRIES-1:0](
-      .PhysicalAddress, 
-      .PMPCfg(PMPCFG_ARRAY_REGW),
-      .PMPAdr(PMPADDR_ARRAY_REGW),
-      .PAgePMPAdrIn({PAgePMPAdr[P.PMP_ENTRIES-2:0], 1'b1}),
-      .PAgePMPAdrOut(PAgePMPAdr),
-      .Match, .L, .X, .W, .R);
-  end
-
-  priorityonehot #(P.PMP_ENTRIES) pmppriority(.a(Match), .y(FirstMatch)); // combine the match signal from all the adress decoders to find the first one that matches.
+  assign {MatchL, MatchX, MatchW, MatchR} = PMPPerm;
 
   // Only enforce PMP checking for S and U modes or in Machine mode when L bit is set in selected region
-  assign EnforcePMP = (PrivilegeModeW != P.M_MODE) | (|(L & FirstMatch));
+  assign EnforcePMP = (PrivilegeModeW != P.M_MODE) | MatchL;
 
-  assign PMPCBOMAccessFault     = EnforcePMP & (|CMOpM[2:0]) & ~|((R|W) & FirstMatch) ; // exclusion-tag: immu-pmpcbom
-  assign PMPCBOZAccessFault     = EnforcePMP & CMOpM[3] & ~|(W & FirstMatch) ;          // exclusion-tag: immu-pmpcboz
-  assign PMPCMOAccessFault      = PMPCBOZAccessFault | PMPCBOMAccessFault;              // exclusion-tag: immu-pmpcboaccess
+  assign PMPCBOMAccessFault     = EnforcePMP & (|CMOpM[2:0]) & ~(MatchR | MatchW) ; // exclusion-tag: immu-pmpcbom
+  assign PMPCBOZAccessFault     = EnforcePMP & CMOpM[3] & ~MatchW ;                 // exclusion-tag: immu-pmpcboz
+  assign PMPCMOAccessFault      = PMPCBOZAccessFault | PMPCBOMAccessFault;          // exclusion-tag: immu-pmpcboaccess
   
-  assign PMPInstrAccessFaultF     = EnforcePMP & ExecuteAccessF & ~|(X & FirstMatch) ;
-  assign PMPStoreAmoAccessFaultM  = (EnforcePMP & WriteAccessM   & ~|(W & FirstMatch))  | PMPCMOAccessFault; // exclusion-tag: immu-pmpstoreamoaccessfault
-  assign PMPLoadAccessFaultM      = EnforcePMP & ReadAccessM    & ~|(R & FirstMatch) ;
+  assign PMPInstrAccessFaultF     = EnforcePMP & ExecuteAccessF & ~MatchX ;
+  assign PMPStoreAmoAccessFaultM  = (EnforcePMP & WriteAccessM   & ~MatchW)  | PMPCMOAccessFault; // exclusion-tag: immu-pmpstoreamoaccessfault
+  assign PMPLoadAccessFaultM      = EnforcePMP & ReadAccessM    & ~MatchR ;
  endmodule
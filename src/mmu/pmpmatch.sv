@@ -0,0 +1,62 @@
+///////////////////////////////////////////
+// pmpmatch.sv
+//
+// Written: tfleming@hmc.edu & jtorrey@hmc.edu 28 April 2021
+// Modified: 19 October 2026 moved out of pmpchecker so the PMP cache can share it
+//
+// Purpose: Finds the highest priority PMP region matching a physical address and
+//          returns its lock and permission flags.
+// 
+// Documentation: RISC-V System on Chip Design Chapter 8
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+// 
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file 
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You 
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the 
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, 
+// either express or implied. See the License for the specific language governing permissions 
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+module pmpmatch import cvw::*;  #(parameter cvw_t P) (
+  input  logic [P.PA_BITS-1:0]     PhysicalAddress,  
+  // ModelSim has a switch -svinputport which controls whether input ports
+  // are nets (wires) or vars by default. The default setting of this switch is
+  // `relaxed`, which means that signals are nets if and only if they are
+  // scalars or one-dimensional vectors. Since this is a two-dimensional vector,
+  // this will be understood as a var. However, if we don't supply the `var`
+  // keyword, the compiler warns us that it's interpreting the signal as a var,
+  // which we might not intend.
+  input  var logic [7:0]           PMPCFG_ARRAY_REGW[P.PMP_ENTRIES-1:0],
+  input  var logic [P.PA_BITS-3:0] PMPADDR_ARRAY_REGW [P.PMP_ENTRIES-1:0],
+  output logic [3:0]               PMPPerm           // {L, X, W, R} of the first matching region
+);
+
+  // Bit i is high when the address falls in PMP region i
+  logic [P.PMP_ENTRIES-1:0]        Match;      // physical address matches one of the pmp ranges
+  logic [P.PMP_ENTRIES-1:0]        FirstMatch; // onehot encoding for the first pmpaddr to match the current address.
+  logic [P.PMP_ENTRIES-1:0]        L, X, W, R; // PMP matches and has flag set
+  logic [P.PMP_ENTRIES-1:0]        PAgePMPAdr; // for TOR PMP matching, PhysicalAddress > PMPAdr[i]
+
+  pmpadrdec #(P) pmpadrdecs[P.PMP_ENTRIES-1:0](
+    .PhysicalAddress, 
+    .PMPCfg(PMPCFG_ARRAY_REGW),
+    .PMPAdr(PMPADDR_ARRAY_REGW),
+    .PAgePMPAdrIn({PAgePMPAdr[P.PMP_ENTRIES-2:0], 1'b1}),
+    .PAgePMPAdrOut(PAgePMPAdr),
+    .Match, .L, .X, .W, .R);
+
+  priorityonehot #(P.PMP_ENTRIES) pmppriority(.a(Match), .y(FirstMatch)); // combine the match signal from all the adress decoders to find the first one that matches.
+
+  assign PMPPerm = {|(L & FirstMatch), |(X & FirstMatch), |(W & FirstMatch), |(R & FirstMatch)};
+endmodule
@@ -0,0 +1,69 @@
+///////////////////////////////////////////
+// pmppage.sv
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Modified: 
+//
+// Purpose: Computes the PMP permissions of a physical address to fill the PMP cache, and
+//          whether they apply to the entire 4 KiB page holding it.  They do unless a PMP
+//          region boundary falls strictly inside the page.  The inputs are held for the
+//          whole fill, so this is a multicycle path.
+// 
+// Documentation: RISC-V System on Chip Design Chapter 8
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+// 
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file 
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You 
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the 
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, 
+// either express or implied. See the License for the specific language governing permissions 
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+module pmppage import cvw::*;  #(parameter cvw_t P) (
+  input  logic [P.PA_BITS-1:0]     Adr,              // physical address being filled
+  input  var logic [7:0]           PMPCFG_ARRAY_REGW[P.PMP_ENTRIES-1:0],
+  input  var logic [P.PA_BITS-3:0] PMPADDR_ARRAY_REGW [P.PMP_ENTRIES-1:0],
+  output logic [3:0]               Perm,             // {L, X, W, R} of the highest priority region matching Adr
+  output logic                     PageUniform       // every byte of the page has the same permissions
+);
+
+  // define PMP addressing mode codes
+  localparam                       TOR   = 2'b01;
+  localparam                       NA4   = 2'b10;
+  localparam                       NAPOT = 2'b11;
+
+  logic [P.PMP_ENTRIES-1:0]        SamePage;    // pmpaddr[i] lies in the page
+  logic [P.PMP_ENTRIES-1:0]        BoundInPage; // pmpaddr[i] lies in the page but not on its first byte
+  logic [P.PMP_ENTRIES-1:0]        Splits;      // region i begins or ends inside the page
+
+  pmpmatch #(P) pmpmatch(.PhysicalAddress(Adr), .PMPCFG_ARRAY_REGW, .PMPADDR_ARRAY_REGW, .PMPPerm(Perm));
+
+  // pmpaddr holds address bits PA_BITS-1:2, so bits 9:0 are the offset within a page.
+  // A TOR region is split by either of its bounds landing inside the page.  NA4 and NAPOT
+  // regions smaller than a page split any page that contains them.  Larger NAPOT regions
+  // are naturally aligned and never split a page.
+  genvar i;
+  for (i = 0; i < P.PMP_ENTRIES; i++) begin : split
+    logic [1:0] AdrMode;
+    logic       SmallNA;
+    assign AdrMode = PMPCFG_ARRAY_REGW[i][4:3];
+    assign SamePage[i] = (PMPADDR_ARRAY_REGW[i][P.PA_BITS-3:10] == Adr[P.PA_BITS-1:12]);
+    assign BoundInPage[i] = SamePage[i] & (|PMPADDR_ARRAY_REGW[i][9:0]);
+    assign SmallNA = (AdrMode == NA4) | (AdrMode == NAPOT) & ~(&PMPADDR_ARRAY_REGW[i][8:0]);
+    if (i == 0) assign Splits[i] = (AdrMode == TOR) & BoundInPage[i] | SmallNA & SamePage[i];
+    else        assign Splits[i] = (AdrMode == TOR) & (BoundInPage[i] | BoundInPage[i-1]) | SmallNA & SamePage[i];
+  end
+
+  assign PageUniform = ~|Splits;
+endmodule
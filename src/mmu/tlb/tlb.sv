@@ -70,18 +70,29 @@ module tlb import cvw::*;  #(parameter cvw_t P,
   input  logic [1:0]               PageTypeWriteVal,
   input  logic                     TLBWrite,
   input  logic                     TLBFlush,
+  input  logic                     TLBFlushByVA,     // Only invalidate entries translating TLBFlushVAdr
+  input  logic                     TLBFlushByASID,   // Only invalidate non-global entries of address space TLBFlushASID
+  input  logic [P.XLEN-1:0]        TLBFlushVAdr,
+  input  logic [P.ASID_BITS-1:0]   TLBFlushASID,
+  input  logic                     PMPFlush,         // PMP registers written; invalidate cached PMP permissions
+  input  logic                     PMPWrite,         // store PMPWriteVal in the hit entry
+  input  logic [16:0]              PMPWriteVal,      // {L, X, W, R, PMA regions 13:1} of the page, uniform across it
   output logic [P.PA_BITS-1:0]     TLBPAdr,
   output logic                     TLBMiss,
   output logic                     TLBHit,
   output logic                     Translate,
   output logic                     TLBPageFault,
   output logic                     UpdateDA,
-  output logic [1:0]               PBMemoryType     // PBMT field of PTE during TLB hit, or 00 otherwise
+  output logic [1:0]               PBMemoryType,     // PBMT field of PTE during TLB hit, or 00 otherwise
+  output logic                     TLBPMPHit,        // TLB hit on an entry holding a PMP record
+  output logic [16:0]              TLBPMPRecord      // {L, X, W, R, PMA regions 13:1} held in the hit entry
 );
 
   logic [TLB_ENTRIES-1:0]         Matches, WriteEnables, PTE_Gs, PTE_NAPOTs; // used as the one-hot encoding of WriteIndex
   // Sections of the virtual and physical addresses
   logic [P.VPN_BITS-1:0]          VPN;
+  logic [P.VPN_BITS-1:0]          CAMVPN;        // page number and address space searched in the CAM
+  logic [P.ASID_BITS-1:0]         CAMASID;
   logic [P.PPN_BITS-1:0]          PPN;
   // Sections of the page table entry
   logic [11:0]                    PTEAccessBits;
@@ -92,6 +103,8 @@ module tlb import cvw::*;  #(parameter cvw_t P,
   logic                           MegapageMisaligned;
   logic                           PTE_N;         // NAPOT page table entry
   logic                           NAPOT4;        // pte.ppn[3:0] = 1000, indicating 64 KiB continuous NAPOT region
+  logic                           PMPCacheable;  // PMP record of the hit entry may be stored
+  logic [17:0]                    PMPRecord;     // {valid, L, X, W, R, PMA regions 13:1} of the hit entry
 
   if(P.XLEN == 32) begin
     assign MegapageMisaligned = |(PPN[9:0]); // must have zero PPN0
@@ -107,6 +120,9 @@ module tlb import cvw::*;  #(parameter cvw_t P,
   end
 
   assign VPN = VAdr[P.VPN_BITS+11:12];
+  // A TLB flush searches the CAM for the entries to invalidate.  The lookup misses during the flush anyway.
+  assign CAMVPN = TLBFlush ? TLBFlushVAdr[P.VPN_BITS+11:12] : VPN;
+  assign CAMASID = TLBFlush ? TLBFlushASID : SATP_ASID;
   assign NAPOT4 = (PPN[3:0] == 4'b1000); // 64 KiB contiguous region with pte.napot_bits = 4
 
   tlbcontrol #(P, ITLB) tlbcontrol(.SATP_MODE, .VAdr, .STATUS_MXR, .STATUS_SUM, .STATUS_MPRV, .STATUS_MPP, .ENVCFG_PBMTE, .ENVCFG_ADUE,
@@ -117,9 +133,16 @@ module tlb import cvw::*;  #(parameter cvw_t P,
 
   tlblru #(TLB_ENTRIES) lru(.clk, .reset, .TLBWrite, .TLBFlush, .Matches, .TLBHit, .WriteEnables);
   tlbcam #(P, TLB_ENTRIES, P.VPN_BITS + P.ASID_BITS, P.VPN_SEGMENT_BITS) 
-  tlbcam(.clk, .reset, .VPN, .PageTypeWriteVal, .SV39Mode, .TLBFlush, .WriteEnables, .PTE_Gs, .PTE_NAPOTs,
-           .SATP_ASID, .Matches, .HitPageType, .CAMHit);
-  tlbram #(P, TLB_ENTRIES) tlbram(.clk, .reset, .PTE, .Matches, .WriteEnables, .PPN, .PTEAccessBits, .PTE_Gs, .PTE_NAPOTs);
+  tlbcam(.clk, .reset, .VPN(CAMVPN), .PageTypeWriteVal, .SV39Mode, .TLBFlush, .TLBFlushByVA, .TLBFlushByASID,
+           .WriteEnables, .PTE_Gs, .PTE_NAPOTs, .SATP_ASID(CAMASID), .Matches, .HitPageType, .CAMHit);
+  tlbram #(P, TLB_ENTRIES) tlbram(.clk, .reset, .PTE, .Matches, .WriteEnables, .PMPFlush, 
+    .PMPWriteEnables(Matches & {TLB_ENTRIES{PMPWrite & PMPCacheable}}), .PMPWriteVal, .PPN, .PMPRecord, .PTEAccessBits, .PTE_Gs, .PTE_NAPOTs);
+
+  // PMP records are only stored in entries for 4 KiB pages.  Superpages and NAPOT entries cover
+  // several physical pages, which may have different permissions.
+  assign PMPCacheable = TLBHit & (HitPageType == 2'b00) & ~PTE_N;
+  assign TLBPMPHit = TLBHit & PMPRecord[17];
+  assign TLBPMPRecord = PMPRecord[16:0];
 
   // Replace segments of the virtual page number with segments of the physical
   // page number. For 4 KB pages, the entire virtual page number is replaced.
@@ -37,6 +37,7 @@ module tlbcam  import cvw::*;  #(parameter cvw_t P,
   input  logic [1:0]              PageTypeWriteVal,
   input  logic                    SV39Mode,
   input  logic                    TLBFlush,
+  input  logic                    TLBFlushByVA, TLBFlushByASID, // flush only entries matching VPN / SATP_ASID
   input  logic [TLB_ENTRIES-1:0]  WriteEnables,
   input  logic [TLB_ENTRIES-1:0]  PTE_Gs,
   input  logic [TLB_ENTRIES-1:0]  PTE_NAPOTs,  // entry is in NAPOT mode (N bit set and PPN[3:0] = 1000)
@@ -56,7 +57,7 @@ module tlbcam  import cvw::*;  #(parameter cvw_t P,
 
   tlbcamline #(P, KEY_BITS, SEGMENT_BITS) camlines[TLB_ENTRIES-1:0](
     .clk, .reset, .VPN, .SATP_ASID, .SV39Mode, .PTE_G(PTE_Gs), .PTE_NAPOT(PTE_NAPOTs), .PageTypeWriteVal, .TLBFlush,
-    .WriteEnable(WriteEnables), .PageTypeRead, .Match(Matches));
+    .TLBFlushByVA, .TLBFlushByASID, .WriteEnable(WriteEnables), .PageTypeRead, .Match(Matches));
   assign CAMHit = |Matches & ~TLBFlush;
   or_rows #(TLB_ENTRIES,2) PageTypeOr(PageTypeRead, HitPageType);
 endmodule
@@ -41,6 +41,7 @@ module tlbcamline import cvw::*;  #(parameter cvw_t P,
   input  logic                  PTE_NAPOT,  // entry is in NAPOT mode (N bit set and PPN[3:0] = 1000)
   input  logic [1:0]            PageTypeWriteVal,
   input  logic                  TLBFlush,   // Flush this line (set valid to 0)
+  input  logic                  TLBFlushByVA, TLBFlushByASID, // Only flush if VPN matches / ASID matches and the entry isn't global
   output logic [1:0]            PageTypeRead,  // *** should this be the stored version or the always updated one?
   output logic                  Match
 );
@@ -59,9 +60,11 @@ module tlbcamline import cvw::*;  #(parameter cvw_t P,
   // Split up key and query into sections for each page table level.
   logic [P.ASID_BITS-1:0] Key_ASID;
   logic [SEGMENT_BITS-1:0] Key0, Key1, Query0, Query1;
-  logic MatchASID, Match0, Match1;
+  logic SameASID, MatchASID, MatchVPN, Match0, Match1;
+  logic FlushLine;
 
-  assign MatchASID = (SATP_ASID == Key_ASID) | PTE_G; 
+  assign SameASID = SATP_ASID == Key_ASID;
+  assign MatchASID = SameASID | PTE_G; 
 
   if (P.XLEN == 32) begin: match
 
@@ -74,7 +77,7 @@ module tlbcamline import cvw::*;  #(parameter cvw_t P,
     assign Match0 = (Query0 == Key0) | (PageType[0]); // least signifcant section
     assign Match1 = (Query1 == Key1);
 
-    assign Match = Match0 & Match1 & MatchASID & Valid;
+    assign MatchVPN = Match0 & Match1;
   end else begin: match
 
     logic [SEGMENT_BITS-1:0] Key2, Key3, Query2, Query3;
@@ -93,17 +96,23 @@ module tlbcamline import cvw::*;  #(parameter cvw_t P,
     assign Match2 = (Query2 == Key2) | (PageType > 2'd2);
     assign Match3 = (Query3 == Key3) | SV39Mode; // this should always match in sv39 because they aren't used
     
-    assign Match = Match0 & Match1 & Match2 & Match3 & MatchASID & Valid;
+    assign MatchVPN = Match0 & Match1 & Match2 & Match3;
   end
 
+  assign Match = MatchVPN & MatchASID & Valid;
+
+  // sfence.vma and sinval.vma flush all entries, or only those covering the virtual address,
+  // and/or only those of the address space.  Global entries are kept when flushing by ASID.
+  assign FlushLine = TLBFlush & (~TLBFlushByVA | MatchVPN) & (~TLBFlushByASID | SameASID & ~PTE_G);
+
   // On a write, update the type of the page referred to by this line.
   flopenr #(2) pagetypeflop(clk, reset, WriteEnable, PageTypeWriteVal, PageType);
   assign PageTypeRead = PageType & {2{Match}};
 
   // On a write, set the valid bit high and update the stored key.
-  // On a flush, zero the valid bit and leave the key unchanged.
+  // On a flush, zero the valid bit and leave the key unchanged.  A line written during a flush is invalidated.
   // *** Might we want to update stored key right away to output match on the
   // write cycle? (using a mux)
-  flopenr #(1) validbitflop(clk, reset, WriteEnable | TLBFlush, ~TLBFlush, Valid);
+  flopenr #(1) validbitflop(clk, reset, WriteEnable | FlushLine, ~TLBFlush, Valid);
   flopenr #(KEY_BITS) keyflop(clk, reset, WriteEnable, {SATP_ASID, VPN}, Key);
 endmodule
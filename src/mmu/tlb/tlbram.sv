@@ -35,7 +35,11 @@ module tlbram import cvw::*;  #(parameter cvw_t P,
   input  logic                      clk, reset,
   input  logic [P.XLEN-1:0]         PTE,
   input  logic [TLB_ENTRIES-1:0]    Matches, WriteEnables,
+  input  logic                      PMPFlush,
+  input  logic [TLB_ENTRIES-1:0]    PMPWriteEnables, // store the PMP record in the entry
+  input  logic [16:0]               PMPWriteVal,     // {L, X, W, R, PMA regions 13:1} of the page
   output logic [P.PPN_BITS-1:0]     PPN,
+  output logic [17:0]               PMPRecord,       // {valid, L, X, W, R, PMA regions 13:1} of the hit entry
   output logic [11:0]               PTEAccessBits,
   output logic [TLB_ENTRIES-1:0]    PTE_Gs,
   output logic [TLB_ENTRIES-1:0]    PTE_NAPOTs // entry is in NAPOT mode (N bit set and PPN[3:0] = 1000)
@@ -43,12 +47,14 @@ module tlbram import cvw::*;  #(parameter cvw_t P,
 
   logic [P.XLEN-1:0] RamRead[TLB_ENTRIES-1:0]; // stores the page table entries
   logic [P.XLEN-1:0] PageTableEntry;
+  logic [17:0]       PMPRead[TLB_ENTRIES-1:0];
 
   // RAM implemented with array of flops and AND/OR read logic
   tlbramline #(P) tlbramline[TLB_ENTRIES-1:0]
      (.clk, .reset, .re(Matches), .we(WriteEnables), 
-      .d(PTE), .q(RamRead), .PTE_G(PTE_Gs), .PTE_NAPOT(PTE_NAPOTs));
+      .d(PTE), .PMPFlush, .PMPwe(PMPWriteEnables), .PMPd(PMPWriteVal), .q(RamRead), .PMPq(PMPRead), .PTE_G(PTE_Gs), .PTE_NAPOT(PTE_NAPOTs));
   or_rows #(TLB_ENTRIES, P.XLEN) PTEOr(RamRead, PageTableEntry);
+  or_rows #(TLB_ENTRIES, 18) PMPOr(PMPRead, PMPRecord);
 
   // Rename the bits read from the TLB RAM
   assign PTEAccessBits = {PageTableEntry[P.XLEN-1:P.XLEN-4] & {4{P.XLEN == 64}}, PageTableEntry[7:0]}; // for RV64 include N and PBMT bits and OR of reserved bitss
@@ -31,7 +31,11 @@ module tlbramline import cvw::*;  #(parameter cvw_t P)
   (input  logic              clk, reset,
    input  logic              re, we,
    input  logic [P.XLEN-1:0] d,
+   input  logic              PMPFlush,  // PMP registers changed; cached permissions are stale
+   input  logic              PMPwe,     // store the PMP record of the page
+   input  logic [16:0]       PMPd,      // {L, X, W, R, PMA regions 13:1} of the page
    output logic [P.XLEN-1:0] q,
+   output logic [17:0]       PMPq,      // {valid, L, X, W, R, PMA regions 13:1}
    output logic              PTE_G,
    output logic              PTE_NAPOT // entry is in NAPOT mode (N bit set and PPN[3:0] = 1000)
 );
@@ -51,4 +55,12 @@ module tlbramline import cvw::*;  #(parameter cvw_t P)
    assign q = re ? line : 0;
    assign PTE_G = line[5]; // send global bit to CAM as part of ASID matching
    assign PTE_NAPOT = P.SVNAPOT_SUPPORTED & line[P.XLEN-1] & (line[13:10] == 4'b1000); // send NAPOT bit to CAM as part of matching lsbs of VPN
+
+  if (P.PMPCACHE_SUPPORTED) begin:pmpcache // PMP record of the page, filled by the PMP cache after the entry is written
+    logic [17:0] pmpline;
+    flopenr #(1) pmpvalidflop(clk, reset, we | PMPFlush | PMPwe, ~(we | PMPFlush), pmpline[17]);
+    flopenr #(17) pmprecordflop(clk, reset, PMPwe, PMPd, pmpline[16:0]);
+    assign PMPq = re ? pmpline : 0;
+  end else
+    assign PMPq = 0;
 endmodule
@@ -60,6 +60,7 @@ module csr import cvw::*;  #(parameter cvw_t P) (
   input  logic                     BPDirPredWrongM,
   input  logic                     BTAWrongM,
   input  logic                     RASPredPCWrongM,
+  input  logic                     IndTargetWrongM,
   input  logic                     IClassWrongM,
   input  logic                     BPWrongM,                  // branch predictor is wrong
   input  logic [3:0]               InstrClassM,
@@ -71,6 +72,11 @@ module csr import cvw::*;  #(parameter cvw_t P) (
   input  logic                     InvalidateICacheM,
   input  logic                     DivBusyE,                  // integer divide busy
   input  logic                     FDivBusyE,                 // floating point divide busy
+  input  logic                     IFUArbWait, LSUArbWait,    // IFU or LSU waits for bus arbitration
+  input  logic                     AMOM,                      // AMO instruction in Memory stage
+  input  logic [11:0]              CPIStackM,                 // top-down CPI stack: one-hot cause of this cycle
+  input  logic                     ITLBWriteF, DTLBWriteM,    // ITLB or DTLB filled by the page table walker
+  input  logic                     WFIStallM,                 // WFI waiting for an interrupt
   // outputs from CSRs
   output logic [1:0]               STATUS_MPP,
   output logic                     STATUS_SPP, STATUS_TSR, STATUS_TVM,
@@ -82,6 +88,7 @@ module csr import cvw::*;  #(parameter cvw_t P) (
   output logic [1:0]               STATUS_FS,
   output var logic [7:0]           PMPCFG_ARRAY_REGW[P.PMP_ENTRIES-1:0],
   output var logic [P.PA_BITS-3:0] PMPADDR_ARRAY_REGW[P.PMP_ENTRIES-1:0],
+  output logic                     WritePMPM,                 // PMP CSR written; MMUs invalidate cached PMP permissions
   output logic [2:0]               FRM_REGW, 
   output logic [3:0]               ENVCFG_CBE,
   output logic                     ENVCFG_PBMTE,              // Page-based memory type enable
@@ -89,7 +96,9 @@ module csr import cvw::*;  #(parameter cvw_t P) (
   // PC logic output from privileged unit to IFU                                  
   output logic [P.XLEN-1:0]        EPCM,                      // Exception Program counter to IFU PC logic
   output logic [P.XLEN-1:0]        TrapVectorM,               // Trap vector, to IFU PC logic
+  output logic [P.XLEN-1:0]        NextFaultMtvalM,           // trap value, to trace encoder
   //
+  output logic [P.XLEN-1:0]        CSRReadValM,               // value read from CSR, forwarded to Execute stage
   output logic [P.XLEN-1:0]        CSRReadValW,               // value read from CSR
   output logic                     IllegalCSRAccessM,         // Illegal CSR access: CSR doesn't exist or is inaccessible at this privilege level
   output logic                     BigEndianM                 // memory access is big-endian based on privilege mode and STATUS register endian fields
@@ -99,7 +108,6 @@ module csr import cvw::*;  #(parameter cvw_t P) (
   localparam SIP = 12'h144;
   
   logic [P.XLEN-1:0]       CSRMReadValM, CSRSReadValM, CSRUReadValM, CSRCReadValM;
-  logic [P.XLEN-1:0]       CSRReadValM;  
   logic [P.XLEN-1:0]       CSRSrcM;
   logic [P.XLEN-1:0]       CSRRWM, CSRRSM, CSRRCM;  
   logic [P.XLEN-1:0]       CSRWriteValM;
@@ -119,7 +127,7 @@ module csr import cvw::*;  #(parameter cvw_t P) (
   logic                    IllegalCSRMWriteReadonlyM;
   logic [P.XLEN-1:0]       CSRReadVal2M;
   logic [11:0]             MIP_REGW_writeable;
-  logic [P.XLEN-1:0]       TVecM,NextFaultMtvalM;
+  logic [P.XLEN-1:0]       TVecM;
   logic                    MTrapM, STrapM;
   logic                    SelMtvecM;
   logic [P.XLEN-1:0]       TVecAlignedM;
@@ -233,7 +241,7 @@ module csr import cvw::*;  #(parameter cvw_t P) (
     .NextEPCM, .NextCauseM, .NextMtvalM, .MSTATUS_REGW, .MSTATUSH_REGW,
     .CSRWriteValM, .CSRMReadValM, .MTVEC_REGW,
     .MEPC_REGW, .MCOUNTEREN_REGW, .MCOUNTINHIBIT_REGW, 
-    .MEDELEG_REGW, .MIDELEG_REGW,.PMPCFG_ARRAY_REGW, .PMPADDR_ARRAY_REGW,
+    .MEDELEG_REGW, .MIDELEG_REGW,.PMPCFG_ARRAY_REGW, .PMPADDR_ARRAY_REGW, .WritePMPM,
     .MIP_REGW, .MIE_REGW, .WriteMSTATUSM, .WriteMSTATUSHM,
     .IllegalCSRMAccessM, .IllegalCSRMWriteReadonlyM,
     .MENVCFG_REGW);
@@ -276,9 +284,10 @@ module csr import cvw::*;  #(parameter cvw_t P) (
   if (P.ZICNTR_SUPPORTED) begin:counters
     csrc #(P) counters(.clk, .reset, .StallE, .StallM, .FlushM,
       .InstrValidNotFlushedM, .LoadStallD, .StoreStallD, .CSRWriteM, .CSRMWriteM,
-      .BPDirPredWrongM, .BTAWrongM, .RASPredPCWrongM, .IClassWrongM, .BPWrongM,
+      .BPDirPredWrongM, .BTAWrongM, .RASPredPCWrongM, .IndTargetWrongM, .IClassWrongM, .BPWrongM,
       .InstrClassM, .DCacheMiss, .DCacheAccess, .ICacheMiss, .ICacheAccess, .sfencevmaM,
       .InterruptM, .ExceptionM, .InvalidateICacheM, .ICacheStallF, .DCacheStallM, .DivBusyE, .FDivBusyE,
+      .IFUArbWait, .LSUArbWait, .AMOM, .CPIStackM, .ITLBWriteF, .DTLBWriteM, .WFIStallM,
       .CSRAdrM, .PrivilegeModeW, .CSRWriteValM,
       .MCOUNTINHIBIT_REGW, .MCOUNTEREN_REGW, .SCOUNTEREN_REGW,
       .MTIME_CLINT,  .CSRCReadValM, .IllegalCSRCAccessM);
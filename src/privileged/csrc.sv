@@ -8,7 +8,8 @@
 //          See RISC-V Privileged Mode Specification 20190608 3.1.10-11
 // 
 // Documentation: RISC-V System on Chip Design Chapter 5
-//    MHPMEVENT is not supported
+//    MHPMEVENT selects between each counter's own event (0) and the top-down CPI stack causes
+//    (1-12 count cause 0-11 of cpistack.sv).  Other values are not legal and write 0.
 //
 // A component of the CORE-V-WALLY configurable RISC-V project.
 // https://github.com/openhwgroup/cvw
@@ -38,6 +39,7 @@ module csrc  import cvw::*;  #(parameter cvw_t P) (
   input  logic              BPDirPredWrongM,
   input  logic              BTAWrongM,
   input  logic              RASPredPCWrongM,
+  input  logic              IndTargetWrongM,
   input  logic              IClassWrongM,
   input  logic              BPWrongM,                                  // branch predictor is wrong
   input  logic [3:0]        InstrClassM,
@@ -53,6 +55,13 @@ module csrc  import cvw::*;  #(parameter cvw_t P) (
   input  logic              InvalidateICacheM,
   input  logic              DivBusyE,                                  // integer divide busy
   input  logic              FDivBusyE,                                 // floating point divide busy
+  input  logic              IFUArbWait,                                // IFU waits for bus held by LSU
+  input  logic              LSUArbWait,                                // LSU waits for bus held by IFU
+  input  logic              AMOM,                                      // AMO instruction in Memory stage
+  input  logic [11:0]       CPIStackM,                                 // one-hot top-down CPI stack cause of this cycle
+  input  logic              ITLBWriteF,                                // ITLB filled by the page table walker
+  input  logic              DTLBWriteM,                                // DTLB filled by the page table walker
+  input  logic              WFIStallM,                                 // WFI waiting for an interrupt
   input  logic [11:0]       CSRAdrM,
   input  logic [1:0]        PrivilegeModeW,
   input  logic [P.XLEN-1:0] CSRWriteValM,
@@ -78,7 +87,8 @@ module csrc  import cvw::*;  #(parameter cvw_t P) (
   logic                    LoadStallE, LoadStallM;
   logic                    StoreStallE, StoreStallM;
   logic [P.COUNTERS-1:0]   WriteHPMCOUNTERM;
-  logic [P.COUNTERS-1:0]   CounterEvent;
+  logic [P.COUNTERS-1:0]   CounterEvent, CountEvent;
+  logic [3:0]              MHPMEVENT_REGW[P.COUNTERS-1:0];
   logic [63:0]             HPMCOUNTERPlusM[P.COUNTERS-1:0];
   logic [P.XLEN-1:0]       NextHPMCOUNTERM[P.COUNTERS-1:0];
   genvar                   i;
@@ -120,10 +130,33 @@ module csrc  import cvw::*;  #(parameter cvw_t P) (
     // DivBusyE will never be assert high since this configuration uses the FPU to do integer division
     assign CounterEvent[24] = DivBusyE | FDivBusyE;                                      // division cycles *** RT: might need to be delay until the next cycle
     // coverage on
-    assign CounterEvent[P.COUNTERS-1:25] = 0; // eventually give these sources, including FP instructions, I$/D$ misses, branches and mispredictions
+    assign CounterEvent[25] = IndTargetWrongM & InstrValidNotFlushedM;                   // indirect jump (jalr not return) target wrong
+    assign CounterEvent[26] = IFUArbWait;                                                // IFU bus arbitration wait cycles
+    assign CounterEvent[27] = LSUArbWait;                                                // LSU bus arbitration wait cycles
+    assign CounterEvent[28] = AMOM;                                                      // AMO cycles in Memory stage, including cache and bus stalls
+    assign CounterEvent[29] = ITLBWriteF;                                                // ITLB misses, one per page table walk
+    assign CounterEvent[30] = DTLBWriteM;                                                // DTLB misses, one per page table walk
+    assign CounterEvent[31] = WFIStallM;                                                 // cycles idle in WFI
   end else begin: cevent
     assign CounterEvent[P.COUNTERS-1:3] = 0;
   end
+
+  // Event selection: mhpmevent picks the counter's own event or a CPI stack cause
+  for (i = 0; i < P.COUNTERS; i = i+1) begin:hpmevent
+    if (P.ZIHPM_SUPPORTED & i >= 3) begin
+      logic        WriteMHPMEVENTM;
+      logic [3:0]  NextMHPMEVENTM;
+      logic [12:0] EventSrc;
+      assign WriteMHPMEVENTM = CSRMWriteM & (CSRAdrM == MHPMEVENTBASE + i);
+      assign NextMHPMEVENTM = (CSRWriteValM < 13) ? CSRWriteValM[3:0] : 4'b0; // WARL
+      flopenr #(4) MHPMEVENTreg(clk, reset, WriteMHPMEVENTM, NextMHPMEVENTM, MHPMEVENT_REGW[i]);
+      assign EventSrc = {CPIStackM, CounterEvent[i]};
+      assign CountEvent[i] = EventSrc[MHPMEVENT_REGW[i]];
+    end else begin
+      assign MHPMEVENT_REGW[i] = 0;
+      assign CountEvent[i] = CounterEvent[i];
+    end
+  end
   
   // Counter update and write logic
   for (i = 0; i < P.COUNTERS; i = i+1) begin:cntr
@@ -136,14 +169,14 @@ module csrc  import cvw::*;  #(parameter cvw_t P) (
       if (P.XLEN==32) begin // write high and low separately
         logic [P.COUNTERS-1:0] WriteHPMCOUNTERHM;
         logic [P.XLEN-1:0] NextHPMCOUNTERHM[P.COUNTERS-1:0];
-        assign HPMCOUNTERPlusM[i] = {HPMCOUNTERH_REGW[i], HPMCOUNTER_REGW[i]} + {63'b0, CounterEvent[i] & ~MCOUNTINHIBIT_REGW[i]};
+        assign HPMCOUNTERPlusM[i] = {HPMCOUNTERH_REGW[i], HPMCOUNTER_REGW[i]} + {63'b0, CountEvent[i] & ~MCOUNTINHIBIT_REGW[i]};
         assign WriteHPMCOUNTERHM[i] = CSRMWriteM & (CSRAdrM == MHPMCOUNTERHBASE + i);
         assign NextHPMCOUNTERHM[i] = WriteHPMCOUNTERHM[i] ? CSRWriteValM : HPMCOUNTERPlusM[i][63:32];
         always_ff @(posedge clk) //, posedge reset) // ModelSim doesn't like syntax of passing array element to flop
             if (reset) HPMCOUNTERH_REGW[i][P.XLEN-1:0] <= #1 0;
             else       HPMCOUNTERH_REGW[i][P.XLEN-1:0] <= #1 NextHPMCOUNTERHM[i];
       end else begin // XLEN=64; write entire register
-          assign HPMCOUNTERPlusM[i] = HPMCOUNTER_REGW[i] + {63'b0, CounterEvent[i] & ~MCOUNTINHIBIT_REGW[i]};
+          assign HPMCOUNTERPlusM[i] = HPMCOUNTER_REGW[i] + {63'b0, CountEvent[i] & ~MCOUNTINHIBIT_REGW[i]};
       end
   end
 
@@ -162,6 +195,8 @@ module csrc  import cvw::*;  #(parameter cvw_t P) (
                  CSRCReadValM = HPMCOUNTER_REGW[CounterNumM];
         else if (CSRAdrM >= HPMCOUNTERBASE  & CSRAdrM  < HPMCOUNTERBASE+P.COUNTERS)  
                  CSRCReadValM = HPMCOUNTER_REGW[CounterNumM];
+        else if (P.ZIHPM_SUPPORTED & CSRAdrM >= MHPMEVENTBASE+3 & CSRAdrM < MHPMEVENTBASE+P.COUNTERS)
+                 CSRCReadValM = {{(P.XLEN-4){1'b0}}, MHPMEVENT_REGW[CounterNumM]};
         else begin
             CSRCReadValM = 0;
             IllegalCSRCAccessM = 1;  // requested CSR doesn't exist
@@ -180,6 +215,8 @@ module csrc  import cvw::*;  #(parameter cvw_t P) (
                  CSRCReadValM = HPMCOUNTERH_REGW[CounterNumM];
         else if (CSRAdrM >= HPMCOUNTERHBASE  & CSRAdrM < HPMCOUNTERHBASE+P.COUNTERS)   
                  CSRCReadValM = HPMCOUNTERH_REGW[CounterNumM];
+        else if (P.ZIHPM_SUPPORTED & CSRAdrM >= MHPMEVENTBASE+3 & CSRAdrM < MHPMEVENTBASE+P.COUNTERS)
+                 CSRCReadValM = {{(P.XLEN-4){1'b0}}, MHPMEVENT_REGW[CounterNumM]};
         else begin
           CSRCReadValM = 0;
           IllegalCSRCAccessM = 1; // requested CSR doesn't exist
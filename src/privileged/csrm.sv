@@ -47,6 +47,7 @@ module csrm  import cvw::*;  #(parameter cvw_t P) (
   output logic [11:0]              MIDELEG_REGW,
   output var logic [7:0]           PMPCFG_ARRAY_REGW[P.PMP_ENTRIES-1:0],
   output var logic [P.PA_BITS-3:0] PMPADDR_ARRAY_REGW [P.PMP_ENTRIES-1:0],
+  output logic                     WritePMPM,
   output logic                     WriteMSTATUSM, WriteMSTATUSHM,
   output logic                     IllegalCSRMAccessM, IllegalCSRMWriteReadonlyM,
   output logic [63:0]              MENVCFG_REGW
@@ -124,7 +125,8 @@ module csrm  import cvw::*;  #(parameter cvw_t P) (
         flopenr #(8) PMPCFGreg(clk, reset, WritePMPCFGM[i], CSRWriteValM[(i%4)*8+7:(i%4)*8], PMPCFG_ARRAY_REGW[i]);
       end
     end
-  end
+    assign WritePMPM = |WritePMPCFGM | |WritePMPADDRM;
+  end else assign WritePMPM = 0;
 
   localparam MISA_26 = (P.MISA) & 32'h03ffffff;
 
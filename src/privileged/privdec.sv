@@ -40,7 +40,8 @@ module privdec import cvw::*;  #(parameter cvw_t P) (
   output logic         IllegalInstrFaultM,                  // Illegal instruction
   output logic         EcallFaultM, BreakpointFaultM,       // Ecall or breakpoint; must retire, so don't flush it when the trap occurs
   output logic         sretM, mretM, RetM,                  // return instructions
-  output logic         wfiM, wfiW, sfencevmaM               // wfi / sfence.vma / sinval.vma instructions
+  output logic         wfiM, wfiW, sfencevmaM,              // wfi / sfence.vma / sinval.vma instructions
+  output logic         SfenceByVAM, SfenceByASIDM           // sfence.vma / sinval.vma limited to the address in rs1 / the ASID in rs2
 );
 
   logic                rs1zeroM;                            // rs1 field = 0
@@ -49,7 +50,7 @@ module privdec import cvw::*;  #(parameter cvw_t P) (
   logic                ebreakM, ecallM;                     // ebreak / ecall instructions
   logic                sinvalvmaM;                          // sinval.vma
   logic                sfencewinvalM, sfenceinvalirM;       // sfence.w.inval, sfence.inval.ir
-  logic                invalM;                              // any of the svinval instructions
+  logic                invalfenceM;                         // sfence.w.inval or sfence.inval.ir
 
   ///////////////////////////////////////////
   // Decode privileged instructions
@@ -58,11 +59,14 @@ module privdec import cvw::*;  #(parameter cvw_t P) (
   assign rs1zeroM =    InstrM[19:15] == 5'b0;
   
   // svinval instructions
-  // any svinval instruction is treated as sfence.vma on Wally
-  assign sinvalvmaM =     (InstrM[31:25] == 7'b0001001);
+  // sinval.vma invalidates TLB entries like sfence.vma, but without flushing the pipeline, so a batch of
+  // them is cheap.  sfence.inval.ir flushes the pipeline (see controller) so later instructions are refetched
+  // with the new translations.  sfence.w.inval has nothing to order because stores are not buffered.
+  assign sinvalvmaM =     P.SVINVAL_SUPPORTED & (InstrM[31:25] == 7'b0001011);
   assign sfencewinvalM  = (InstrM[31:20] == 12'b000110000000) & rs1zeroM;
   assign sfenceinvalirM = (InstrM[31:20] == 12'b000110000001) & rs1zeroM;
-  assign invalM =         P.SVINVAL_SUPPORTED & (sinvalvmaM | sfencewinvalM | sfenceinvalirM); 
+  assign invalfenceM =    PrivilegedM & P.SVINVAL_SUPPORTED & (sfencewinvalM | sfenceinvalirM) & 
+                          (PrivilegeModeW == P.M_MODE | PrivilegeModeW == P.S_MODE); // unaffected by STATUS_TVM
 
   assign sretM =      PrivilegedM & (InstrM[31:20] == 12'b000100000010) & rs1zeroM & P.S_SUPPORTED & 
                       (PrivilegeModeW == P.M_MODE | PrivilegeModeW == P.S_MODE & ~STATUS_TSR); 
@@ -71,8 +75,11 @@ module privdec import cvw::*;  #(parameter cvw_t P) (
   assign ecallM =     PrivilegedM & (InstrM[31:20] == 12'b000000000000) & rs1zeroM;
   assign ebreakM =    PrivilegedM & (InstrM[31:20] == 12'b000000000001) & rs1zeroM;
   assign wfiM =       PrivilegedM & (InstrM[31:20] == 12'b000100000101) & rs1zeroM;
-  assign sfencevmaM = PrivilegedM & (InstrM[31:25] ==  7'b0001001 | invalM) & 
+  assign sfencevmaM = PrivilegedM & (InstrM[31:25] ==  7'b0001001 | sinvalvmaM) & 
                       (PrivilegeModeW == P.M_MODE | (PrivilegeModeW == P.S_MODE & ~STATUS_TVM)); 
+  // rs1 = x0 applies to all addresses and rs2 = x0 to all address spaces; otherwise the TLB flush is selective
+  assign SfenceByVAM = ~rs1zeroM;
+  assign SfenceByASIDM = InstrM[24:20] != 5'b0;
 
   ///////////////////////////////////////////
   // WFI timeout Privileged Spec 3.1.6.5
@@ -101,7 +108,7 @@ module privdec import cvw::*;  #(parameter cvw_t P) (
   // Fault on illegal instructions
   ///////////////////////////////////////////
   
-  assign IllegalPrivilegedInstrM = PrivilegedM & ~(sretM|mretM|ecallM|ebreakM|wfiM|sfencevmaM);
+  assign IllegalPrivilegedInstrM = PrivilegedM & ~(sretM|mretM|ecallM|ebreakM|wfiM|sfencevmaM|invalfenceM);
   assign IllegalInstrFaultM = IllegalIEUFPUInstrM | IllegalPrivilegedInstrM | IllegalCSRAccessM | 
                               WFITimeoutM; 
 endmodule
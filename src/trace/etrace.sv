@@ -0,0 +1,211 @@
+///////////////////////////////////////////
+// etrace.sv
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified: 
+//
+// Purpose: Instruction trace encoder following the RISC-V Efficient Trace (E-Trace) te_inst packet formats.
+//          Watches instructions retiring from the Memory stage and emits a packet only when the
+//          program flow cannot be inferred from the binary: branch outcomes are collected in a map
+//          and full addresses are sent after uninferable jumps, traps, and periodic resyncs.
+//          Packets are encapsulated with a one byte header holding the payload length and are
+//          captured by the trace buffer in the uncore.  bin/etrace-decode.py rebuilds the PC stream.
+//
+//          Each packet carrying an address names the next instruction to retire, so the decoder follows
+//          the program from its previous position, using up the branch map, until it reaches that address.
+//          A full map without an address ends at the instruction after its last branch.  A sync packet names
+//          the instruction retiring with it, whose branch outcome starts the next map.
+//            F3SF0 sync       {addr, priv, branch=1, 2'b00, 2'b11}
+//            F3SF1 exception  {tval, addr, thaddr=1, interrupt, ecause, priv, branch=1, 2'b01, 2'b11}
+//            F2    address    {updiscon, notify, addr, 2'b10}
+//            F1    branches   {updiscon, notify, addr, map, branches, 2'b01}, or {map[30:0], 5'b0, 2'b01} when the map is full
+//          Addresses are always full (PC[XLEN-1:1]); implicit return and format 0 are not used.
+//          Backward jal is reported like an uninferable jump so the decoder can count trips around loops without branches.
+//
+// Documentation: RISC-V Efficient Trace for RISC-V Version 2.0
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+// 
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file 
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You 
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the 
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, 
+// either express or implied. See the License for the specific language governing permissions 
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+module etrace import cvw::*;  #(parameter cvw_t P) (
+  input  logic              clk, reset,
+  input  logic              TraceEnable,                  // trace buffer is accepting packets
+  input  logic              StallM, FlushM, StallW, FlushW,
+  input  logic              InstrValidM,                  // instruction in Memory stage is valid
+  input  logic [31:0]       InstrM,                       // decompressed instruction
+  input  logic [31:0]       InstrOrigM,                   // original instruction, to find its length
+  input  logic [P.XLEN-1:0] PCM,
+  input  logic [P.XLEN-1:0] IEUAdrM,                      // branch or jump target
+  input  logic [P.XLEN-1:0] EPCM,                         // mret/sret target
+  input  logic [P.XLEN-1:0] TrapVectorM,                  // trap handler address
+  input  logic              PCSrcE,                       // branch taken or jump
+  input  logic              TrapM, RetM,                  // trap taken, mret/sret
+  input  logic              InterruptM,                   // trap is an interrupt
+  input  logic [3:0]        CauseM,                       // trap cause
+  input  logic [P.XLEN-1:0] NextFaultMtvalM,              // trap value
+  input  logic [1:0]        PrivilegeModeW,
+  output logic              TraceValid,                   // packet to trace buffer
+  output logic [255:0]      TracePacket
+);
+
+  typedef enum logic [2:0] {PKT_NONE, PKT_SYNC, PKT_EXC, PKT_ADDR, PKT_FULL} pkttype;
+
+  pkttype                   Pkt;
+  logic                     TraceEnableD, StopTrace;
+  logic                     PCSrcM, RetireM, TrapTakenM, BranchM, UpdisconM;
+  logic [P.XLEN-1:0]        PCPlusLenM, NextPCM, LastNextPC, PktAddr;
+  logic [30:0]              Map, ResMap, PktMap, NextMap;
+  logic [4:0]               Count, ResCount, PktCount, NextCount;
+  logic                     SyncPending, ExcPending, RetiredSinceReport, NextRetired;
+  logic                     ExcInterrupt;
+  logic [3:0]               ExcCause;
+  logic [P.XLEN-1:0]        ExcTval, ExcHandler;
+  logic [7:0]               PacketCount;
+  logic [247:0]             Payload;
+  logic [7:0]               PayloadBits;
+  logic [5:0]               MW;
+  logic                     Notify, Updiscon, PktUpdiscon;
+
+  ///////////////////////////////////////////
+  // Retired instruction information
+  ///////////////////////////////////////////
+
+  flopr #(1) traceenreg(clk, reset, TraceEnable, TraceEnableD);
+  assign StopTrace = ~TraceEnable & TraceEnableD;              // report what is left in the map as tracing stops
+
+  flopenrc #(1) PCSrcMReg(clk, reset, FlushM, ~StallM, PCSrcE, PCSrcM);
+  assign RetireM    = InstrValidM & ~StallW & ~FlushW;
+  assign TrapTakenM = TrapM & ~StallW;
+  assign BranchM    = InstrM[6:0] == 7'b1100011;
+  // jalr and xret targets cannot be inferred, nor can the trip count of a branch-free loop closed by a backward jal
+  assign UpdisconM  = (InstrM[6:0] == 7'b1100111) | RetM | 
+                      (InstrM[6:0] == 7'b1101111) & (InstrM[31] | ~|InstrM[30:12]);
+  assign PCPlusLenM = PCM + ((InstrOrigM[1:0] == 2'b11) ? 4 : 2);
+  assign NextPCM    = RetM ? EPCM : PCSrcM ? IEUAdrM : PCPlusLenM;
+
+  // branch map including the retiring instruction; 1 = not taken, first branch in bit 0.
+  // Packets default to reporting this map and the address of the instruction that follows.
+  assign ResMap   = (RetireM & BranchM) ? Map | ({30'b0, ~PCSrcM} << Count) : Map;
+  assign ResCount = Count + {4'b0, RetireM & BranchM};
+
+  ///////////////////////////////////////////
+  // Packet emission rules, highest priority first
+  ///////////////////////////////////////////
+
+  always_comb begin
+    Pkt = PKT_NONE; PktAddr = NextPCM; PktMap = ResMap; PktCount = ResCount; PktUpdiscon = 0;
+    NextMap = ResMap; NextCount = ResCount; NextRetired = RetiredSinceReport | RetireM; 
+    if (StopTrace) begin                                                // flush what has retired
+      if (RetiredSinceReport) begin Pkt = PKT_ADDR; PktAddr = LastNextPC; PktMap = Map; PktCount = Count; end
+    end else if (TraceEnable) begin
+      if (ExcPending) begin                                             // cycle after a trap: report cause and handler
+        Pkt = PKT_EXC; PktAddr = ExcHandler;
+      end else if (TrapTakenM & (RetiredSinceReport | RetireM)) begin   // walk up to the trapping instruction
+        Pkt = PKT_ADDR; PktAddr = RetireM ? PCPlusLenM : PCM;
+        NextMap = 0; NextCount = 0; NextRetired = 0;
+      end else if (TrapTakenM) begin                                    // nothing retired since the last packet
+      end else if (RetireM & UpdisconM) begin                           // report the target
+        Pkt = PKT_ADDR; PktUpdiscon = 1;
+        NextMap = 0; NextCount = 0; NextRetired = 0;
+      end else if (RetireM & SyncPending & (Count == 0)) begin          // resync at this instruction
+        Pkt = PKT_SYNC; PktAddr = PCM;
+      end else if (RetireM & (ResCount == 5'd31)) begin                 // map full
+        Pkt = PKT_FULL; 
+        NextMap = 0; NextCount = 0; NextRetired = 0;
+      end
+    end
+  end
+
+  always_ff @(posedge clk)
+    if (reset | ~TraceEnable) begin
+      Map                <= 0;
+      Count              <= 0;
+      SyncPending        <= 1;
+      ExcPending         <= 0;
+      RetiredSinceReport <= 0;
+      PacketCount        <= 0;
+    end else begin
+      Map                <= NextMap;
+      Count              <= NextCount;
+      RetiredSinceReport <= NextRetired;
+      if (Pkt != PKT_NONE) PacketCount <= PacketCount + 1;
+      if (Pkt == PKT_SYNC | Pkt == PKT_EXC) SyncPending <= 0;
+      else if (Pkt != PKT_NONE & (&PacketCount)) SyncPending <= 1; // periodic resync
+      ExcPending <= TrapTakenM;
+      if (TrapTakenM) begin
+        ExcInterrupt <= InterruptM;
+        ExcCause     <= CauseM;
+        ExcTval      <= NextFaultMtvalM;
+        ExcHandler   <= TrapVectorM;
+      end
+    end
+
+  flopenr #(P.XLEN) lastnextpcreg(clk, reset, RetireM, NextPCM, LastNextPC);
+
+  ///////////////////////////////////////////
+  // Packet formatting
+  ///////////////////////////////////////////
+
+  // notify and updiscon equal to the address MSB carry no event.  Updiscon is flipped when the address is
+  // the target of the jump that caused the packet, so the decoder stops at that jump.
+  assign Notify   = PktAddr[P.XLEN-1];
+  assign Updiscon = PktAddr[P.XLEN-1] ^ PktUpdiscon;
+
+  always_comb
+    if      (PktCount == 5'd1)  MW = 6'd1;
+    else if (PktCount <= 5'd9)  MW = 6'd9;
+    else if (PktCount <= 5'd17) MW = 6'd17;
+    else if (PktCount <= 5'd25) MW = 6'd25;
+    else                        MW = 6'd31;
+
+  always_comb 
+    case (Pkt)
+      PKT_SYNC: begin
+        Payload     = {{(242-P.XLEN){1'b0}}, PktAddr[P.XLEN-1:1], PrivilegeModeW, 1'b1, 2'b00, 2'b11};
+        PayloadBits = 8'(P.XLEN + 6);
+      end
+      PKT_EXC: begin
+        Payload     = {{(234-2*P.XLEN){1'b0}}, ExcTval, PktAddr[P.XLEN-1:1], 1'b1, ExcInterrupt, 2'b00, ExcCause, 
+                       PrivilegeModeW, 1'b1, 2'b01, 2'b11};
+        PayloadBits = 8'(2*P.XLEN + 14);
+      end
+      PKT_ADDR: if (PktCount == 0) begin
+        Payload     = {{(245-P.XLEN){1'b0}}, Updiscon, Notify, PktAddr[P.XLEN-1:1], 2'b10};
+        PayloadBits = 8'(P.XLEN + 3);
+      end else begin
+        Payload     = ({{(247-P.XLEN){1'b0}}, Updiscon, Notify, PktAddr[P.XLEN-1:1]} << (7 + MW)) | 
+                      ({217'b0, PktMap} << 7) | {241'b0, PktCount, 2'b01};
+        PayloadBits = 8'(P.XLEN + 8) + {2'b0, MW};
+      end
+      PKT_FULL: begin
+        Payload     = {210'b0, PktMap, 5'b0, 2'b01};
+        PayloadBits = 8'd38;
+      end
+      default: begin
+        Payload     = 0;
+        PayloadBits = 0;
+      end
+    endcase
+
+  // encapsulation header: payload length in bytes; no flow, extension, source ID, or timestamp
+  assign TraceValid  = Pkt != PKT_NONE;
+  assign TracePacket = {Payload, 3'b0, 5'((PayloadBits + 8'd7) >> 3)};
+endmodule
@@ -0,0 +1,99 @@
+///////////////////////////////////////////
+// ahbarb.sv
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified:
+//
+// Purpose: Two-manager AHB arbiter between the core and a DMA engine in the uncore.
+//          The core owns the bus by default.  The DMA is granted the bus when the core is idle, keeps
+//          it through a burst, and hands it back once it goes idle and its last data phase completes.
+//          Neither manager sees HREADY while the other owns the bus, so the loser simply holds its
+//          address phase.
+//
+// Documentation: RISC-V System on Chip Design Chapter 6 (Figure 6.20)
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+//
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied. See the License for the specific language governing permissions
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+module ahbarb import cvw::*;  #(parameter cvw_t P) (
+  input  logic                 HCLK, HRESETn,
+  // core manager
+  input  logic [P.PA_BITS-1:0] CoreHADDR,
+  input  logic [P.AHBW-1:0]    CoreHWDATA,
+  input  logic [P.XLEN/8-1:0]  CoreHWSTRB,
+  input  logic                 CoreHWRITE,
+  input  logic [2:0]           CoreHSIZE,
+  input  logic [2:0]           CoreHBURST,
+  input  logic [3:0]           CoreHPROT,
+  input  logic [1:0]           CoreHTRANS,
+  input  logic                 CoreHMASTLOCK,
+  output logic                 CoreHREADY,
+  // DMA manager
+  input  logic [P.PA_BITS-1:0] DMAHADDR,
+  input  logic [P.AHBW-1:0]    DMAHWDATA,
+  input  logic [P.XLEN/8-1:0]  DMAHWSTRB,
+  input  logic                 DMAHWRITE,
+  input  logic [2:0]           DMAHSIZE,
+  input  logic [2:0]           DMAHBURST,
+  input  logic [1:0]           DMAHTRANS,
+  output logic                 DMAHREADY,
+  // arbitrated bus to the uncore and external memory
+  output logic [P.PA_BITS-1:0] HADDR,
+  output logic [P.AHBW-1:0]    HWDATA,
+  output logic [P.XLEN/8-1:0]  HWSTRB,
+  output logic                 HWRITE,
+  output logic [2:0]           HSIZE,
+  output logic [2:0]           HBURST,
+  output logic [3:0]           HPROT,
+  output logic [1:0]           HTRANS,
+  output logic                 HMASTLOCK,
+  input  logic                 HREADY
+);
+
+  logic                        DMAOwner, DMAOwnerNext;
+  logic                        DMAReq, CoreReq;
+  logic                        DMAData;
+
+  assign DMAReq  = DMAHTRANS[1];
+  assign CoreReq = CoreHTRANS[1];
+
+  // Switch to the DMA only between core transfers: the core is not starting one and none is in its data phase.
+  // Core bursts keep HTRANS nonidle until the last beat, so they are never split.
+  // Return to the core once the DMA's last data phase completes and it is not starting another transfer.
+  assign DMAOwnerNext = DMAOwner ? ~(~DMAReq & HREADY) : (DMAReq & ~CoreReq & HREADY);
+  flopr #(1) ownerreg(HCLK, ~HRESETn, DMAOwnerNext, DMAOwner);
+
+  // address phase signals come from the owner
+  assign HADDR     = DMAOwner ? DMAHADDR  : CoreHADDR;
+  assign HWRITE    = DMAOwner ? DMAHWRITE : CoreHWRITE;
+  assign HSIZE     = DMAOwner ? DMAHSIZE  : CoreHSIZE;
+  assign HBURST    = DMAOwner ? DMAHBURST : CoreHBURST;
+  assign HPROT     = DMAOwner ? 4'b0011   : CoreHPROT;   // privileged data access
+  assign HTRANS    = DMAOwner ? DMAHTRANS : CoreHTRANS;
+  assign HMASTLOCK = DMAOwner ? 1'b0      : CoreHMASTLOCK;
+
+  // write data follows the manager whose address phase was accepted
+  flopenr #(1) datareg(HCLK, ~HRESETn, HREADY, DMAOwner & DMAReq, DMAData);
+  assign HWDATA = DMAData ? DMAHWDATA : CoreHWDATA;
+  assign HWSTRB = DMAData ? DMAHWSTRB : CoreHWSTRB;
+
+  assign CoreHREADY = HREADY & ~DMAOwner;
+  assign DMAHREADY  = HREADY & DMAOwner;
+endmodule
@@ -0,0 +1,201 @@
+///////////////////////////////////////////
+// eth_apb.sv
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified:
+//
+// Purpose: Ethernet MAC with MII interface and descriptor ring DMA (ethdma.sv).  Frames are
+//          stored and forwarded through one transmit and one receive buffer of 2 KB each.
+//            0x00  control: bit 0 transmit enable, bit 1 receive enable, bit 2 promiscuous.
+//                  Clearing an enable resets that ring's head to 0.
+//            0x04  interrupt status, write 1 to clear: bit 0 frame sent, bit 1 frame received,
+//                  bit 2 received frame dropped (receive buffer full or no descriptor),
+//                  bit 3 descriptor rejected because its buffer is not aligned to the AHB width
+//            0x08  interrupt enable, same bits
+//            0x0C  MAC address bytes 0-3, byte 0 (first on the wire) in [7:0]
+//            0x10  MAC address bytes 4-5 in [15:0]
+//            0x14  transmit ring base [31:0]     0x28  receive ring base [31:0]
+//            0x18  transmit ring base [63:32]    0x2C  receive ring base [63:32]
+//            0x1C  transmit ring descriptors     0x30  receive ring descriptors
+//            0x20  transmit tail (software)      0x34  receive tail (software)
+//            0x24  transmit head (read only)     0x38  receive head (read only)
+//            0x3C  frames sent, 0x40 frames received, 0x44 frames dropped.  Any write clears.
+//          Ring bases are 16-byte aligned; bits 3:0 of 0x14 and 0x28 read as zero.
+//
+// Documentation: RISC-V System on Chip Design Chapter 15
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+//
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied. See the License for the specific language governing permissions
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+module eth_apb import cvw::*;  #(parameter cvw_t P) (
+  input  logic                 PCLK, PRESETn,
+  input  logic                 PSEL,
+  input  logic [11:0]          PADDR,
+  input  logic [P.XLEN-1:0]    PWDATA,
+  input  logic [P.XLEN/8-1:0]  PSTRB,
+  input  logic                 PWRITE,
+  input  logic                 PENABLE,
+  output logic [P.XLEN-1:0]    PRDATA,
+  output logic                 PREADY,
+  // MII pins
+  input  logic                 ETHTXCLK,
+  output logic [3:0]           ETHTXD,
+  output logic                 ETHTXEN,
+  input  logic                 ETHRXCLK,
+  input  logic [3:0]           ETHRXD,
+  input  logic                 ETHRXDV, ETHRXER,
+  // DMA AHB manager
+  output logic [P.PA_BITS-1:0] EthHADDR,
+  output logic [P.AHBW-1:0]    EthHWDATA,
+  output logic [P.XLEN/8-1:0]  EthHWSTRB,
+  output logic                 EthHWRITE,
+  output logic [2:0]           EthHSIZE,
+  output logic [2:0]           EthHBURST,
+  output logic [1:0]           EthHTRANS,
+  input  logic [P.AHBW-1:0]    HRDATA,
+  input  logic                 EthHREADY,
+  output logic                 EthIntr
+);
+
+  localparam                   BUFADR = 11 - $clog2(P.XLEN/8); // 2 KB frame buffers
+
+  logic [11:0]                 entry;
+  logic [31:0]                 Din, Dout;
+  logic                        memwrite;
+  logic                        TxEn, RxEn, Promisc;
+  logic [3:0]                  IntStat, IntEn, IntEvents;
+  logic [47:0]                 MacAddr;
+  logic [63:0]                 TxBase, RxBase;
+  logic [15:0]                 TxSize, RxSize, TxTail, RxTail, TxHead, RxHead;
+  logic [31:0]                 TxFrames, RxFrames, RxDrops;
+  logic                        TxStart, TxBusy, TxDone, RxDone, RxNoBuf, RxRelease, DescErr;
+  logic                        MacRxDone, MacRxDrop, RxFull;
+  logic [10:0]                 TxLen, MacRxLen, RxLen;
+  logic                        TxBufWe, RxBufWe;
+  logic [BUFADR-1:0]           TxBufWAdr, TxBufRAdr, RxBufWAdr, RxBufRAdr;
+  logic [P.XLEN/8-1:0]         RxBufBwe;
+  logic [P.XLEN-1:0]           TxBufData, RxBufWData, RxBufRData;
+
+  // APB I/O
+  assign entry    = {PADDR[11:2],2'b00};      // 32-bit word-aligned accesses
+  assign memwrite = PWRITE & PENABLE & PSEL;  // only write in access phase
+  assign PREADY   = 1'b1;                     // registers never take >1 cycle to respond
+
+  // -- Note Ethernet registers are 32 bits no matter what; access them with LW SW.
+  assign Din = PWDATA[31:0];
+  if (P.XLEN == 64) assign PRDATA = {Dout, Dout};
+  else              assign PRDATA = Dout;
+
+  assign IntEvents = {DescErr, (MacRxDrop & RxEn) | RxNoBuf, RxDone, TxDone};
+
+  // register access
+  always_ff @(posedge PCLK, negedge PRESETn)
+    if (~PRESETn) begin // asynch reset
+      TxEn     <= #1 0;
+      RxEn     <= #1 0;
+      Promisc  <= #1 0;
+      IntStat  <= #1 0;
+      IntEn    <= #1 0;
+      MacAddr  <= #1 0;
+      TxBase   <= #1 0;
+      RxBase   <= #1 0;
+      TxSize   <= #1 0;
+      RxSize   <= #1 0;
+      TxTail   <= #1 0;
+      RxTail   <= #1 0;
+      TxFrames <= #1 0;
+      RxFrames <= #1 0;
+      RxDrops  <= #1 0;
+    end else begin
+      if (memwrite)
+        case(entry)
+          12'h000: {Promisc, RxEn, TxEn} <= #1 Din[2:0];
+          12'h008: IntEn                 <= #1 Din[3:0];
+          12'h00C: MacAddr[31:0]         <= #1 Din;
+          12'h010: MacAddr[47:32]        <= #1 Din[15:0];
+          12'h014: TxBase[31:0]          <= #1 {Din[31:4], 4'b0000}; // descriptors are 16-byte aligned
+          12'h018: TxBase[63:32]         <= #1 Din;
+          12'h01C: TxSize                <= #1 Din[15:0];
+          12'h020: TxTail                <= #1 Din[15:0];
+          12'h028: RxBase[31:0]          <= #1 {Din[31:4], 4'b0000};
+          12'h02C: RxBase[63:32]         <= #1 Din;
+          12'h030: RxSize                <= #1 Din[15:0];
+          12'h034: RxTail                <= #1 Din[15:0];
+          default: ;
+        endcase
+      IntStat  <= #1 (IntStat & ~((memwrite & entry == 12'h004) ? Din[3:0] : 4'b0000)) | IntEvents;
+      TxFrames <= #1 (memwrite & entry == 12'h03C) ? '0 : TxFrames + {31'b0, TxDone};
+      RxFrames <= #1 (memwrite & entry == 12'h040) ? '0 : RxFrames + {31'b0, RxDone};
+      RxDrops  <= #1 (memwrite & entry == 12'h044) ? '0 : RxDrops + {31'b0, IntEvents[2]};
+    end
+
+  always_ff @(posedge PCLK)
+    case(entry) // flop to sample registers
+      12'h000: Dout <= #1 {29'b0, Promisc, RxEn, TxEn};
+      12'h004: Dout <= #1 {28'b0, IntStat};
+      12'h008: Dout <= #1 {28'b0, IntEn};
+      12'h00C: Dout <= #1 MacAddr[31:0];
+      12'h010: Dout <= #1 {16'b0, MacAddr[47:32]};
+      12'h014: Dout <= #1 TxBase[31:0];
+      12'h018: Dout <= #1 TxBase[63:32];
+      12'h01C: Dout <= #1 {16'b0, TxSize};
+      12'h020: Dout <= #1 {16'b0, TxTail};
+      12'h024: Dout <= #1 {16'b0, TxHead};
+      12'h028: Dout <= #1 RxBase[31:0];
+      12'h02C: Dout <= #1 RxBase[63:32];
+      12'h030: Dout <= #1 {16'b0, RxSize};
+      12'h034: Dout <= #1 {16'b0, RxTail};
+      12'h038: Dout <= #1 {16'b0, RxHead};
+      12'h03C: Dout <= #1 TxFrames;
+      12'h040: Dout <= #1 RxFrames;
+      12'h044: Dout <= #1 RxDrops;
+      default: Dout <= #1 0;
+    endcase
+
+  assign EthIntr = |(IntStat & IntEn);
+
+  // the receive buffer holds one frame until the DMA has copied it out
+  always_ff @(posedge PCLK)
+    if (~PRESETn | ~RxEn) RxFull <= #1 1'b0;
+    else if (MacRxDone)   RxFull <= #1 1'b1;
+    else if (RxRelease)   RxFull <= #1 1'b0;
+  flopenr #(11) rxlenreg(PCLK, ~PRESETn, MacRxDone, MacRxLen, RxLen);
+
+  ram2p1r1wbe #(.USE_SRAM(P.USE_SRAM), .DEPTH(2**BUFADR), .WIDTH(P.XLEN)) txbuf(.clk(PCLK), .ce1(1'b1), .ce2(1'b1),
+    .ra1(TxBufRAdr), .rd1(TxBufData), .wa2(TxBufWAdr), .wd2(HRDATA), .we2(TxBufWe), .bwe2('1));
+  ram2p1r1wbe #(.USE_SRAM(P.USE_SRAM), .DEPTH(2**BUFADR), .WIDTH(P.XLEN)) rxbuf(.clk(PCLK), .ce1(1'b1), .ce2(1'b1),
+    .ra1(RxBufRAdr), .rd1(RxBufRData), .wa2(RxBufWAdr), .wd2(RxBufWData), .we2(RxBufWe), .bwe2(RxBufBwe));
+
+  ethmii #(P, BUFADR) mii(.clk(PCLK), .reset(~PRESETn),
+    .ETHTXCLK, .ETHTXD, .ETHTXEN, .ETHRXCLK, .ETHRXD, .ETHRXDV, .ETHRXER,
+    .MacAddr, .Promisc,
+    .TxStart, .TxLen, .TxBusy, .TxBufAdr(TxBufRAdr), .TxBufData,
+    .RxFull(RxFull | ~RxEn), .RxBufWe, .RxBufAdr(RxBufWAdr), .RxBufBwe, .RxBufData(RxBufWData),
+    .RxDone(MacRxDone), .RxDrop(MacRxDrop), .RxLen(MacRxLen));
+
+  ethdma #(P, BUFADR) dma(.clk(PCLK), .reset(~PRESETn),
+    .TxEn, .RxEn, .TxBase(TxBase[P.PA_BITS-1:0]), .RxBase(RxBase[P.PA_BITS-1:0]),
+    .TxSize, .RxSize, .TxTail, .RxTail, .TxHead, .RxHead,
+    .TxBusy, .TxStart, .TxLen, .TxBufWe, .TxBufAdr(TxBufWAdr),
+    .RxFull, .RxLen, .RxBufAdr(RxBufRAdr), .RxBufData(RxBufRData), .RxRelease,
+    .TxDone, .RxDone, .RxNoBuf, .DescErr,
+    .HADDR(EthHADDR), .HWDATA(EthHWDATA), .HWSTRB(EthHWSTRB), .HWRITE(EthHWRITE), .HSIZE(EthHSIZE), .HBURST(EthHBURST), .HTRANS(EthHTRANS),
+    .HRDATA, .HREADY(EthHREADY));
+endmodule
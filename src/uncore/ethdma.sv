@@ -0,0 +1,227 @@
+///////////////////////////////////////////
+// ethdma.sv
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified:
+//
+// Purpose: Descriptor ring DMA for the Ethernet MAC.  Copies frames between memory and the
+//          MAC's transmit and receive frame buffers as an AHB manager.
+//          Each ring is an array of 16-byte descriptors at a base address:
+//            +0  buffer physical address (XLEN bits), aligned to the AHB width
+//            +8  frame length in bytes in [15:0]
+//          Descriptors from head up to but not including tail belong to the hardware.  Software
+//          advances tail after filling transmit descriptors or posting empty receive buffers, and
+//          hardware advances head as it finishes each one.  Receive buffers must hold 1536 bytes;
+//          the received length is written back to +8.  A frame that arrives with no receive
+//          descriptor available is dropped.  Buffers are copied as full-width beats, so a
+//          descriptor whose buffer is not aligned to the AHB width is rejected with DescErr: a
+//          transmit descriptor is consumed without sending, and a received frame is dropped with
+//          length 0 written back to its descriptor.
+//          Descriptor words are single transfers.  Buffers move in pipelined INCR bursts that
+//          restart with NONSEQ at each 1 KB boundary.  HSIZE is constant within a burst, so the
+//          last word of a received frame is written with HWSTRB covering only the frame's bytes.
+//          The bus goes idle in the data phase of the last transfer of each step so the arbiter
+//          can return it to the core between steps.  Bus errors are ignored.
+//
+// Documentation: RISC-V System on Chip Design Chapter 15
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+//
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied. See the License for the specific language governing permissions
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+module ethdma import cvw::*;  #(parameter cvw_t P, BUFADR) (
+  input  logic                 clk, reset,
+  // descriptor rings; a disabled ring has its head held at 0
+  input  logic                 TxEn, RxEn,
+  input  logic [P.PA_BITS-1:0] TxBase, RxBase,
+  input  logic [15:0]          TxSize, RxSize,
+  input  logic [15:0]          TxTail, RxTail,
+  output logic [15:0]          TxHead, RxHead,
+  // transmit frame buffer
+  input  logic                 TxBusy,
+  output logic                 TxStart,
+  output logic [10:0]          TxLen,
+  output logic                 TxBufWe,
+  output logic [BUFADR-1:0]    TxBufAdr,
+  // receive frame buffer
+  input  logic                 RxFull,
+  input  logic [10:0]          RxLen,
+  output logic [BUFADR-1:0]    RxBufAdr,
+  input  logic [P.XLEN-1:0]    RxBufData,
+  output logic                 RxRelease,       // receive buffer may be refilled
+  // events
+  output logic                 TxDone, RxDone, RxNoBuf,
+  output logic                 DescErr,         // descriptor rejected for a misaligned buffer
+  // AHB manager
+  output logic [P.PA_BITS-1:0] HADDR,
+  output logic [P.AHBW-1:0]    HWDATA,
+  output logic [P.XLEN/8-1:0]  HWSTRB,
+  output logic                 HWRITE,
+  output logic [2:0]           HSIZE,
+  output logic [2:0]           HBURST,
+  output logic [1:0]           HTRANS,
+  input  logic [P.AHBW-1:0]    HRDATA,
+  input  logic                 HREADY
+);
+
+  localparam                   LOGW = $clog2(P.AHBW/8);
+
+  typedef enum logic [2:0]     {DMA_IDLE, TX_DESC_ADR, TX_DESC_LEN, TX_COPY, RX_DESC_ADR, RX_COPY, RX_DESC_LEN} statetype;
+
+  statetype                    State;
+  logic                        Copy;            // buffer burst rather than a single descriptor transfer
+  logic                        AdrPhase;        // an address phase of this step is on the bus
+  logic                        AdrDone;         // the last address phase of this step has been accepted
+  logic                        LastAdr;         // the address phase on the bus is the step's last
+  logic                        Accept;          // address phase accepted this cycle
+  logic                        DataPhase;       // a beat is in its data phase
+  logic                        Done;            // the step's last data phase completes
+  logic [P.PA_BITS-1:0]        TxDesc, RxDesc, BufAdr, HRDATAAdr, BeatAdr;
+  logic [BUFADR-1:0]           AdrIdx, DataIdx; // buffer word in the address and data phases
+  logic [BUFADR-1:0]           LastWord;
+  logic [P.XLEN/8-1:0]         TailStrb;        // bytes of the frame in its last word
+  logic [10:0]                 Len, LenM1, DescLen;
+  logic [15:0]                 TxHeadNext, RxHeadNext;
+  logic                        TxReady, RxReady;
+  logic                        BufMisaligned, TxReject, RxReject;
+
+  assign TxDesc = TxBase + {TxHead, 4'b0000};
+  assign RxDesc = RxBase + {RxHead, 4'b0000};
+  assign TxHeadNext = (TxHead == TxSize - 16'd1) ? '0 : TxHead + 16'd1;
+  assign RxHeadNext = (RxHead == RxSize - 16'd1) ? '0 : RxHead + 16'd1;
+  assign TxReady = TxEn & ~TxBusy & (TxHead != TxTail);
+  assign RxReady = RxEn & RxFull;
+
+  // descriptor fields
+  if (P.PA_BITS > P.AHBW) assign HRDATAAdr = {{(P.PA_BITS-P.AHBW){1'b0}}, HRDATA};
+  else                    assign HRDATAAdr = HRDATA[P.PA_BITS-1:0];
+  assign DescLen  = (|HRDATA[15:11]) ? 11'h7FF : HRDATA[10:0]; // clip to the frame buffer
+  assign LenM1    = Len - 11'd1;
+  assign LastWord = LenM1[10:LOGW];
+  assign BufMisaligned = |HRDATA[LOGW-1:0];
+
+  ///////////////////////////////////////////
+  // Bus transfers.  Each step issues one address phase, or LastWord+1 pipelined ones for a buffer
+  // copy, and ends when the data phase of its last transfer completes.
+  ///////////////////////////////////////////
+
+  assign Copy      = (State == TX_COPY) | (State == RX_COPY);
+  assign AdrPhase  = (State != DMA_IDLE) & ~AdrDone;
+  assign LastAdr   = ~Copy | (AdrIdx == LastWord);
+  assign Accept    = AdrPhase & HREADY;
+  assign Done      = DataPhase & HREADY & ~AdrPhase;
+  assign BeatAdr   = BufAdr + {AdrIdx, {LOGW{1'b0}}};
+
+  // A burst starts with NONSEQ and starts over at 1 KB boundaries, which an INCR burst may not cross
+  assign HTRANS = ~AdrPhase ? 2'b00 : (Copy & (AdrIdx != '0) & (|BeatAdr[9:0])) ? 2'b11 : 2'b10; // SEQ : NONSEQ
+  assign HBURST = Copy ? 3'b001 : 3'b000; // INCR : SINGLE
+  assign HWRITE = (State == RX_COPY) | (State == RX_DESC_LEN);
+  assign HSIZE  = (P.AHBW == 64) ? 3'b011 : 3'b010;
+  assign HWDATA = (State == RX_DESC_LEN) ? {{(P.AHBW-11){1'b0}}, Len} : RxBufData;
+
+  // the last word of a frame holds LenM1[LOGW-1:0]+1 bytes
+  genvar b;
+  for (b = 0; b < P.XLEN/8; b++) begin : tailstrb
+    assign TailStrb[b] = (b <= LenM1[LOGW-1:0]);
+  end
+  assign HWSTRB = ((State == RX_COPY) & (DataIdx == LastWord)) ? TailStrb : '1;
+
+  always_comb
+    case (State)
+      TX_DESC_ADR: HADDR = TxDesc;
+      TX_DESC_LEN: HADDR = TxDesc + 8;
+      RX_DESC_ADR: HADDR = RxDesc;
+      RX_DESC_LEN: HADDR = RxDesc + 8;
+      default:     HADDR = BeatAdr;
+    endcase
+
+  always_ff @(posedge clk)
+    if (reset | Done) begin
+      AdrDone   <= #1 1'b0;
+      DataPhase <= #1 1'b0;
+      AdrIdx    <= #1 '0;
+      DataIdx   <= #1 '0;
+    end else if (Accept) begin
+      AdrDone   <= #1 LastAdr;
+      DataPhase <= #1 1'b1;
+      DataIdx   <= #1 AdrIdx;
+      AdrIdx    <= #1 AdrIdx + 1'b1;
+    end
+
+  ///////////////////////////////////////////
+  // Ring state machine.  Receive goes first because the MAC can only hold one received frame.
+  ///////////////////////////////////////////
+
+  always_ff @(posedge clk)
+    if (reset) begin
+      State     <= #1 DMA_IDLE;
+      TxHead    <= #1 '0;
+      RxHead    <= #1 '0;
+    end else begin
+      case (State)
+        DMA_IDLE:
+          if (RxReady) begin
+            if (RxHead != RxTail) State <= #1 RX_DESC_ADR;
+          end else if (TxReady) State <= #1 TX_DESC_ADR;
+        TX_DESC_ADR:
+          if (Done) begin
+            BufAdr <= #1 HRDATAAdr;
+            State  <= #1 BufMisaligned ? DMA_IDLE : TX_DESC_LEN;
+          end
+        TX_DESC_LEN:
+          if (Done) begin
+            Len     <= #1 DescLen;
+            State   <= #1 (DescLen == 0) ? DMA_IDLE : TX_COPY;
+          end
+        TX_COPY:
+          if (Done) State <= #1 DMA_IDLE;
+        RX_DESC_ADR:
+          if (Done) begin
+            BufAdr  <= #1 HRDATAAdr;
+            Len     <= #1 BufMisaligned ? 11'd0 : RxLen; // frames are never empty, so 0 marks a rejected buffer
+            State   <= #1 BufMisaligned ? RX_DESC_LEN : RX_COPY;
+          end
+        RX_COPY:
+          if (Done) State <= #1 RX_DESC_LEN;
+        RX_DESC_LEN:
+          if (Done) State <= #1 DMA_IDLE;
+        default: State <= #1 DMA_IDLE;
+      endcase
+      if (~TxEn) TxHead <= #1 '0;
+      else if (TxDone | TxReject) TxHead <= #1 TxHeadNext;
+      if (~RxEn) RxHead <= #1 '0;
+      else if (RxDone | RxReject) RxHead <= #1 RxHeadNext;
+    end
+
+  // frame buffers.  Transmit words are written as their data phases complete.  The receive buffer
+  // read is registered, so it is addressed with the word whose data phase comes next.
+  assign TxBufWe   = (State == TX_COPY) & DataPhase & HREADY;
+  assign TxBufAdr  = DataIdx;
+  assign RxBufAdr  = Accept ? AdrIdx : DataIdx;
+  assign TxStart   = (State == TX_COPY) & Done;
+  assign TxLen     = Len;
+
+  assign TxDone    = TxStart | (State == TX_DESC_LEN) & Done & (DescLen == 0);
+  assign RxDone    = (State == RX_DESC_LEN) & Done & (Len != 0);
+  assign RxNoBuf   = (State == DMA_IDLE) & RxReady & (RxHead == RxTail);
+  assign RxRelease = RxDone | RxReject | RxNoBuf;
+  assign TxReject  = (State == TX_DESC_ADR) & Done & BufMisaligned;
+  assign RxReject  = (State == RX_DESC_LEN) & Done & (Len == 0);
+  assign DescErr   = TxReject | RxReject;
+endmodule
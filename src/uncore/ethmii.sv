@@ -0,0 +1,218 @@
+///////////////////////////////////////////
+// ethmii.sv
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified:
+//
+// Purpose: Ethernet MAC framing over MII.  Transmits a frame from the transmit buffer with
+//          preamble, SFD, padding to the 60-byte minimum and FCS, then waits the interframe gap.
+//          Receives frames into the receive buffer, checks the FCS and filters on the destination
+//          address.  The MII clocks are oversampled in the bus clock domain, so they must run at
+//          no more than a quarter of the bus clock (10 Mb/s MII at 2.5 MHz).
+//
+// Documentation: IEEE 802.3 Clauses 3, 4 and 22
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+//
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied. See the License for the specific language governing permissions
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+module ethmii import cvw::*;  #(parameter cvw_t P, BUFADR) (
+  input  logic                clk, reset,
+  // MII pins
+  input  logic                ETHTXCLK,
+  output logic [3:0]          ETHTXD,
+  output logic                ETHTXEN,
+  input  logic                ETHRXCLK,
+  input  logic [3:0]          ETHRXD,
+  input  logic                ETHRXDV, ETHRXER,
+  // station address, first byte on the wire in [7:0]
+  input  logic [47:0]         MacAddr,
+  input  logic                Promisc,          // accept every destination address
+  // transmit frame buffer
+  input  logic                TxStart,          // send TxLen bytes from the transmit buffer
+  input  logic [10:0]         TxLen,
+  output logic                TxBusy,
+  output logic [BUFADR-1:0]   TxBufAdr,
+  input  logic [P.XLEN-1:0]   TxBufData,
+  // receive frame buffer
+  input  logic                RxFull,           // buffer still holds the last frame; drop new ones
+  output logic                RxBufWe,
+  output logic [BUFADR-1:0]   RxBufAdr,
+  output logic [P.XLEN/8-1:0] RxBufBwe,
+  output logic [P.XLEN-1:0]   RxBufData,
+  output logic                RxDone,           // good frame of RxLen bytes (FCS excluded) is in the buffer
+  output logic                RxDrop,           // good frame arrived while the buffer was full
+  output logic [10:0]         RxLen
+);
+
+  localparam                  LOGW = $clog2(P.XLEN/8);
+  localparam logic [31:0]     CRCPOLY = 32'hEDB88320;   // reflected IEEE 802.3 polynomial
+  localparam logic [31:0]     CRCRESIDUE = 32'hDEBB20E3; // CRC register after a good FCS
+
+  typedef enum logic [2:0]    {TX_IDLE, TX_PREAMBLE, TX_DATA, TX_FCS, TX_IFG} txstatetype;
+  typedef enum logic [1:0]    {RX_IDLE, RX_PREAMBLE, RX_DATA} rxstatetype;
+
+  txstatetype                 TxState;
+  rxstatetype                 RxState;
+  logic                       TxClkS, TxClkD, TxTick;
+  logic                       RxClkS, RxClkD, RxTick;
+  logic [3:0]                 RxDS;
+  logic                       RxDVS, RxERS;
+  logic [11:0]                TxCount, RxCount;
+  logic [10:0]                TxLenReg, TxPadLen, TxByteIdx, RxByteIdx;
+  logic [7:0]                 TxByte;
+  logic [3:0]                 TxNibble, RxLow;
+  logic [31:0]                TxCrc, RxCrc;
+  logic                       TxLast;
+  logic                       RxDiscard, RxMatch, RxGroup, RxErr, RxLong;
+  logic                       RxEnd, RxGood;
+
+  // one nibble of the Ethernet CRC, least significant bit first
+  function automatic logic [31:0] crcnibble(input logic [31:0] crc, input logic [3:0] d);
+    logic [31:0] c;
+    c = crc;
+    for (int i = 0; i < 4; i++) c = (c >> 1) ^ ((c[0] ^ d[i]) ? CRCPOLY : 32'h0);
+    return c;
+  endfunction
+
+  ///////////////////////////////////////////
+  // MII clock recovery: transmit on the rising edge of TX_CLK so the PHY samples on the next one,
+  // receive on the falling edge of RX_CLK, in the middle of the nibble the PHY launched on the rising edge
+  ///////////////////////////////////////////
+
+  synchronizer txclksync(.clk, .d(ETHTXCLK), .q(TxClkS));
+  synchronizer rxclksync(.clk, .d(ETHRXCLK), .q(RxClkS));
+  synchronizer rxdvsync(.clk, .d(ETHRXDV), .q(RxDVS));
+  synchronizer rxersync(.clk, .d(ETHRXER), .q(RxERS));
+  synchronizer rxdsync[3:0](.clk, .d(ETHRXD), .q(RxDS));
+  flopr #(2) clkdelayreg(clk, reset, {TxClkS, RxClkS}, {TxClkD, RxClkD});
+  assign TxTick = TxClkS & ~TxClkD;
+  assign RxTick = ~RxClkS & RxClkD;
+
+  ///////////////////////////////////////////
+  // Transmit
+  ///////////////////////////////////////////
+
+  assign TxByteIdx = TxCount[11:1];
+  assign TxBufAdr  = TxByteIdx[10:LOGW];       // RAM read is registered; the address settles a tick ahead
+  assign TxByte    = (TxByteIdx < TxLenReg) ? TxBufData[8*TxByteIdx[LOGW-1:0] +: 8] : 8'h00; // zero padding
+  assign TxNibble  = TxCount[0] ? TxByte[7:4] : TxByte[3:0];
+  assign TxPadLen  = (TxLenReg < 11'd60) ? 11'd60 : TxLenReg;
+  assign TxLast    = (TxCount == {TxPadLen - 11'd1, 1'b1});
+  assign TxBusy    = (TxState != TX_IDLE);
+
+  always_ff @(posedge clk)
+    if (reset) begin
+      TxState <= #1 TX_IDLE;
+      ETHTXEN <= #1 1'b0;
+      ETHTXD  <= #1 4'h0;
+      TxCount <= #1 '0;
+    end else if (TxState == TX_IDLE) begin
+      if (TxStart) begin
+        TxState  <= #1 TX_PREAMBLE;
+        TxLenReg <= #1 TxLen;
+        TxCount  <= #1 '0;
+      end
+    end else if (TxTick) begin
+      case (TxState)
+        TX_PREAMBLE: begin                     // 7 bytes of 0x55 then the SFD, 0xD5
+          ETHTXEN <= #1 1'b1;
+          ETHTXD  <= #1 (TxCount == 12'd15) ? 4'hD : 4'h5;
+          TxCount <= #1 (TxCount == 12'd15) ? '0 : TxCount + 12'd1;
+          TxCrc   <= #1 '1;
+          if (TxCount == 12'd15) TxState <= #1 TX_DATA;
+        end
+        TX_DATA: begin
+          ETHTXD  <= #1 TxNibble;
+          TxCrc   <= #1 crcnibble(TxCrc, TxNibble);
+          TxCount <= #1 TxLast ? '0 : TxCount + 12'd1;
+          if (TxLast) TxState <= #1 TX_FCS;
+        end
+        TX_FCS: begin                          // complemented CRC, least significant nibble first
+          ETHTXD  <= #1 ~TxCrc[4*TxCount[2:0] +: 4];
+          TxCount <= #1 (TxCount == 12'd7) ? '0 : TxCount + 12'd1;
+          if (TxCount == 12'd7) TxState <= #1 TX_IFG;
+        end
+        TX_IFG: begin                          // 96 bit times
+          ETHTXEN <= #1 1'b0;
+          ETHTXD  <= #1 4'h0;
+          TxCount <= #1 TxCount + 12'd1;
+          if (TxCount == 12'd23) TxState <= #1 TX_IDLE;
+        end
+        default: TxState <= #1 TX_IDLE;
+      endcase
+    end
+
+  ///////////////////////////////////////////
+  // Receive
+  ///////////////////////////////////////////
+
+  // Bytes, FCS included, are written as they arrive.  A frame that is dropped or rejected leaves
+  // garbage in the buffer, which is harmless because RxFull is only set by RxDone.
+  assign RxByteIdx = RxCount[11:1];
+  assign RxBufWe   = RxTick & (RxState == RX_DATA) & RxDVS & RxCount[0] & ~RxDiscard & ~RxLong;
+  assign RxBufAdr  = RxByteIdx[10:LOGW];
+  assign RxBufBwe  = {{(P.XLEN/8-1){1'b0}}, 1'b1} << RxByteIdx[LOGW-1:0];
+  assign RxBufData = {(P.XLEN/8){RxDS, RxLow}};
+
+  assign RxEnd  = RxTick & (RxState == RX_DATA) & ~RxDVS;
+  assign RxGood = (RxCrc == CRCRESIDUE) & ~RxCount[0] & (RxByteIdx >= 11'd64) & ~RxErr & ~RxLong &
+                  (RxMatch | RxGroup | Promisc);
+  assign RxDone = RxEnd & RxGood & ~RxDiscard;
+  assign RxDrop = RxEnd & RxGood & RxDiscard;
+  assign RxLen  = RxByteIdx - 11'd4;
+
+  always_ff @(posedge clk)
+    if (reset) begin
+      RxState <= #1 RX_IDLE;
+      RxCount <= #1 '0;
+    end else if (RxTick) begin
+      case (RxState)
+        RX_IDLE: if (RxDVS) RxState <= #1 RX_PREAMBLE;
+        RX_PREAMBLE: begin
+          if (~RxDVS) RxState <= #1 RX_IDLE;
+          else if (RxDS == 4'hD) begin          // SFD; the frame starts with the next nibble
+            RxState   <= #1 RX_DATA;
+            RxCount   <= #1 '0;
+            RxCrc     <= #1 '1;
+            RxDiscard <= #1 RxFull;
+            RxMatch   <= #1 1'b1;
+            RxGroup   <= #1 1'b0;
+            RxErr     <= #1 1'b0;
+            RxLong    <= #1 1'b0;
+          end
+        end
+        RX_DATA: begin
+          if (~RxDVS) RxState <= #1 RX_IDLE;
+          else begin
+            RxCrc   <= #1 crcnibble(RxCrc, RxDS);
+            RxErr   <= #1 RxErr | RxERS;
+            if (&RxCount) RxLong <= #1 1'b1;   // longer than the buffer
+            else RxCount <= #1 RxCount + 12'd1;
+            if (~RxCount[0]) RxLow <= #1 RxDS;
+            else if (RxByteIdx < 11'd6) begin  // destination address
+              RxMatch <= #1 RxMatch & ({RxDS, RxLow} == MacAddr[8*RxByteIdx[2:0] +: 8]);
+              if (RxByteIdx == 11'd0) RxGroup <= #1 RxLow[0]; // multicast and broadcast
+            end
+          end
+        end
+        default: RxState <= #1 RX_IDLE;
+      endcase
+    end
+endmodule
@@ -50,7 +50,7 @@ module plic_apb import cvw::*;  #(parameter cvw_t P) (
   input  logic                PENABLE,
   output logic [P.XLEN-1:0]   PRDATA,
   output logic                PREADY,
-  input  logic                UARTIntr,GPIOIntr, SPIIntr, SDCIntr,
+  input  logic                UARTIntr,GPIOIntr, SPIIntr, SDCIntr, EthIntr,
   output logic                MExtInt, SExtInt
 );
 
@@ -159,6 +159,7 @@ module plic_apb import cvw::*;  #(parameter cvw_t P) (
     if(P.PLIC_UART_ID != 0) requests[P.PLIC_UART_ID] = UARTIntr;
     if(P.PLIC_SPI_ID != 0) requests[P.PLIC_SPI_ID] = SPIIntr;
     if(P.PLIC_SDC_ID !=0)   requests[P.PLIC_SDC_ID]  = SDCIntr;
+    if(P.PLIC_ETH_ID != 0) requests[P.PLIC_ETH_ID] = EthIntr;
   end
 
   // pending interrupt request
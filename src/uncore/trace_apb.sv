@@ -0,0 +1,114 @@
+///////////////////////////////////////////
+// trace_apb.sv
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified: 
+//
+// Purpose: On-chip instruction trace buffer.  Captures the packets produced by the core's E-Trace
+//          encoder into a circular buffer which software or a debugger reads back over APB.
+//            0x00  control: bit 0 enable, bit 1 wrap (overwrite oldest when full, else stop)
+//            0x04  status:  write index in [15:0], bit 31 set once the buffer has filled.  Any write clears.
+//            0x08  number of entries (read only)
+//            0x8000 + 32*i + 4*w: word w of entry i.  Each entry holds one packet, LSB first.
+// 
+// Documentation: RISC-V Efficient Trace for RISC-V Version 2.0
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+// 
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file 
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You 
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the 
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, 
+// either express or implied. See the License for the specific language governing permissions 
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+
+module trace_apb import cvw::*;  #(parameter cvw_t P) (
+  input  logic                PCLK, PRESETn,
+  input  logic                PSEL,
+  input  logic [15:0]         PADDR, 
+  input  logic [P.XLEN-1:0]   PWDATA,
+  input  logic [P.XLEN/8-1:0] PSTRB,
+  input  logic                PWRITE,
+  input  logic                PENABLE,
+  output logic [P.XLEN-1:0]   PRDATA,
+  output logic                PREADY,
+  input  logic                TraceValid,       // packet from the trace encoder
+  input  logic [255:0]        TracePacket,
+  output logic                TraceEnable       // tells the encoder to produce packets
+);
+
+  localparam                  IDXBITS = $clog2(P.TRACE_ENTRIES);
+
+  logic [15:0]                entry, entryD;
+  logic [31:0]                Din, Dout, RegDout, BufDout;
+  logic                       memwrite;
+  logic                       Enable, EnableD, Wrap, Full;
+  logic [IDXBITS-1:0]         WrIdx;
+  logic                       BufWrite;
+  logic [255:0]               BufEntry;
+  
+  // APB I/O
+  assign entry    = {PADDR[15:2],2'b00};      // 32-bit word-aligned accesses
+  assign memwrite = PWRITE & PENABLE & PSEL;  // only write in access phase
+  assign PREADY   = 1'b1;                     // buffer read is registered in the setup phase, never takes >1 cycle
+
+  // -- Note trace registers are 32 bits no matter what; access them with LW SW.
+  assign Din = PWDATA[31:0]; 
+  if (P.XLEN == 64) assign PRDATA = {Dout, Dout}; 
+  else              assign PRDATA = Dout;    
+
+  // register access
+  always_ff @(posedge PCLK, negedge PRESETn)
+    if (~PRESETn) begin // asynch reset
+      Enable <= #1 0;
+      Wrap   <= #1 0;
+      WrIdx  <= #1 0;
+      Full   <= #1 0;
+    end else begin
+      if (memwrite & (entry == 16'h00)) begin
+        Enable <= #1 Din[0];
+        Wrap   <= #1 Din[1];
+      end
+      if (memwrite & (entry == 16'h04)) begin
+        WrIdx  <= #1 0;
+        Full   <= #1 0;
+      end else if (BufWrite) begin
+        WrIdx  <= #1 WrIdx + 1;
+        if (&WrIdx) Full <= #1 1'b1;
+      end
+    end
+
+  always_ff @(posedge PCLK)
+    case(entry) // flop to sample registers
+      16'h00: RegDout  <= #1 {30'b0, Wrap, Enable};
+      16'h04: RegDout  <= #1 {Full, {(31-IDXBITS){1'b0}}, WrIdx};
+      16'h08: RegDout  <= #1 P.TRACE_ENTRIES;
+      default: RegDout <= #1 0;
+    endcase
+
+  // packet storage.  Stop accepting packets once full unless wrapping.
+  // Accept one more packet after disabling so the encoder can flush its branch map.
+  assign TraceEnable = Enable & (Wrap | ~Full);
+  flopr #(1) enablereg(PCLK, ~PRESETn, Enable, EnableD);
+  assign BufWrite    = TraceValid & (Enable | EnableD) & (Wrap | ~Full);
+
+  ram2p1r1wbe #(.USE_SRAM(P.USE_SRAM), .DEPTH(P.TRACE_ENTRIES), .WIDTH(256)) buffer(.clk(PCLK), .ce1(1'b1), .ce2(1'b1),
+    .ra1(entry[IDXBITS+4:5]), .rd1(BufEntry), .wa2(WrIdx), .wd2(TracePacket), .we2(BufWrite), .bwe2('1));
+
+  // the RAM read is registered in the setup phase, so select the word with the registered address
+  flopr #(16) entryreg(PCLK, ~PRESETn, entry, entryD);
+  assign BufDout = BufEntry[32*entryD[4:2] +: 32];
+  assign Dout    = entryD[15] ? BufDout : RegDout;
+endmodule
@@ -58,28 +58,48 @@ module uncore import cvw::*;  #(parameter cvw_t P)(
   input  logic                 SDCIntr,
   input  logic                 SPIIn,
   output logic                 SPIOut,
-  output logic [3:0]           SPICS                  
+  output logic [3:0]           SPICS,
+  // instruction trace
+  input  logic                 TraceValid,                // trace packet from the core's trace encoder
+  input  logic [255:0]         TracePacket,
+  output logic                 TraceEnable,               // trace encoder enable from the trace buffer
+  // Ethernet MII pins
+  input  logic                 ETHTXCLK,
+  output logic [3:0]           ETHTXD,
+  output logic                 ETHTXEN,
+  input  logic                 ETHRXCLK,
+  input  logic [3:0]           ETHRXD,
+  input  logic                 ETHRXDV, ETHRXER,
+  // Ethernet DMA manager, arbitrated against the core in wallypipelinedsoc
+  output logic [P.PA_BITS-1:0] EthHADDR,
+  output logic [P.AHBW-1:0]    EthHWDATA,
+  output logic [P.XLEN/8-1:0]  EthHWSTRB,
+  output logic                 EthHWRITE,
+  output logic [2:0]           EthHSIZE,
+  output logic [2:0]           EthHBURST,
+  output logic [1:0]           EthHTRANS,
+  input  logic                 EthHREADY
 );
   
   logic [P.XLEN-1:0]           HREADRam, HREADSDC;
 
-  logic [11:0]                 HSELRegions;
-  logic                        HSELDTIM, HSELIROM, HSELRam, HSELCLINT, HSELPLIC, HSELGPIO, HSELUART, HSELSPI;
-  logic                        HSELDTIMD, HSELIROMD, HSELEXTD, HSELRamD, HSELCLINTD, HSELPLICD, HSELGPIOD, HSELUARTD, HSELSDCD, HSELSPID;
+  logic [13:0]                 HSELRegions;
+  logic                        HSELDTIM, HSELIROM, HSELRam, HSELCLINT, HSELPLIC, HSELGPIO, HSELUART, HSELSPI, HSELTRACE, HSELETH;
+  logic                        HSELDTIMD, HSELIROMD, HSELEXTD, HSELRamD, HSELCLINTD, HSELPLICD, HSELGPIOD, HSELUARTD, HSELSDCD, HSELSPID, HSELTRACED, HSELETHD;
   logic                        HRESPRam,  HRESPSDC;
   logic                        HREADYRam, HRESPSDCD;
   logic [P.XLEN-1:0]           HREADBootRom; 
   logic                        HSELBootRom, HSELBootRomD, HRESPBootRom, HREADYBootRom, HREADYSDC;
   logic                        HSELNoneD;
-  logic                        UARTIntr,GPIOIntr, SPIIntr;
+  logic                        UARTIntr,GPIOIntr, SPIIntr, EthIntr;
   logic                        SDCIntM;
   
   logic                        PCLK, PRESETn, PWRITE, PENABLE;
-  logic [4:0]                  PSEL, PREADY;
+  logic [6:0]                  PSEL, PREADY;
   logic [31:0]                 PADDR;
   logic [P.XLEN-1:0]           PWDATA;
   logic [P.XLEN/8-1:0]         PSTRB;
-  logic [4:0][P.XLEN-1:0]      PRDATA;
+  logic [6:0][P.XLEN-1:0]      PRDATA;
   logic [P.XLEN-1:0]           HREADBRIDGE;
   logic                        HRESPBRIDGE, HREADYBRIDGE, HSELBRIDGE, HSELBRIDGED;
 
@@ -92,14 +112,14 @@ module uncore import cvw::*;  #(parameter cvw_t P)(
   adrdecs #(P) adrdecs(HADDR, 1'b1, 1'b1, 1'b1, HSIZE[1:0], HSELRegions);
 
   // unswizzle HSEL signals
-  assign {HSELSPI, HSELEXTSDC, HSELPLIC, HSELUART, HSELGPIO, HSELCLINT, HSELRam, HSELBootRom, HSELEXT, HSELIROM, HSELDTIM} = HSELRegions[11:1];
+  assign {HSELETH, HSELTRACE, HSELSPI, HSELEXTSDC, HSELPLIC, HSELUART, HSELGPIO, HSELCLINT, HSELRam, HSELBootRom, HSELEXT, HSELIROM, HSELDTIM} = HSELRegions[13:1];
 
   // AHB -> APB bridge
-  ahbapbbridge #(P, 5) ahbapbbridge (
-    .HCLK, .HRESETn, .HSEL({HSELSPI, HSELUART, HSELPLIC, HSELCLINT, HSELGPIO}), .HADDR, .HWDATA, .HWSTRB, .HWRITE, .HTRANS, .HREADY, 
+  ahbapbbridge #(P, 7) ahbapbbridge (
+    .HCLK, .HRESETn, .HSEL({HSELETH, HSELTRACE, HSELSPI, HSELUART, HSELPLIC, HSELCLINT, HSELGPIO}), .HADDR, .HWDATA, .HWSTRB, .HWRITE, .HTRANS, .HREADY, 
     .HRDATA(HREADBRIDGE), .HRESP(HRESPBRIDGE), .HREADYOUT(HREADYBRIDGE),
     .PCLK, .PRESETn, .PSEL, .PWRITE, .PENABLE, .PADDR, .PWDATA, .PSTRB, .PREADY, .PRDATA);
-  assign HSELBRIDGE = HSELGPIO | HSELCLINT | HSELPLIC | HSELUART | HSELSPI; // if any of the bridge signals are selected
+  assign HSELBRIDGE = HSELGPIO | HSELCLINT | HSELPLIC | HSELUART | HSELSPI | HSELTRACE | HSELETH; // if any of the bridge signals are selected
                 
   // on-chip RAM
   if (P.UNCORE_RAM_SUPPORTED) begin : ram
@@ -125,7 +145,7 @@ module uncore import cvw::*;  #(parameter cvw_t P)(
 
   if (P.PLIC_SUPPORTED == 1) begin : plic
     plic_apb #(P) plic(.PCLK, .PRESETn, .PSEL(PSEL[2]), .PADDR(PADDR[27:0]), .PWDATA, .PSTRB, .PWRITE, .PENABLE, 
-      .PRDATA(PRDATA[2]), .PREADY(PREADY[2]), .UARTIntr, .GPIOIntr, .SDCIntr, .SPIIntr, .MExtInt, .SExtInt);
+      .PRDATA(PRDATA[2]), .PREADY(PREADY[2]), .UARTIntr, .GPIOIntr, .SDCIntr, .SPIIntr, .EthIntr, .MExtInt, .SExtInt);
   end else begin : plic
     assign MExtInt = 0;
     assign SExtInt = 0;
@@ -157,6 +177,25 @@ module uncore import cvw::*;  #(parameter cvw_t P)(
   end else begin : spi
     assign SPIOut = 0; assign SPICS = 0; assign SPIIntr = 0;
   end
+  if (P.TRACE_SUPPORTED == 1) begin : trace
+    trace_apb #(P) trace (
+      .PCLK, .PRESETn, .PSEL(PSEL[5]), .PADDR(PADDR[15:0]), .PWDATA, .PSTRB, .PWRITE, .PENABLE, 
+      .PREADY(PREADY[5]), .PRDATA(PRDATA[5]), 
+      .TraceValid, .TracePacket, .TraceEnable);
+  end else begin : trace
+    assign TraceEnable = 0;
+  end
+  if (P.ETH_SUPPORTED == 1) begin : eth
+    eth_apb #(P) eth (
+      .PCLK, .PRESETn, .PSEL(PSEL[6]), .PADDR(PADDR[11:0]), .PWDATA, .PSTRB, .PWRITE, .PENABLE, 
+      .PREADY(PREADY[6]), .PRDATA(PRDATA[6]), 
+      .ETHTXCLK, .ETHTXD, .ETHTXEN, .ETHRXCLK, .ETHRXD, .ETHRXDV, .ETHRXER,
+      .EthHADDR, .EthHWDATA, .EthHWSTRB, .EthHWRITE, .EthHSIZE, .EthHBURST, .EthHTRANS, .HRDATA, .EthHREADY, .EthIntr);
+  end else begin : eth
+    assign ETHTXD = 0; assign ETHTXEN = 0; assign EthIntr = 0;
+    assign EthHADDR = 0; assign EthHWDATA = 0; assign EthHWSTRB = 0; assign EthHWRITE = 0; assign EthHSIZE = 0;
+    assign EthHBURST = 0; assign EthHTRANS = 0;
+  end
 
   // AHB Read Multiplexer
   assign HRDATA = ({P.XLEN{HSELRamD}} & HREADRam) |
@@ -180,8 +219,8 @@ module uncore import cvw::*;  #(parameter cvw_t P)(
   // takes more than 1 cycle to repsond it needs to hold on to the old select until the
   // device is ready.  Hense this register must be selectively enabled by HREADY.
   // However on reset None must be seleted.
-  flopenl #(12) hseldelayreg(HCLK, ~HRESETn, HREADY, HSELRegions, 12'b1, 
-    {HSELSPID, HSELEXTSDCD, HSELPLICD, HSELUARTD, HSELGPIOD, HSELCLINTD,
+  flopenl #(14) hseldelayreg(HCLK, ~HRESETn, HREADY, HSELRegions, 14'b1, 
+    {HSELETHD, HSELTRACED, HSELSPID, HSELEXTSDCD, HSELPLICD, HSELUARTD, HSELGPIOD, HSELCLINTD,
       HSELRamD, HSELBootRomD, HSELEXTD, HSELIROMD, HSELDTIMD, HSELNoneD});
   flopenr #(1) hselbridgedelayreg(HCLK, ~HRESETn, HREADY, HSELBRIDGE, HSELBRIDGED);
 endmodule
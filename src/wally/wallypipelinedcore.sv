@@ -44,12 +44,19 @@ module wallypipelinedcore import cvw::*; #(parameter cvw_t P) (
    output logic [2:0]            HBURST,
    output logic [3:0]            HPROT,
    output logic [1:0]            HTRANS,
-   output logic                  HMASTLOCK
+   output logic                  HMASTLOCK,
+   // Instruction trace
+   input  logic                  TraceEnable,
+   output logic                  TraceValid,
+   output logic [255:0]          TracePacket
 );
 
   logic                          StallF, StallD, StallE, StallM, StallW;
   logic                          FlushD, FlushE, FlushM, FlushW;
   logic                          TrapM, RetM;
+  logic                          InterruptM;
+  logic [3:0]                    CauseM;
+  logic [P.XLEN-1:0]             NextFaultMtvalM;
 
   //  signals that must connect through DP
   logic                          IntDivE, W64E;
@@ -62,7 +69,7 @@ module wallypipelinedcore import cvw::*; #(parameter cvw_t P) (
   logic [31:0]                   InstrM, InstrOrigM;
   logic [P.XLEN-1:0]             PCSpillF, PCE, PCLinkE;
   logic [P.XLEN-1:0]             PCM;
-  logic [P.XLEN-1:0]             CSRReadValW, MDUResultW;
+  logic [P.XLEN-1:0]             CSRReadValM, CSRReadValW, MDUResultW;
   logic [P.XLEN-1:0]             EPCM, TrapVectorM;
   logic [1:0]                    MemRWE;
   logic [1:0]                    MemRWM;
@@ -104,6 +111,7 @@ module wallypipelinedcore import cvw::*; #(parameter cvw_t P) (
 
   // memory management unit signals
   logic                          ITLBWriteF;
+  logic                          DTLBWriteM;
   logic                          ITLBMissF;
   logic [P.XLEN-1:0]             SATP_REGW;
   logic                          STATUS_MXR, STATUS_SUM, STATUS_MPRV;
@@ -112,6 +120,8 @@ module wallypipelinedcore import cvw::*; #(parameter cvw_t P) (
   logic [P.XLEN-1:0]             PTE;
   logic [1:0]                    PageType;
   logic                          sfencevmaM;
+  logic                          SfenceByVAM, SfenceByASIDM;
+  logic                          WritePMPM;
   logic                          SelHPTW;
 
   // PMA checker signals
@@ -121,6 +131,8 @@ module wallypipelinedcore import cvw::*; #(parameter cvw_t P) (
   // IMem stalls
   logic                          IFUStallF;
   logic                          LSUStallM;
+  logic                          HPTWStall;
+  logic [11:0]                   CPIStackM;
 
   // cpu lsu interface
   logic [2:0]                    Funct3M;
@@ -128,6 +140,8 @@ module wallypipelinedcore import cvw::*; #(parameter cvw_t P) (
   logic [P.XLEN-1:0]             WriteDataM;
   logic [P.XLEN-1:0]             IEUAdrM;  
   logic [P.LLEN-1:0]             ReadDataW;  
+  logic [P.XLEN-1:0]             LoadFwdDataM;
+  logic                          LoadFwdM;
   logic                          CommittedM;
 
   // AHB ifu interface
@@ -149,6 +163,8 @@ module wallypipelinedcore import cvw::*; #(parameter cvw_t P) (
   logic                          BPDirPredWrongM;
   logic                          BTAWrongM;
   logic                          RASPredPCWrongM;
+  logic                          IndTargetWrongM;
+  logic                          IFUArbWait, LSUArbWait;
   logic                          IClassWrongM;
   logic [3:0]                    InstrClassM;
   logic                          InstrAccessFaultF, HPTWInstrAccessFaultF, HPTWInstrPageFaultF;
@@ -167,9 +183,23 @@ module wallypipelinedcore import cvw::*; #(parameter cvw_t P) (
   logic                          BranchD, BranchE, JumpD, JumpE;
   logic                          DCacheStallM, ICacheStallF;
   logic                          wfiM, IntPendingM;
+  logic                          PipeClk;
+
+  // Pipeline clock gating during WFI.  Once a WFI has stalled the Memory stage for a cycle, the instruction
+  // ahead of it has written back, the IFU and LSU are idle, and the pipeline flops would only hold their values,
+  // so its clock is stopped.  The privileged unit, counters, and bus keep the free-running clock.  A pending
+  // interrupt or a WFI timeout trap clears WFIIdleM combinationally, so the gate reopens before the next edge.
+  // WFI_CLOCKGATE = 2 uses a BUFGCE on the FPGA; otherwise the gate is the latch model, which synthDC replaces
+  // with the library's integrated clock gate.
+  if (P.WFI_CLOCKGATE != 0) begin:wfigate
+    logic WFIIdleM, WFIIdleDelayedM;
+    assign WFIIdleM = wfiM & ~IntPendingM & StallM & ~StallW;  // stalled by WFI alone, not by a trap or the IFU or LSU
+    flopr #(1) wfiidlereg(clk, reset, WFIIdleM, WFIIdleDelayedM);
+    clockgater #(P.WFI_CLOCKGATE == 2) pipeclockgater(.E(~(WFIIdleM & WFIIdleDelayedM) | reset), .SE(1'b0), .CLK(clk), .ECLK(PipeClk));
+  end else assign PipeClk = clk;
 
   // instruction fetch unit: PC, branch prediction, instruction cache
-  ifu #(P) ifu(.clk, .reset,
+  ifu #(P) ifu(.clk(PipeClk), .reset,
     .StallF, .StallD, .StallE, .StallM, .StallW, .FlushD, .FlushE, .FlushM, .FlushW,
     .InstrValidE, .InstrValidD,
     .BranchD, .BranchE, .JumpD, .JumpE, .ICacheStallF,
@@ -182,17 +212,18 @@ module wallypipelinedcore import cvw::*; #(parameter cvw_t P) (
     // Mem
     .CommittedF, .EPCM, .TrapVectorM, .RetM, .TrapM, .InvalidateICacheM, .CSRWriteFenceM,
     .InstrD, .InstrM, .InstrOrigM, .PCM, .InstrClassM, .BPDirPredWrongM,
-    .BTAWrongM, .RASPredPCWrongM, .IClassWrongM,
+    .BTAWrongM, .RASPredPCWrongM, .IndTargetWrongM, .IClassWrongM,
     // Faults out
     .IllegalBaseInstrD, .IllegalFPUInstrD, .InstrPageFaultF, .IllegalIEUFPUInstrD, .InstrMisalignedFaultM,
     // mmu management
     .PrivilegeModeW, .PTE, .PageType, .SATP_REGW, .STATUS_MXR, .STATUS_SUM, .STATUS_MPRV,
-    .STATUS_MPP, .ENVCFG_PBMTE, .ENVCFG_ADUE, .ITLBWriteF, .sfencevmaM, .ITLBMissF,
+    .STATUS_MPP, .ENVCFG_PBMTE, .ENVCFG_ADUE, .ITLBWriteF, .sfencevmaM, .SfenceByVAM, .SfenceByASIDM,
+    .SfenceVAdrM(SrcAM), .SfenceASIDM(WriteDataM[P.ASID_BITS-1:0]), .WritePMPM, .ITLBMissF,
     // pmp/pma (inside mmu) signals. 
     .PMPCFG_ARRAY_REGW,  .PMPADDR_ARRAY_REGW, .InstrAccessFaultF, .InstrUpdateDAF); 
     
   // integer execution unit: integer register file, datapath and controller
-  ieu #(P) ieu(.clk, .reset,
+  ieu #(P) ieu(.clk(PipeClk), .reset,
      // Decode Stage interface
      .InstrD, .STATUS_FS, .ENVCFG_CBE, .IllegalIEUFPUInstrD, .IllegalBaseInstrD,
      // Execute Stage interface
@@ -206,23 +237,23 @@ module wallypipelinedcore import cvw::*; #(parameter cvw_t P) (
      .WriteDataM, // Write data to LSU
      .Funct3M,    // size and signedness to LSU
      .SrcAM,      // to privilege and fpu
-     .RdE, .RdM, .FIntResM, .FlushDCacheM,
+     .RdE, .RdM, .FIntResM, .LoadFwdDataM, .FlushDCacheM,
      .BranchD, .BranchE, .JumpD, .JumpE,
      // Writeback stage
-     .CSRReadValW, .MDUResultW, .FIntDivResultW, .RdW, .ReadDataW(ReadDataW[P.XLEN-1:0]),
+     .CSRReadValM, .CSRReadValW, .MDUResultW, .FIntDivResultW, .RdW, .ReadDataW(ReadDataW[P.XLEN-1:0]),
      .InstrValidM, .InstrValidE, .InstrValidD, .FCvtIntResW, .FCvtIntW,
      // hazards
      .StallD, .StallE, .StallM, .StallW, .FlushD, .FlushE, .FlushM, .FlushW,
-     .StructuralStallD, .LoadStallD, .StoreStallD, .PCSrcE,
+     .StructuralStallD, .LoadStallD, .StoreStallD, .LoadFwdM, .PCSrcE,
      .CSRReadM, .CSRWriteM, .PrivilegedM, .CSRWriteFenceM, .InvalidateICacheM); 
 
   lsu #(P) lsu(
-    .clk, .reset, .StallM, .FlushM, .StallW, .FlushW,
+    .clk(PipeClk), .reset, .StallM, .FlushM, .StallW, .FlushW,
     // CPU interface
     .MemRWE, .MemRWM, .Funct3M, .Funct7M(InstrM[31:25]), .AtomicM,
     .CommittedM, .DCacheMiss, .DCacheAccess, .SquashSCW,            
     .FpLoadStoreM, .FWriteDataM, .IEUAdrE, .IEUAdrM, .WriteDataM,
-    .ReadDataW, .FlushDCacheM, .CMOpM, .LSUPrefetchM,
+    .ReadDataW, .LoadFwdDataM, .FlushDCacheM, .CMOpM, .LSUPrefetchM,
     // connected to ahb (all stay the same)
     .LSUHADDR,  .HRDATA, .LSUHWDATA, .LSUHWSTRB, .LSUHSIZE, 
     .LSUHBURST, .LSUHTRANS, .LSUHWRITE, .LSUHREADY,
@@ -239,6 +270,9 @@ module wallypipelinedcore import cvw::*; #(parameter cvw_t P) (
     .ENVCFG_PBMTE,                // from csr
     .ENVCFG_ADUE,                 // from csr
     .sfencevmaM,                  // connects to privilege
+    .SfenceByVAM, .SfenceByASIDM, // connects to privilege
+    .SfenceVAdrM(SrcAM), .SfenceASIDM(WriteDataM[P.ASID_BITS-1:0]), // rs1 and rs2 of sfence.vma
+    .WritePMPM,                   // connects to privilege
     .DCacheStallM,                // connects to privilege
     .LoadPageFaultM,              // connects to privilege
     .StoreAmoPageFaultM,          // connects to privilege
@@ -249,8 +283,8 @@ module wallypipelinedcore import cvw::*; #(parameter cvw_t P) (
     .StoreAmoMisalignedFaultM,    // connects to privilege
     .StoreAmoAccessFaultM,        // connects to privilege
     .InstrUpdateDAF,
-    .PCSpillF, .ITLBMissF, .PTE, .PageType, .ITLBWriteF, .SelHPTW,
-    .LSUStallM);                    
+    .PCSpillF, .ITLBMissF, .PTE, .PageType, .ITLBWriteF, .DTLBWriteM, .SelHPTW,
+    .HPTWStall, .LSUStallM);                    
 
   if(P.BUS_SUPPORTED) begin : ebu
     ebu #(P) ebu(// IFU connections
@@ -260,10 +294,17 @@ module wallypipelinedcore import cvw::*; #(parameter cvw_t P) (
       // LSU interface
       .LSUHADDR, .LSUHWDATA, .LSUHWSTRB, .LSUHSIZE, .LSUHBURST,
       .LSUHTRANS, .LSUHWRITE, .LSUHREADY,
+      // critical-first arbitration
+      .FetchEmpty(~InstrValidD), .FetchStall(~|MemRWM),
       // BUS interface
       .HREADY, .HRESP, .HCLK, .HRESETn,
       .HADDR, .HWDATA, .HWSTRB, .HWRITE, .HSIZE, .HBURST,
-      .HPROT, .HTRANS, .HMASTLOCK);
+      .HPROT, .HTRANS, .HMASTLOCK,
+      // performance counter events
+      .IFUArbWait, .LSUArbWait);
+  end else begin
+    assign IFUArbWait = 0;
+    assign LSUArbWait = 0;
   end
 
   // global stall and flush control  
@@ -278,18 +319,26 @@ module wallypipelinedcore import cvw::*; #(parameter cvw_t P) (
     .StallF, .StallD, .StallE, .StallM, .StallW,
     .FlushD, .FlushE, .FlushM, .FlushW);    
 
+  // top-down CPI stack accounting for the performance counters
+  if (P.ZICNTR_SUPPORTED) begin:cpistack
+    cpistack #(P) cpistack(.clk, .reset, .StallD, .StallE, .StallM, .StallW, .FlushD, .FlushE, .FlushM, .FlushW,
+      .InstrValidM, .BPWrongE, .TrapM, .RetM, .CSRWriteFenceM, .FPUStallD, .DivBusyE,
+      .LSUStallM, .DCacheStallM, .HPTWStall, .IFUStallF, .ICacheStallF, .wfiM, .IntPendingM,
+      .CPIStackM);
+  end else assign CPIStackM = '0;
+
   // privileged unit
   if (P.ZICSR_SUPPORTED) begin:priv
     privileged #(P) priv(
       .clk, .reset,
       .FlushD, .FlushE, .FlushM, .FlushW, .StallD, .StallE, .StallM, .StallW,
       .CSRReadM, .CSRWriteM, .SrcAM, .PCM, 
-      .InstrM, .InstrOrigM, .CSRReadValW, .EPCM, .TrapVectorM,
-      .RetM, .TrapM, .sfencevmaM, .InvalidateICacheM, .DCacheStallM, .ICacheStallF,
+      .InstrM, .InstrOrigM, .CSRReadValM, .CSRReadValW, .EPCM, .TrapVectorM,
+      .RetM, .TrapM, .InterruptM, .CauseM, .NextFaultMtvalM, .sfencevmaM, .SfenceByVAM, .SfenceByASIDM, .WritePMPM, .InvalidateICacheM, .DCacheStallM, .ICacheStallF,
       .InstrValidM, .CommittedM, .CommittedF,
       .FRegWriteM, .LoadStallD, .StoreStallD,
       .BPDirPredWrongM, .BTAWrongM, .BPWrongM,
-      .RASPredPCWrongM, .IClassWrongM, .DivBusyE, .FDivBusyE,
+      .RASPredPCWrongM, .IndTargetWrongM, .IClassWrongM, .DivBusyE, .FDivBusyE, .IFUArbWait, .LSUArbWait, .AMOM(AtomicM[1]), .CPIStackM, .ITLBWriteF, .DTLBWriteM,
       .InstrClassM, .DCacheMiss, .DCacheAccess, .ICacheMiss, .ICacheAccess, .PrivilegedM,
       .InstrPageFaultF, .LoadPageFaultM, .StoreAmoPageFaultM,
       .InstrMisalignedFaultM, .IllegalIEUFPUInstrD, 
@@ -302,20 +351,27 @@ module wallypipelinedcore import cvw::*; #(parameter cvw_t P) (
       .PMPCFG_ARRAY_REGW, .PMPADDR_ARRAY_REGW, 
       .FRM_REGW, .ENVCFG_CBE, .ENVCFG_PBMTE, .ENVCFG_ADUE, .wfiM, .IntPendingM, .BigEndianM);
   end else begin
+    assign CSRReadValM      = 0;
     assign CSRReadValW      = 0;
     assign EPCM             = 0;
     assign TrapVectorM      = 0;
     assign RetM             = 0;
     assign TrapM            = 0;
+    assign InterruptM       = 0;
+    assign CauseM           = 0;
+    assign NextFaultMtvalM  = 0;
     assign wfiM             = 0;
     assign IntPendingM      = 0;
     assign sfencevmaM       = 0;
+    assign SfenceByVAM      = 0;
+    assign SfenceByASIDM    = 0;
+    assign WritePMPM        = 0;
     assign BigEndianM       = 0;
   end
 
   // multiply/divide unit
   if (P.M_SUPPORTED | P.ZMMUL_SUPPORTED) begin:mdu
-    mdu #(P) mdu(.clk, .reset, .StallM, .StallW, .FlushE, .FlushM, .FlushW,
+    mdu #(P) mdu(.clk(PipeClk), .reset, .StallM, .StallW, .FlushE, .FlushM, .FlushW,
       .ForwardedSrcAE, .ForwardedSrcBE, 
       .Funct3E, .Funct3M, .IntDivE, .W64E, .MDUActiveE,
       .MDUResultW, .DivBusyE); 
@@ -327,7 +383,7 @@ module wallypipelinedcore import cvw::*; #(parameter cvw_t P) (
   // floating point unit
   if (P.F_SUPPORTED) begin:fpu
     fpu #(P) fpu(
-      .clk, .reset,
+      .clk(PipeClk), .reset,
       .FRM_REGW,                           // Rounding mode from CSR
       .InstrD,                             // instruction from IFU
       .ReadDataW(ReadDataW[P.FLEN-1:0]),   // Read data from memory
@@ -361,5 +417,16 @@ module wallypipelinedcore import cvw::*; #(parameter cvw_t P) (
     assign SetFflagsM       = 0;
     assign FpLoadStoreM     = 0;
   end
+
+  // instruction trace encoder
+  if (P.TRACE_SUPPORTED) begin:trace
+    etrace #(P) etrace(.clk, .reset, .TraceEnable, .StallM, .FlushM, .StallW, .FlushW,
+      .InstrValidM, .InstrM, .InstrOrigM, .PCM, .IEUAdrM, .EPCM, .TrapVectorM, .PCSrcE,
+      .TrapM, .RetM, .InterruptM, .CauseM, .NextFaultMtvalM, .PrivilegeModeW,
+      .TraceValid, .TracePacket);
+  end else begin
+    assign TraceValid  = 0;
+    assign TracePacket = 0;
+  end
   
 endmodule
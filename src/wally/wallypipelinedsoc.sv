@@ -58,7 +58,13 @@ module wallypipelinedsoc import cvw::*; #(parameter cvw_t P)  (
   input  logic                SDCIntr,
   input  logic                SPIIn,            // SPI pins in
   output logic                SPIOut,           // SPI pins out
-  output logic [3:0]          SPICS             // SPI chip select pins                    
+  output logic [3:0]          SPICS,            // SPI chip select pins                    
+  input  logic                ETHTXCLK,         // Ethernet MII transmit clock from the PHY
+  output logic [3:0]          ETHTXD,           // Ethernet MII transmit data
+  output logic                ETHTXEN,          // Ethernet MII transmit enable
+  input  logic                ETHRXCLK,         // Ethernet MII receive clock from the PHY
+  input  logic [3:0]          ETHRXD,           // Ethernet MII receive data
+  input  logic                ETHRXDV, ETHRXER  // Ethernet MII receive data valid and error
 );
 
   // Uncore signals
@@ -67,6 +73,23 @@ module wallypipelinedsoc import cvw::*; #(parameter cvw_t P)  (
   logic                       MTimerInt, MSwInt;// timer and software interrupts from CLINT
   logic [63:0]                MTIME_CLINT;      // from CLINT to CSRs
   logic                       MExtInt,SExtInt;  // from PLIC
+  logic                       TraceEnable, TraceValid; // instruction trace
+  logic [255:0]               TracePacket;
+  // core AHB manager, arbitrated against the Ethernet DMA
+  logic [P.PA_BITS-1:0]       CoreHADDR;
+  logic [P.AHBW-1:0]          CoreHWDATA;
+  logic [P.XLEN/8-1:0]        CoreHWSTRB;
+  logic                       CoreHWRITE, CoreHMASTLOCK, CoreHREADY;
+  logic [2:0]                 CoreHSIZE, CoreHBURST;
+  logic [3:0]                 CoreHPROT;
+  logic [1:0]                 CoreHTRANS;
+  // Ethernet DMA manager
+  logic [P.PA_BITS-1:0]       EthHADDR;
+  logic [P.AHBW-1:0]          EthHWDATA;
+  logic [P.XLEN/8-1:0]        EthHWSTRB;
+  logic                       EthHWRITE, EthHREADY;
+  logic [2:0]                 EthHSIZE, EthHBURST;
+  logic [1:0]                 EthHTRANS;
 
   // synchronize reset to SOC clock domain
   synchronizer resetsync(.clk, .d(reset_ext), .q(reset)); 
@@ -74,17 +97,39 @@ module wallypipelinedsoc import cvw::*; #(parameter cvw_t P)  (
   // instantiate processor and internal memories
   wallypipelinedcore #(P) core(.clk, .reset,
     .MTimerInt, .MExtInt, .SExtInt, .MSwInt, .MTIME_CLINT,
-    .HRDATA, .HREADY, .HRESP, .HCLK, .HRESETn, .HADDR, .HWDATA, .HWSTRB,
-    .HWRITE, .HSIZE, .HBURST, .HPROT, .HTRANS, .HMASTLOCK
+    .HRDATA, .HREADY(CoreHREADY), .HRESP, .HCLK, .HRESETn, .HADDR(CoreHADDR), .HWDATA(CoreHWDATA), .HWSTRB(CoreHWSTRB),
+    .HWRITE(CoreHWRITE), .HSIZE(CoreHSIZE), .HBURST(CoreHBURST), .HPROT(CoreHPROT), .HTRANS(CoreHTRANS), .HMASTLOCK(CoreHMASTLOCK),
+    .TraceEnable, .TraceValid, .TracePacket
    );
 
+  // share the bus with the Ethernet DMA
+  if (P.BUS_SUPPORTED & P.ETH_SUPPORTED) begin : dmaarb
+    ahbarb #(P) ahbarb(.HCLK, .HRESETn,
+      .CoreHADDR, .CoreHWDATA, .CoreHWSTRB, .CoreHWRITE, .CoreHSIZE, .CoreHBURST, .CoreHPROT, .CoreHTRANS, .CoreHMASTLOCK, .CoreHREADY,
+      .DMAHADDR(EthHADDR), .DMAHWDATA(EthHWDATA), .DMAHWSTRB(EthHWSTRB), .DMAHWRITE(EthHWRITE), .DMAHSIZE(EthHSIZE),
+      .DMAHBURST(EthHBURST), .DMAHTRANS(EthHTRANS), .DMAHREADY(EthHREADY),
+      .HADDR, .HWDATA, .HWSTRB, .HWRITE, .HSIZE, .HBURST, .HPROT, .HTRANS, .HMASTLOCK, .HREADY);
+  end else begin : dmaarb
+    assign HADDR = CoreHADDR; assign HWDATA = CoreHWDATA; assign HWSTRB = CoreHWSTRB; assign HWRITE = CoreHWRITE;
+    assign HSIZE = CoreHSIZE; assign HBURST = CoreHBURST; assign HPROT = CoreHPROT; assign HTRANS = CoreHTRANS;
+    assign HMASTLOCK = CoreHMASTLOCK; assign CoreHREADY = HREADY; assign EthHREADY = 1'b0;
+  end
+
   // instantiate uncore if a bus interface exists
   if (P.BUS_SUPPORTED) begin : uncore
     uncore #(P) uncore(.HCLK, .HRESETn, .TIMECLK,
       .HADDR, .HWDATA, .HWSTRB, .HWRITE, .HSIZE, .HBURST, .HPROT, .HTRANS, .HMASTLOCK, .HRDATAEXT,
       .HREADYEXT, .HRESPEXT, .HRDATA, .HREADY, .HRESP, .HSELEXT, .HSELEXTSDC,
       .MTimerInt, .MSwInt, .MExtInt, .SExtInt, .GPIOIN, .GPIOOUT, .GPIOEN, .UARTSin, 
-      .UARTSout, .MTIME_CLINT, .SDCIntr, .SPIIn, .SPIOut, .SPICS);
+      .UARTSout, .MTIME_CLINT, .SDCIntr, .SPIIn, .SPIOut, .SPICS,
+      .TraceValid, .TracePacket, .TraceEnable,
+      .ETHTXCLK, .ETHTXD, .ETHTXEN, .ETHRXCLK, .ETHRXD, .ETHRXDV, .ETHRXER,
+      .EthHADDR, .EthHWDATA, .EthHWSTRB, .EthHWRITE, .EthHSIZE, .EthHBURST, .EthHTRANS, .EthHREADY);
+  end else begin : uncore
+    assign TraceEnable = 0;
+    assign ETHTXD = 0; assign ETHTXEN = 0;
+    assign EthHADDR = 0; assign EthHWDATA = 0; assign EthHWSTRB = 0; assign EthHWRITE = 0; assign EthHSIZE = 0;
+    assign EthHBURST = 0; assign EthHTRANS = 0;
   end
 
 endmodule
@@ -137,6 +137,22 @@ if {  $find_clock != [list] } {
     create_clock -period $my_period -name $my_clk
 }
 
+# The PMP cache holds the inputs of its PMP and PMA decoders for two cycles during a fill
+if {[catch {exec grep -E "PMPCACHE_SUPPORTED *= *1" $cfg/config.vh}] == 0} {
+    set pmpfill [get_pins -quiet -hierarchical {*pmpcache/pmppage/* *pmpcache/pmapage/*}]
+    if {[sizeof_collection $pmpfill] > 0} {
+        set_multicycle_path 2 -setup -through $pmpfill
+        set_multicycle_path 1 -hold -through $pmpfill
+    }
+}
+
+# WFI_CLOCKGATE = 1 gates the pipeline clock with clockgater's latch model; swap in the library's integrated
+# clock gate and check the gate enable against the clock
+if {[catch {exec grep -E {WFI_CLOCKGATE *= *(32'd)?1;} $cfg/config.vh}] == 0} {
+    set_clock_gating_style -sequential_cell latch -positive_edge_logic integrated -control_point none
+    replace_clock_gates -global
+    set_clock_gating_check -setup 0.0 -hold 0.0 $current_design
+}
 
 # Optimize paths that are close to critical
 set_critical_range 0.05 $current_design
@@ -28,6 +28,8 @@ if __name__ == '__main__':
     parser.add_argument("-s", "--freqsweep", type=int, help = "Synthesize wally with target frequencies at given MHz and +/- 2, 4, 6, 8 %%")
     parser.add_argument("-c", "--configsweep", action='store_true', help = "Synthesize wally with configurations 32e, 32imc, 64ic, 32gc, and 64gc")
     parser.add_argument("-f", "--featuresweep", action='store_true', help = "Synthesize wally with features turned off progressively to visualize critical path")
+    parser.add_argument("-p", "--pmpcache", action='store_true', help = "Synthesize wally with and without PMP and PMA checks cached in the TLBs")
+    parser.add_argument("-l", "--cachelatency", action='store_true', help = "Synthesize wally with 1- and 2-cycle L1 cache access in each technology (or only --tech)")
 
     parser.add_argument("-v", "--version", choices=allConfigs, help = "Configuration of wally")
     parser.add_argument("-t", "--targetfreq", type=int, help = "Target frequncy")
@@ -58,6 +60,19 @@ if __name__ == '__main__':
         config = args.version if args.version else 'rv64gc'
         for mod in ['noAtomic', 'noFPU', 'noMulDiv', 'noPriv', 'PMP0']: 
             runSynth(config, mod, tech, freq, maxopt, usesram)
+    elif args.pmpcache:
+        defaultfreq = 500 if tech == 'sky90' else 1500
+        freq = args.targetfreq if args.targetfreq else defaultfreq
+        config = args.version if args.version else 'rv64gc'
+        for mod in ['orig', 'PMPCache']:
+            runSynth(config, mod, tech, freq, maxopt, usesram)
+    elif args.cachelatency:
+        config = args.version if args.version else 'rv64gc'
+        for t in ([args.tech] if args.tech else techs):
+            defaultfreq = 500 if t == 'sky90' else 1500
+            freq = args.targetfreq if args.targetfreq else defaultfreq
+            for mod in ['orig', 'CacheLat2']:
+                runSynth(config, mod, t, freq, maxopt, usesram)
     else:
         defaultfreq = 500 if tech == 'sky90' else 1500
         freq = args.targetfreq if args.targetfreq else defaultfreq
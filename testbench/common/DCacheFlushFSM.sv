@@ -50,6 +50,8 @@ module DCacheFlushFSM import cvw::*; #(parameter cvw_t P)
     localparam loglinebytelen = $clog2(linebytelen);
     localparam lognumways     = $clog2(numways);
     localparam tagstart       = lognumlines + loglinebytelen;
+    localparam sectorlen      = linelen/P.DCACHE_SECTORS;
+    localparam wordsectors    = sramlen > sectorlen ? sramlen/sectorlen : 1; // sectors covered by one SRAM word
     
     genvar               index, way, cacheWord;
     logic [sramlen-1:0]  CacheData  [numways-1:0] [numlines-1:0] [cachesramwords-1:0];
@@ -66,8 +68,9 @@ module DCacheFlushFSM import cvw::*; #(parameter cvw_t P)
           copyShadow(.clk,
           .start,
           .tag(testbench.dut.core.lsu.bus.dcache.dcache.CacheWays[way].CacheTagMem.RAM[index][P.PA_BITS-1-tagstart:0]),
-          .valid(testbench.dut.core.lsu.bus.dcache.dcache.CacheWays[way].ValidBits[index]),
-          .dirty(testbench.dut.core.lsu.bus.dcache.dcache.CacheWays[way].DirtyBits[index]),
+          .valid(|testbench.dut.core.lsu.bus.dcache.dcache.CacheWays[way].ValidBits[index][cacheWord*sramlen/sectorlen +: wordsectors]),
+          .dirty(|(testbench.dut.core.lsu.bus.dcache.dcache.CacheWays[way].DirtyBits[index][cacheWord*sramlen/sectorlen +: wordsectors] &
+                   testbench.dut.core.lsu.bus.dcache.dcache.CacheWays[way].ValidBits[index][cacheWord*sramlen/sectorlen +: wordsectors])),
                            // these dirty bit selections would be needed if dirty is moved inside the tag array.
           //.dirty(testbench.dut.core.lsu.bus.dcache.dcache.CacheWays[way].dirty.DirtyMem.RAM[index]),
           //.dirty(testbench.dut.core.lsu.bus.dcache.dcache.CacheWays[way].CacheTagMem.RAM[index][P.PA_BITS+tagstart]),
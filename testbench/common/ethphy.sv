@@ -0,0 +1,98 @@
+///////////////////////////////////////////
+// ethphy.sv
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified:
+//
+// Purpose: Loopback Ethernet PHY model for the MII port.  Supplies the transmit and receive
+//          clocks, returns every transmitted nibble on the receive side one MII clock later, and
+//          measures the frames that pass through.  The statistics are printed when Report rises.
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+//
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied. See the License for the specific language governing permissions
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+module ethphy #(parameter CLKDIV = 8,     // MII clock period in clk cycles; ethmii.sv needs at least 4
+                parameter CLK_MHZ = 100)  // clk frequency used to convert cycles to time
+  (input  logic       clk, reset,
+   output logic       ETHTXCLK, ETHRXCLK,
+   input  logic [3:0] ETHTXD,
+   input  logic       ETHTXEN,
+   output logic [3:0] ETHRXD,
+   output logic       ETHRXDV, ETHRXER,
+   input  logic       Report);
+
+  logic               MiiClk;
+  logic               TxEnD, ReportD;
+  integer             Div;
+  longint             Cycles, FirstStart, LastEnd, Frames, Nibbles;
+  real                Seconds;
+
+  // MII clock
+  always_ff @(posedge clk)
+    if (reset) begin
+      Div    <= 0;
+      MiiClk <= 0;
+    end else if (Div == CLKDIV/2-1) begin
+      Div    <= 0;
+      MiiClk <= ~MiiClk;
+    end else Div <= Div + 1;
+
+  assign ETHTXCLK = MiiClk;
+  assign ETHRXCLK = MiiClk;
+  assign ETHRXER  = 1'b0;
+
+  // loopback: sample the MAC's transmit pins and drive them back on the next rising edge
+  always @(posedge MiiClk) begin
+    ETHRXDV <= ETHTXEN;
+    ETHRXD  <= ETHTXD;
+  end
+
+  // statistics
+  always_ff @(posedge clk)
+    if (reset) Cycles <= 0;
+    else       Cycles <= Cycles + 1;
+
+  always @(posedge MiiClk or posedge reset)
+    if (reset) begin
+      TxEnD   <= 0;
+      Frames  <= 0;
+      Nibbles <= 0;
+    end else begin
+      TxEnD <= ETHTXEN;
+      if (ETHTXEN) Nibbles <= Nibbles + 1;
+      if (ETHTXEN & ~TxEnD) begin
+        if (Frames == 0) FirstStart <= Cycles;
+        Frames <= Frames + 1;
+      end
+      if (~ETHTXEN & TxEnD) LastEnd <= Cycles;
+    end
+
+  always_ff @(posedge clk) begin
+    ReportD <= Report;
+    if (Report & ~ReportD & Frames != 0) begin
+      Seconds = (LastEnd - FirstStart) / (CLK_MHZ * 1.0e6);
+      $display("Ethernet loopback: %0d frames, %0d bytes on the wire including preamble, %0d cycles from first to last frame",
+               Frames, Nibbles/2, LastEnd - FirstStart);
+      $display("Ethernet loopback: %0d cycles per frame, %0.0f frames per second at %0d MHz, %0.1f%% of the MII line rate",
+               (LastEnd - FirstStart) / Frames, Frames / Seconds, CLK_MHZ,
+               100.0 * (Nibbles * CLKDIV) / (LastEnd - FirstStart));
+    end
+  end
+endmodule
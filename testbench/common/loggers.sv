@@ -76,9 +76,33 @@ module loggers import cvw::*; #(parameter cvw_t P,
                             "SFenceVMA",
                             "Interrupt",
                             "Exception",
-                            "Divide Cycles"
+                            "Divide Cycles",
+                            "Indirect Target Wrong",
+                            "IFU Bus Arbitration Wait",
+                            "LSU Bus Arbitration Wait",
+                            "AMO Cycles",
+                            "ITLB Miss",
+                            "DTLB Miss",
+                            "WFI Cycles"
                           };
 
+    // top-down CPI stack, indexed by the cause codes in cpistack.sv
+    string  CPIStackNames[] = '{"Retiring",
+                                "Frontend: I$ miss",
+                                "Frontend: fetch",
+                                "Bad spec: mispredict",
+                                "Bad spec: trap/CSR/fence",
+                                "Backend: D$ miss",
+                                "Backend: TLB walk",
+                                "Backend: LSU bus",
+                                "Backend: dependency",
+                                "Backend: divide",
+                                "Backend: FPU",
+                                "Backend: WFI"
+                               };
+    longint CPIStackCycles[12];
+    longint CPIStackTotal;
+
     if(TEST == "embench") begin
       // embench runs warmup then runs start_trigger
       // embench end with stop_trigger.
@@ -118,13 +142,77 @@ module loggers import cvw::*; #(parameter cvw_t P,
         for(HPMCindex = 0; HPMCindex < 32; HPMCindex += 1) begin
           InitialHPMCOUNTERH[HPMCindex] <= dut.core.priv.priv.csr.counters.counters.HPMCOUNTER_REGW[HPMCindex];
         end
+        CPIStackCycles = '{default: 0};
+      end else begin
+        for(HPMCindex = 0; HPMCindex < 12; HPMCindex += 1)
+          CPIStackCycles[HPMCindex] += dut.core.CPIStackM[HPMCindex];
       end
       if(EndSample) begin
         for(HPMCindex = 0; HPMCindex < HPMCnames.size(); HPMCindex += 1) begin
-          // unlikely to have more than 10M in any counter.
-          $display("Cnt[%2d] = %7d %s", HPMCindex, dut.core.priv.priv.csr.counters.counters.HPMCOUNTER_REGW[HPMCindex] - InitialHPMCOUNTERH[HPMCindex], HPMCnames[HPMCindex]);
+          // unlikely to have more than 10M in any counter.  A counter may count a CPI stack cause selected by mhpmevent.
+          $display("Cnt[%2d] = %7d %s", HPMCindex, dut.core.priv.priv.csr.counters.counters.HPMCOUNTER_REGW[HPMCindex] - InitialHPMCOUNTERH[HPMCindex],
+                   dut.core.priv.priv.csr.counters.counters.MHPMEVENT_REGW[HPMCindex] == 0 ? HPMCnames[HPMCindex] :
+                   {"CPI stack ", CPIStackNames[dut.core.priv.priv.csr.counters.counters.MHPMEVENT_REGW[HPMCindex] - 1]});
+        end
+        // CPI stack: each cause's cycles divided by instructions retired
+        CPIStackTotal = CPIStackCycles.sum();
+        $display("CPI stack: CPI = %0.3f over %0d cycles", real'(CPIStackTotal) / real'(CPIStackCycles[0]), CPIStackTotal);
+        for(HPMCindex = 0; HPMCindex < 12; HPMCindex += 1)
+          $display("CPI[%2d] = %7.3f %s", HPMCindex, real'(CPIStackCycles[HPMCindex]) / real'(CPIStackCycles[0]), CPIStackNames[HPMCindex]);
+      end
+    end
+  end
+
+  // CSR writes and fences that retired without flushing the pipeline
+  if (PrintHPMCounters & P.ZICNTR_SUPPORTED) begin : FlushLogger
+    longint NoFlushCSRWrites, NoFlushFences;
+    always @(negedge clk) begin
+      if(StartSample) {NoFlushCSRWrites, NoFlushFences} = '0;
+      else if (dut.core.priv.priv.csr.InstrValidNotFlushedM & ~dut.core.CSRWriteFenceM) begin
+        NoFlushCSRWrites += dut.core.CSRWriteM;
+        NoFlushFences += (dut.core.InstrM[6:0] == 7'b0001111) & (dut.core.InstrM[14:12] == 3'b000);
+      end
+      if(EndSample)
+        $display("Pipeline flushes avoided: %0d CSR writes, %0d fences", NoFlushCSRWrites, NoFlushFences);
+    end
+  end
+
+  // TLB misses over the sample, to measure the cost of sfence.vma across context switches
+  if (PrintHPMCounters & P.ZICNTR_SUPPORTED & P.VIRTMEM_SUPPORTED) begin : TLBLogger
+    longint ITLBFills, DTLBFills, Retired;
+    always @(negedge clk) begin
+      if(StartSample) {ITLBFills, DTLBFills, Retired} = '0;
+      else begin
+        ITLBFills += dut.core.ITLBWriteF;
+        DTLBFills += dut.core.lsu.DTLBWriteM;
+        Retired += dut.core.priv.priv.csr.InstrValidNotFlushedM;
+      end
+      if(EndSample & Retired > 0)
+        $display("TLB misses: ITLB = %0d (%0.3f per 1000 instructions), DTLB = %0d (%0.3f per 1000 instructions)",
+                 ITLBFills, 1000.0 * ITLBFills / Retired, DTLBFills, 1000.0 * DTLBFills / Retired);
+    end
+  end
+
+  // WFI wake-up latency: cycles from the interrupt becoming pending to the first instruction after the WFI retiring
+  if (PrintHPMCounters & P.ZICNTR_SUPPORTED) begin : WFILogger
+    longint WakeLatency, WakeLatencyTotal, WakeLatencyMax, Wakeups;
+    logic   Waking;
+    always @(negedge clk) begin
+      if(StartSample) {WakeLatencyTotal, WakeLatencyMax, Wakeups, Waking} = '0;
+      else if (Waking) begin
+        WakeLatency++;
+        if (dut.core.priv.priv.csr.InstrValidNotFlushedM & ~dut.core.wfiM) begin
+          Waking = 0;
+          Wakeups++;
+          WakeLatencyTotal += WakeLatency;
+          if (WakeLatency > WakeLatencyMax) WakeLatencyMax = WakeLatency;
         end
+      end else if (dut.core.wfiM & dut.core.IntPendingM) begin
+        Waking = 1;
+        WakeLatency = 0;
       end
+      if(EndSample & Wakeups > 0)
+        $display("WFI wake-ups: %0d, latency average %0.1f cycles, max %0d cycles", Wakeups, real'(WakeLatencyTotal) / real'(Wakeups), WakeLatencyMax);
     end
   end
 
@@ -154,7 +242,7 @@ module loggers import cvw::*; #(parameter cvw_t P,
     string AccessTypeString, HitMissString;
     always @(*) begin
       HitMissString = dut.core.ifu.bus.icache.icache.CacheHit ? "H" :
-                      dut.core.ifu.bus.icache.icache.vict.cacheLRU.AllValid ? "E" : "M";
+                      (&dut.core.ifu.bus.icache.icache.ValidWay) ? "E" : "M";
     end
     always @(posedge clk) begin
     if(resetEdge) $fwrite(file, "TRAIN\n");
@@ -179,7 +267,7 @@ module loggers import cvw::*; #(parameter cvw_t P,
     assign resetEdge = ~reset & resetD;
     always @(*) begin
       HitMissString = dut.core.lsu.bus.dcache.dcache.CacheHit ? "H" :
-                      (!dut.core.lsu.bus.dcache.dcache.vict.cacheLRU.AllValid) ? "M" :
+                      (!(&dut.core.lsu.bus.dcache.dcache.ValidWay) | dut.core.lsu.bus.dcache.dcache.SectorMiss) ? "M" :
                       dut.core.lsu.bus.dcache.dcache.LineDirty ? "D" : "E";
       AccessTypeString = dut.core.lsu.bus.dcache.FlushDCache ? "F" :
                          dut.core.lsu.LSUAtomicM[1] ? "A" :
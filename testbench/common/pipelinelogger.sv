@@ -0,0 +1,144 @@
+///////////////////////////////////////////
+// pipelinelogger.sv
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified:
+//
+// Purpose: Write a cycle-by-cycle pipeline trace in the Kanata 0004 format read by the Konata
+//          pipeline viewer.  Every fetch slot becomes an instruction that moves through the
+//          F, D, E, M, and W stages as the hazard unit's stalls and flushes dictate.  Instructions
+//          leaving W are retired; those squashed earlier are shown as flushed, with the reason.
+//          Stall causes are attached to the instruction in the stage responsible for the stall,
+//          and the stall cycles per cause are summarized at the end of the simulation.
+//          embench and coremark are traced only between their start and stop triggers.
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+//
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied. See the License for the specific language governing permissions
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+module pipelinelogger import cvw::*; #(parameter cvw_t P,
+                                       parameter string TEST) (
+  input logic clk,
+  input logic reset
+);
+
+  localparam F = 0, D = 1, E = 2, M = 3, W = 4;
+  string     StageNames[5] = '{"F", "D", "E", "M", "W"};
+
+  int        file;
+  int        Id[5];             // instruction in each stage; -1 for a bubble or an untraced instruction
+  int        NextId, RetireId;
+  longint    Cycle;
+  logic      Tracing;
+  logic      Stall[5], Flush[5];
+  string     Cause[5], LastCause[5];
+  string     FlushReason, InstrDName;
+  int        StallCycles[string];
+
+  // The stage responsible for each stall, and why.  Stalls of later stages win because they stall
+  // everything behind them.
+  always_comb begin
+    Stall = '{dut.core.StallF, dut.core.StallD, dut.core.StallE, dut.core.StallM, dut.core.StallW};
+    Flush = '{1'b0, dut.core.FlushD, dut.core.FlushE, dut.core.FlushM, dut.core.FlushW};
+    Cause = '{"", "", "", "", ""};
+    if (dut.core.hzu.IFUStallF & ~dut.core.hzu.FlushDCause)
+      Cause[F] = dut.core.ICacheStallF ? "I$ miss" : dut.core.ifu.BusStall ? "IFU bus" : "IFU";
+    if (dut.core.hzu.LSUStallM & ~dut.core.hzu.FlushWCause)
+      Cause[M] = dut.core.DCacheStallM ? "D$ miss" : dut.core.lsu.HPTWStall ? "page table walk" :
+                 dut.core.lsu.LSUBusStallM ? "LSU bus" : "LSU";
+    else if (dut.core.hzu.WFIStallM & ~dut.core.hzu.FlushMCause) Cause[M] = "WFI";
+    if (dut.core.hzu.StallECause) Cause[E] = dut.core.hzu.DivBusyE ? "divide" : "FP divide";
+    if (dut.core.hzu.StallDCause)
+      Cause[D] = dut.core.ieu.c.LoadStallD ? "load use" : dut.core.ieu.c.StoreStallD ? "load after store" :
+                 dut.core.ieu.c.CSRRdStallD ? "CSR read" : dut.core.ieu.c.MDUStallD ? "multiply/divide result" :
+                 dut.core.ieu.c.FCvtIntStallD ? "FP to integer" : "FPU";
+    FlushReason = dut.core.TrapM ? "trap" : dut.core.RetM ? "trap return" :
+                  dut.core.CSRWriteFenceM ? "CSR write or fence" : dut.core.BPWrongE ? "branch mispredict" : "flush";
+  end
+
+  instrNameDecTB ddec(dut.core.ifu.InstrD, InstrDName);
+
+  // Trace embench and coremark from their start trigger to their stop trigger; other tests from reset
+  if (TEST == "embench" | TEST == "coremark") begin
+    string StartName, StopName;
+    assign StartName = TEST == "embench" ? "start_trigger" : "start_time";
+    assign StopName = TEST == "embench" ? "stop_trigger" : "stop_time";
+    always @(posedge clk)
+      if (reset) Tracing <= 0;
+      else if (FunctionName.FunctionName.FunctionName == StartName) Tracing <= 1;
+      else if (FunctionName.FunctionName.FunctionName == StopName) Tracing <= 0;
+  end else assign Tracing = ~reset;
+
+  initial begin
+    file = $fopen("konata.log", "w");
+    $fwrite(file, "Kanata\t0004\nC=\t0\n");
+    Id = '{-1, -1, -1, -1, -1};
+    NextId = 0;
+    RetireId = 0;
+    Cycle = 0;
+  end
+
+  // Dut registers update #1 after the clock edge, so they still hold this cycle's values here
+  always @(posedge clk) begin
+    int NewId[5];
+    Cycle++;
+    $fwrite(file, "C\t1\n");
+    if (reset) Id = '{-1, -1, -1, -1, -1};
+    else begin
+      // stall causes: note the cause on the responsible instruction when it changes, and count cycles
+      for (int s = F; s <= W; s++) begin
+        if (Cause[s] != "") begin
+          StallCycles[Cause[s]]++;
+          if (Id[s] >= 0 & Cause[s] != LastCause[s])
+            $fwrite(file, "L\t%0d\t1\t%s stall: %s at cycle %0d\n", Id[s], StageNames[s], Cause[s], Cycle);
+        end
+        LastCause[s] = Cause[s];
+      end
+      // label instructions with their address and name as they leave Decode
+      if (Id[D] >= 0 & ~Stall[D])
+        $fwrite(file, "L\t%0d\t0\t%h: %s (%h)\n", Id[D], dut.core.ifu.PCD, InstrDName, dut.core.ifu.InstrD);
+      // W retires when it advances.  Each other stage passes its instruction on unless the next
+      // stage flushes, in which case the instruction is squashed.
+      if (Id[W] >= 0 & ~Stall[W]) $fwrite(file, "R\t%0d\t%0d\t0\n", Id[W], RetireId++);
+      for (int s = W; s > F; s--) NewId[s] = Stall[s] ? Id[s] : Flush[s] ? -1 : Id[s-1];
+      for (int s = F; s < W; s++)
+        if (Id[s] >= 0 & ~Stall[s] & Flush[s+1]) begin
+          if (s == F) $fwrite(file, "L\t%0d\t0\t%h: (fetch)\n", Id[F], dut.core.ifu.PCF);
+          $fwrite(file, "L\t%0d\t1\tflushed from %s: %s\n", Id[s], StageNames[s], FlushReason);
+          $fwrite(file, "R\t%0d\t%0d\t1\n", Id[s], RetireId++);
+        end
+      // a new fetch slot begins whenever Fetch advances
+      if (~Stall[F]) begin
+        if (Tracing) begin
+          NewId[F] = NextId++;
+          $fwrite(file, "I\t%0d\t%0d\t0\n", NewId[F], NewId[F]);
+        end else NewId[F] = -1;
+      end else NewId[F] = Id[F];
+      for (int s = F; s <= W; s++)
+        if (NewId[s] >= 0 & NewId[s] != Id[s]) $fwrite(file, "S\t%0d\t0\t%s\n", NewId[s], StageNames[s]);
+      Id = NewId;
+    end
+  end
+
+  final begin
+    $display("Pipeline trace: %0d instructions retired in konata.log. Stall cycles by cause:", RetireId);
+    foreach (StallCycles[c]) $display("  %-24s %0d", c, StallCycles[c]);
+    $fclose(file);
+  end
+endmodule
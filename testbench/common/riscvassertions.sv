@@ -19,6 +19,8 @@
 // and limitations under the License.
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
+`include "CacheReplacementType.vh"
+
 module riscvassertions import cvw::*; #(parameter cvw_t P);
   initial begin
     assert (P.PMP_ENTRIES == 0 || P.PMP_ENTRIES==16 || P.PMP_ENTRIES==64) else $fatal(1, "Illegal number of PMP entries: PMP_ENTRIES must be 0, 16, or 64");
@@ -39,6 +41,14 @@ module riscvassertions import cvw::*; #(parameter cvw_t P);
     assert (2**$clog2(P.DCACHE_WAYSIZEINBYTES) == P.DCACHE_WAYSIZEINBYTES || (!P.DCACHE_SUPPORTED)) else $fatal(1, "DCACHE_WAYSIZEINBYTES must be a power of 2");
     assert (2**$clog2(P.ICACHE_LINELENINBITS) == P.ICACHE_LINELENINBITS || (!P.ICACHE_SUPPORTED)) else $fatal(1, "ICACHE_LINELENINBITS must be a power of 2");
     assert (2**$clog2(P.ICACHE_WAYSIZEINBYTES) == P.ICACHE_WAYSIZEINBYTES || (!P.ICACHE_SUPPORTED)) else $fatal(1, "ICACHE_WAYSIZEINBYTES must be a power of 2");
+    assert (P.DCACHE_REPLACEMENT <= `REPL_RANDOM && P.ICACHE_REPLACEMENT <= `REPL_RANDOM) else $fatal(1, "DCACHE_REPLACEMENT and ICACHE_REPLACEMENT must be one of the REPL_ types in CacheReplacementType.vh");
+    assert (P.DCACHE_REPLACEMENT != `REPL_LRU || P.DCACHE_NUMWAYS <= 4 || (!P.DCACHE_SUPPORTED)) else $fatal(1, "True LRU replacement supports at most 4 ways; use REPL_PLRU for DCACHE_NUMWAYS > 4");
+    assert (P.ICACHE_REPLACEMENT != `REPL_LRU || P.ICACHE_NUMWAYS <= 4 || (!P.ICACHE_SUPPORTED)) else $fatal(1, "True LRU replacement supports at most 4 ways; use REPL_PLRU for ICACHE_NUMWAYS > 4");
+    assert (2**$clog2(P.DCACHE_SECTORS) == P.DCACHE_SECTORS || (!P.DCACHE_SUPPORTED)) else $fatal(1, "DCACHE_SECTORS must be a power of 2");
+    assert (2**$clog2(P.LOOPBUF_ENTRIES) == P.LOOPBUF_ENTRIES || (!P.LOOPBUF_SUPPORTED)) else $fatal(1, "LOOPBUF_ENTRIES must be a power of 2");
+    assert (P.ICACHE_SUPPORTED || (!P.LOOPBUF_SUPPORTED)) else $fatal(1, "The loop buffer requires the I$");
+    assert (P.IBTB_SIZE == 0 || P.IBTB_SIZE >= 3) else $fatal(1, "IBTB_SIZE must be 0 or at least 3 because the path history shifts by two per jump");
+    assert (P.DCACHE_SECTORS == 1 || (P.DCACHE_LINELENINBITS/P.DCACHE_SECTORS >= 2*P.AHBW && P.DCACHE_LINELENINBITS/P.DCACHE_SECTORS >= P.LLEN) || (!P.DCACHE_SUPPORTED)) else $fatal(1, "D$ sectors must hold at least two AHBW beats and one LLEN word");
     assert (2**$clog2(P.ITLB_ENTRIES) == P.ITLB_ENTRIES || P.VIRTMEM_SUPPORTED==0) else $fatal(1, "ITLB_ENTRIES must be a power of 2");
     assert (2**$clog2(P.DTLB_ENTRIES) == P.DTLB_ENTRIES || P.VIRTMEM_SUPPORTED==0) else $fatal(1, "DTLB_ENTRIES must be a power of 2");
     assert (P.UNCORE_RAM_RANGE >= 64'h07FFFFFF) else $warning("Some regression tests will fail if UNCORE_RAM_RANGE is less than 64'h07FFFFFF");
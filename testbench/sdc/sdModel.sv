@@ -37,15 +37,29 @@ module    sdModel
    reg 	      cardIdentificationState;
    reg 	      CardTransferActive;
    reg [2:0]  BusWidth;
+   reg [3:0]  AccessMode;   // CMD6 function group 1: 0 default speed, 1 high speed
 
    assign cmd = oeCmd ? cmdOut : 1'bz;
    assign dat = oeDat ? datOut : 4'bz;
 
    reg 	      InbuffStatus;
-   reg [32:0] ByteAddr;
+   reg [40:0] ByteAddr;   // 32-bit block argument << 9, so cards up to 2 TB
    reg [7:0]  Inbuff [0:511];
-   reg [7:0]  FLASHmem [logic[32:0]];
+   reg [7:0]  FLASHmem [logic[40:0]];
    reg [7:0]  wide_data [0:63];
+
+   // Card contents come from a raw disk image given with +SDIMG=<file>, mapped through DPI-C
+   // (sdimg.c) and accessed a block at a time.  +SDIMGCOW keeps writes in simulator memory instead
+   // of the file.  Without an image the card is FLASHmem, which the testbench may preload.
+   import "DPI-C" function longint sdimg_open(input string path, input int cow);
+   import "DPI-C" function void sdimg_read(input longint blk, output byte unsigned data[0:511]);
+   import "DPI-C" function void sdimg_write(input longint blk, input byte unsigned data[0:511]);
+
+   longint    SdImgBlocks = 0;
+   longint    ImgBlk = -1;              // block held in ImgBuf
+   byte unsigned ImgBuf [0:511];
+   byte unsigned ImgWrBuf [0:511];
+   reg [7:0]  CardOut;                 // card byte at write_out_index
    
    
 
@@ -141,6 +155,29 @@ module    sdModel
 
    reg 	     q_start_bit;
    
+   initial begin
+      string SdImgFile;
+      if ($value$plusargs("SDIMG=%s", SdImgFile)) begin
+	 SdImgBlocks = sdimg_open(SdImgFile, $test$plusargs("SDIMGCOW"));
+	 if (SdImgBlocks == 0) begin
+	    $display("*E Could not map SD card image %s", SdImgFile);
+	    $finish;
+	 end
+	 $display("SD card image %s: %0d blocks%s", SdImgFile, SdImgBlocks, $test$plusargs("SDIMGCOW") ? ", copy on write" : "");
+      end
+   end
+
+   function [7:0] CardByte(input [40:0] Adr);
+      if (SdImgBlocks != 0) begin
+	 if (ImgBlk != Adr[40:9]) begin
+	    sdimg_read(Adr[40:9], ImgBuf);
+	    ImgBlk = Adr[40:9];
+	 end
+	 CardByte = ImgBuf[Adr[8:0]];
+      end
+      else CardByte = FLASHmem[Adr];
+   endfunction
+
    //Card initialization DAT contents
    //initial $readmemh(SD_FILE, FLASHmem);
 
@@ -308,6 +345,7 @@ module    sdModel
       datOut<=0;
       inCmd<=0;
       BusWidth<=1;
+      AccessMode<=0;
       responseType=0;
       mult_read=0;
       mult_write=0;
@@ -590,8 +628,16 @@ module    sdModel
 			 response_CMD[127:96] <= CardStatus ;
 			 response_S<=48;
 			 BLOCK_WIDTH <= 11'd148;
-			 $fdisplay(sdModel_file_desc, "**Error Invalid CMD, %h",inCmd[45:40]);
-			 $display(sdModel_file_desc, "**Error Invalid CMD, %h",inCmd[45:40]);         
+			 // Group 1 selects the access mode; 0xF keeps the current one.  Bit 31 switches,
+			 // otherwise the status only reports what would be selected.  Status byte 16
+			 // holds the selected group 1 function.
+			 if (inCmd[11:8] == 4'hF) wide_data[16] <= {4'h0, AccessMode};
+			 else if (inCmd[11:8] <= 4'h1) begin
+			    wide_data[16] <= {4'h0, inCmd[11:8]};
+			    if (inCmd[39]) AccessMode <= inCmd[11:8];
+			 end
+			 else wide_data[16] <= 8'h0F;  // unsupported function
+			 $display("**CMD6 %s access mode %0d", inCmd[39] ? "switch to" : "check", inCmd[11:8]);
 		      end
 		      else begin
 			 response_S <= 0;
@@ -915,6 +961,7 @@ module    sdModel
 	end
 	
 	WRITE_DATA: begin
+	   if (BLOCK_WIDTH == 11'd1044) CardOut = CardByte(ByteAddr+(write_out_index));
 	   oeDat<=1;
 	   outdly_cnt<=outdly_cnt+1;
 	   datOut <= 4'b1111; // listen... until I tell you otherwise, DAT bus is all high (thanks Ross)
@@ -936,8 +983,8 @@ module    sdModel
 	   
 	   if (transf_cnt==1) begin  // first nibble
               if (BLOCK_WIDTH == 11'd1044) begin
-		 last_din <= FLASHmem[ByteAddr+(write_out_index)][7:4]; // LOAD register with upper nibble
-		 crcDat_in<= FLASHmem[ByteAddr+(write_out_index)][7:4];  // LOAD CRC16 with upper nibble
+		 last_din <= CardOut[7:4]; // LOAD register with upper nibble
+		 crcDat_in<= CardOut[7:4];  // LOAD CRC16 with upper nibble
 	      end
 	      else begin
 		 // code for wide width data
@@ -952,8 +999,8 @@ module    sdModel
               data_send_index<=~data_send_index; //toggle
               if (!data_send_index) begin //upper nibble
 		 if (BLOCK_WIDTH == 11'd1044) begin
-		    last_din <= FLASHmem[ByteAddr+(write_out_index)][7:4]; // LOAD register with upper nibble
-		    crcDat_in<= FLASHmem[ByteAddr+(write_out_index)][7:4];  // LOAD CRC16 with upper nibble
+		    last_din <= CardOut[7:4]; // LOAD register with upper nibble
+		    crcDat_in<= CardOut[7:4];  // LOAD CRC16 with upper nibble
 		 end
 		 else begin
 		    // code for wide width data
@@ -963,14 +1010,14 @@ module    sdModel
               end // if (!data_send_index)
               else begin //lower nibble
 		 if (BLOCK_WIDTH == 11'd1044) begin
-		    last_din<=FLASHmem[ByteAddr+(write_out_index)][3:0];
+		    last_din<=CardOut[3:0];
 		 end
 		 else begin
 		    last_din <= wide_data[write_out_index][3:0];
 		 end		 
 		 if (!add_wrong_data_crc)
 		   if (BLOCK_WIDTH == 11'd1044) begin
-		      crcDat_in<= FLASHmem[ByteAddr+(write_out_index)][3:0];
+		      crcDat_in<= CardOut[3:0];
 		   end
 		   else begin
 		      crcDat_in <= wide_data[write_out_index][3:0];
@@ -1003,6 +1050,7 @@ module    sdModel
 	   end // if (transf_cnt>`BIT_BLOCK-`CRC_OFF & crc_c!=0)
 	   else if (transf_cnt==BLOCK_WIDTH-2) begin     // if (transf_cnt = 1042) Last CRC16 bit is 1041
               datOut<=4'b1111;          // send end bits
+	      if (mult_read) ByteAddr <= ByteAddr + 512; // READ_MULTIPLE_BLOCKS continues with the next block
 	   end
 	   else if ((transf_cnt !=0) & (crc_c == 0 ))begin // if sent data bits and crc_c points past last bit of CRC
               oeDat<=0; // disable output on DAT bus
@@ -1037,14 +1085,22 @@ module    sdModel
 	      datOut[0]<=0;
 	      
 	      flash_blockwrite_cnt<=flash_blockwrite_cnt+2;
-	      FLASHmem[ByteAddr+(flash_blockwrite_cnt)]=Inbuff[flash_blockwrite_cnt];
-	      FLASHmem[ByteAddr+(flash_blockwrite_cnt+1)]=Inbuff[flash_blockwrite_cnt+1];
+	      if (SdImgBlocks == 0) begin
+		 FLASHmem[ByteAddr+(flash_blockwrite_cnt)]=Inbuff[flash_blockwrite_cnt];
+		 FLASHmem[ByteAddr+(flash_blockwrite_cnt+1)]=Inbuff[flash_blockwrite_cnt+1];
+	      end
+	      else if (flash_write_cnt == 7) begin // whole block at once
+		 foreach (ImgWrBuf[j]) ImgWrBuf[j] = Inbuff[j];
+		 sdimg_write(ByteAddr[40:9], ImgWrBuf);
+		 if (ImgBlk == ByteAddr[40:9]) ImgBlk = -1;
+	      end
 	   end
 	   
 	   else begin
 	      datOut<=1;      
 	      InbuffStatus<=0;
 	      CardStatus[12:9] <= `TRAN;
+	      if (mult_write & flash_write_cnt == 264) ByteAddr <= ByteAddr + 512; // WRITE_MULTIPLE_BLOCKS continues with the next block
 	   end // else: !if((flash_write_cnt >= 7) & (flash_write_cnt < 264))   
 	end // case: WRITE_FLASH
       endcase // case (dataState)
@@ -1081,6 +1137,7 @@ module    sdModel
 	 datOut<=0;
 	 inCmd<=0;
 	 BusWidth<=1;
+	 AccessMode<=0;
 	 responseType=0;
 	 crcIn<=0;
 	 response_S<=0;
@@ -0,0 +1,308 @@
+///////////////////////////////////////////
+// sdc_bench.sv
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified:
+//
+// Purpose: DMA throughput benchmark for the FPGA SD card controller (fpga/src/axi_sdc_controller.v).
+//          The controller talks to sdModel over a 4-bit bus and DMAs to a memory model whose
+//          read data and write responses take MEMLAT cycles, like DDR behind the AXI crossbar.
+//          After bringing up the card the bench times a multi-block read (CMD18) and write
+//          (CMD25) at each SD clock divider in DIVS and prints MB/s, the average DMA burst
+//          length and the cycles the SD clock was held back because the FIFO was full or empty.
+//          Every DMA burst is checked against the 256-beat and 4KB limits of AXI4, and the data
+//          read is checked against what was put on the card.  With +SDIMG=<file> +SDIMGCOW the
+//          card holds a raw disk image (sdimg.c) instead of a generated pattern.
+//          Run with sdc_bench.do or do wally.do <config> sdc [image].
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+//
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied. See the License for the specific language governing permissions
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+`timescale 1ns / 1ps
+
+module sdc_bench #(
+  parameter CLK_MHZ        = 50,            // controller clock; the SD clock is CLK_MHZ / (2 * (div + 1))
+  parameter FIFO_ADDR_BITS = 9,
+  parameter MEMLAT         = 80,            // DMA memory latency in controller cycles
+  parameter BLOCKS         = 64,            // blocks per timed transfer
+  parameter DMA_ADR        = 32'h0000_0f00, // deliberately 256 bytes below a 4KB boundary
+  parameter NDIVS          = 4,
+  parameter [8*NDIVS-1:0] DIVS = {8'd0, 8'd1, 8'd3, 8'd7}
+);
+
+  localparam MEMWORDS = 65536;              // 256KB of DMA memory from address 0
+  localparam real CLK_PERIOD = 1000.0 / CLK_MHZ;
+
+  // controller registers, as in struct sdc_regs in tests/custom/boot/boot.c
+  localparam REG_ARGUMENT = 8'h00, REG_COMMAND = 8'h04, REG_RESP0 = 8'h08, REG_DATA_TIMEOUT = 8'h18,
+             REG_CONTROL = 8'h1C, REG_CMD_TIMEOUT = 8'h20, REG_CLOCK_DIV = 8'h24, REG_RESET = 8'h28,
+             REG_CMD_ISR = 8'h34, REG_DATA_ISR = 8'h3C, REG_BLKSIZE = 8'h44, REG_BLKCNT = 8'h48,
+             REG_DMA_ADR = 8'h60;
+
+  // command register response types
+  localparam R_NONE = 8'h00, R1 = 8'h19, R1B = 8'h1D, R2 = 8'h0A, R3 = 8'h01, R6 = 8'h1D, R7 = 8'h19;
+
+  logic        clk = 0, resetn = 0;
+  logic [15:0] s_awaddr, s_araddr;
+  logic [31:0] s_wdata, s_rdata;
+  logic        s_awvalid, s_awready, s_wvalid, s_wready, s_bvalid, s_bready;
+  logic        s_arvalid, s_arready, s_rvalid, s_rready;
+  logic [1:0]  s_bresp, s_rresp;
+  logic [31:0] m_awaddr, m_araddr, m_wdata, m_rdata;
+  logic [7:0]  m_awlen, m_arlen;
+  logic        m_awvalid, m_awready, m_wlast, m_wvalid, m_wready, m_bvalid, m_bready;
+  logic        m_arvalid, m_arready, m_rlast, m_rvalid, m_rready;
+  logic        sdio_clk, sdio_reset, interrupt;
+  logic        sd_cmd_reg_t, sd_cmd_reg_o, sd_dat_reg_t;
+  logic [3:0]  sd_dat_reg_o;
+  tri1         sd_cmd;
+  tri1 [3:0]   sd_dat;
+
+  always #(CLK_PERIOD / 2) clk = ~clk;
+
+  sdc_controller #(.fifo_addr_bits(FIFO_ADDR_BITS)) dut (
+    .clock(clk), .async_resetn(resetn),
+    .s_axi_awaddr(s_awaddr), .s_axi_awvalid(s_awvalid), .s_axi_awready(s_awready),
+    .s_axi_wdata(s_wdata), .s_axi_wvalid(s_wvalid), .s_axi_wready(s_wready),
+    .s_axi_bresp(s_bresp), .s_axi_bvalid(s_bvalid), .s_axi_bready(s_bready),
+    .s_axi_araddr(s_araddr), .s_axi_arvalid(s_arvalid), .s_axi_arready(s_arready),
+    .s_axi_rdata(s_rdata), .s_axi_rresp(s_rresp), .s_axi_rvalid(s_rvalid), .s_axi_rready(s_rready),
+    .m_axi_awaddr(m_awaddr), .m_axi_awlen(m_awlen), .m_axi_awvalid(m_awvalid), .m_axi_awready(m_awready),
+    .m_axi_wdata(m_wdata), .m_axi_wlast(m_wlast), .m_axi_wvalid(m_wvalid), .m_axi_wready(m_wready),
+    .m_axi_bresp(2'b00), .m_axi_bvalid(m_bvalid), .m_axi_bready(m_bready),
+    .m_axi_araddr(m_araddr), .m_axi_arlen(m_arlen), .m_axi_arvalid(m_arvalid), .m_axi_arready(m_arready),
+    .m_axi_rdata(m_rdata), .m_axi_rlast(m_rlast), .m_axi_rresp(2'b00), .m_axi_rvalid(m_rvalid),
+    .m_axi_rready(m_rready),
+    .sdio_clk(sdio_clk), .sdio_reset(sdio_reset), .sdio_cd(1'b1),
+    .sd_dat_reg_t(sd_dat_reg_t), .sd_dat_reg_o(sd_dat_reg_o), .sd_dat_i(sd_dat),
+    .sd_cmd_reg_t(sd_cmd_reg_t), .sd_cmd_reg_o(sd_cmd_reg_o), .sd_cmd_i(sd_cmd),
+    .interrupt(interrupt));
+
+  // pads: T high is tristate, as for the IOBUFs in fpgaTop
+  assign sd_cmd = sd_cmd_reg_t ? 1'bz : sd_cmd_reg_o;
+  assign sd_dat = sd_dat_reg_t ? 4'bz : sd_dat_reg_o;
+
+  sdModel card(.sdClk(sdio_clk), .cmd(sd_cmd), .dat(sd_dat));
+
+  ///////////////////////////////////////////
+  // DMA memory.  Addresses are accepted at once; write responses and read data follow MEMLAT
+  // cycles after the last write beat or the read address.
+  ///////////////////////////////////////////
+
+  logic [31:0] mem [0:MEMWORDS-1];
+  logic [31:0] wadrq[$], radrq[$];
+  logic [7:0]  rlenq[$];
+  longint      bdueq[$], rdueq[$];
+  longint      cycle = 0;
+  logic [31:0] radr;
+  logic [8:0]  rbeat;
+  logic        rbusy;
+  longint      bursts, beats, throttle;
+
+  always @(posedge clk) cycle <= cycle + 1;
+
+  assign m_awready = 1'b1;
+  assign m_arready = 1'b1;
+  assign m_rvalid  = rbusy;
+  assign m_rdata   = mem[radr[17:2]];
+  always_comb begin
+    m_wready = wadrq.size() != 0;
+    m_bvalid = bdueq.size() != 0 && bdueq[0] <= cycle;
+    m_rlast  = rbusy && rbeat == rlenq[0];
+  end
+
+  // card contents; the DMA stores the first byte of each word in its low byte
+  function automatic logic [7:0] pattern(input int adr);
+    return adr * 37 + (adr >> 9);
+  endfunction
+
+  task automatic checkburst(input logic [31:0] adr, input logic [7:0] len);
+    if (adr[11:0] + (len + 1) * 4 > 4096) $error("DMA burst at %h of %0d beats crosses a 4KB boundary", adr, len + 1);
+    bursts++;
+    beats += len + 1;
+  endtask
+
+  always @(posedge clk) begin
+    if (m_awvalid && m_awready) begin
+      checkburst(m_awaddr, m_awlen);
+      wadrq.push_back(m_awaddr);
+    end
+    if (m_wvalid && m_wready) begin
+      mem[wadrq[0][17:2]] <= m_wdata;
+      wadrq[0] = wadrq[0] + 4;
+      if (m_wlast) begin
+        void'(wadrq.pop_front());
+        bdueq.push_back(cycle + MEMLAT);
+      end
+    end
+    if (m_bvalid && m_bready) void'(bdueq.pop_front());
+    if (m_arvalid && m_arready) begin
+      checkburst(m_araddr, m_arlen);
+      radrq.push_back(m_araddr);
+      rlenq.push_back(m_arlen);
+      rdueq.push_back(cycle + MEMLAT);
+    end
+    if (m_rvalid && m_rready) begin
+      radr  <= radr + 4;
+      rbeat <= rbeat + 1;
+      if (m_rlast) begin
+        void'(radrq.pop_front());
+        void'(rlenq.pop_front());
+        void'(rdueq.pop_front());
+        rbusy <= 0;
+      end
+    end else if (!rbusy && rdueq.size() != 0 && rdueq[0] <= cycle) begin
+      radr  <= radrq[0];
+      rbeat <= 0;
+      rbusy <= 1;
+    end
+    // SD clock edges skipped to keep the FIFO from overflowing or running dry
+    if (dut.data_busy && dut.clock_cnt >= dut.clock_divider_reg && dut.clock_cnt < 124 &&
+        (dut.en_rx_fifo && dut.fifo_almost_full || dut.en_tx_fifo && dut.fifo_almost_empty)) throttle++;
+  end
+
+  initial rbusy = 0;
+
+  ///////////////////////////////////////////
+  // Register access
+  ///////////////////////////////////////////
+
+  task automatic regwrite(input logic [7:0] adr, input logic [31:0] data);
+    @(posedge clk);
+    s_awaddr <= adr; s_awvalid <= 1; s_wdata <= data; s_wvalid <= 1; s_bready <= 1;
+    fork
+      begin do @(posedge clk); while (!s_awready); s_awvalid <= 0; end
+      begin do @(posedge clk); while (!s_wready);  s_wvalid  <= 0; end
+    join
+    while (!s_bvalid) @(posedge clk);
+    @(posedge clk);
+    s_bready <= 0;
+  endtask
+
+  task automatic regread(input logic [7:0] adr, output logic [31:0] data);
+    @(posedge clk);
+    s_araddr <= adr; s_arvalid <= 1; s_rready <= 1;
+    do @(posedge clk); while (!s_arready);
+    s_arvalid <= 0;
+    while (!s_rvalid) @(posedge clk);
+    data = s_rdata;
+    @(posedge clk);
+    s_rready <= 0;
+  endtask
+
+  // Send a command and wait for it to finish.  blocks > 0 adds a data transfer to or from DMA_ADR.
+  task automatic command(input int cmd, input logic [31:0] arg, input logic [7:0] resp, input int blocks,
+                         input bit write, output logic [31:0] response);
+    logic [31:0] status;
+    logic [31:0] c;
+    c = cmd << 8 | resp;
+    if (blocks) begin
+      c |= write ? 32'h40 : 32'h20;
+      regwrite(REG_DMA_ADR, DMA_ADR);
+      regwrite(REG_BLKSIZE, cmd == 6 ? 63 : 511); // the CMD6 switch status is 512 bits
+      regwrite(REG_BLKCNT, blocks - 1);
+      regwrite(REG_DATA_TIMEOUT, 32'h1FFFFFF);
+    end
+    regwrite(REG_COMMAND, c);
+    regwrite(REG_CMD_TIMEOUT, 32'hFFFFF);
+    regwrite(REG_ARGUMENT, arg);
+    do regread(REG_CMD_ISR, status); while (status == 0);
+    if (status != 1 && cmd != 0) $error("CMD%0d failed: cmd_isr %h", cmd, status);
+    regread(REG_RESP0, response);
+    regwrite(REG_CMD_ISR, 0);
+    if (blocks) begin
+      do regread(REG_DATA_ISR, status); while (status == 0);
+      if (status != 1) $error("CMD%0d data failed: data_isr %h", cmd, status);
+      regwrite(REG_DATA_ISR, 0);
+    end
+  endtask
+
+  ///////////////////////////////////////////
+  // Benchmark
+  ///////////////////////////////////////////
+
+  task automatic timed(input string name, input int cmd, input bit write, input logic [7:0] div);
+    logic [31:0] r;
+    longint      start, cycles;
+    real         mbs, sdmhz;
+    bursts = 0; beats = 0; throttle = 0;
+    start = cycle;
+    command(cmd, 0, R1, BLOCKS, write, r);
+    cycles = cycle - start;
+    command(12, 0, R1B, 0, 0, r);   // STOP_TRANSMISSION
+    mbs   = BLOCKS * 512.0 / (cycles * CLK_PERIOD * 1.0e-9) / 1.0e6;
+    sdmhz = CLK_MHZ / (2.0 * (div + 1));
+    $display("%-6s %7.3f MHz  %8.3f MB/s  %4.1f%% of bus  %6.1f beats/burst  %0d cycles throttled",
+             name, sdmhz, mbs, 100.0 * mbs / (sdmhz / 2.0), bursts ? real'(beats) / bursts : 0.0, throttle);
+  endtask
+
+  initial begin
+    logic [31:0] r;
+    int          i, errors;
+    s_awvalid = 0; s_wvalid = 0; s_bready = 0; s_arvalid = 0; s_rready = 0;
+    if (!$test$plusargs("SDIMG")) for (i = 0; i < BLOCKS * 512; i++) card.FLASHmem[i] = pattern(i);
+    repeat (10) @(posedge clk);
+    resetn = 1;
+    repeat (10) @(posedge clk);
+
+    // bring the card up at 400kHz, as ini_sd() in tests/custom/boot/boot.c does
+    regwrite(REG_RESET, 1);
+    regwrite(REG_CLOCK_DIV, CLK_MHZ * 1000 / 800 - 1);
+    regwrite(REG_RESET, 0);
+    command(0, 0, R_NONE, 0, 0, r);
+    command(8, 32'h1AA, R7, 0, 0, r);
+    do begin
+      command(55, 0, R1, 0, 0, r);
+      command(41, 32'h40300000, R3, 0, 0, r);
+    end while (!r[31]);
+    command(2, 0, R2, 0, 0, r);
+    command(3, 0, R6, 0, 0, r);
+    command(7, r & 32'hFFFF0000, R1B, 0, 0, r);
+    command(55, r & 32'hFFFF0000, R1, 0, 0, r);
+    command(6, 2, R1, 0, 0, r);       // ACMD6: 4-bit bus
+    regwrite(REG_CONTROL, 1);
+
+    // CMD6 as ini_sd() uses it: check for high speed, switch to it, and switch back to default
+    // speed as it does when a block read fails at high speed.  Status byte 13 bit 1 reports
+    // high speed support and byte 16 the selected access mode; the DMA stores byte 0 in [7:0].
+    command(6, 32'h00FFFFF1, R1, 1, 0, r);
+    if (!mem[DMA_ADR / 4 + 3][9]) $error("CMD6 check does not report high speed support");
+    command(6, 32'h80FFFFF1, R1, 1, 0, r);
+    if (mem[DMA_ADR / 4 + 4][3:0] != 4'h1) $error("CMD6 did not switch to high speed");
+    command(6, 32'h80FFFFF0, R1, 1, 0, r);
+    if (mem[DMA_ADR / 4 + 4][3:0] != 4'h0) $error("CMD6 did not switch back to default speed");
+    command(16, 512, R1, 0, 0, r);
+
+    $display("sdc_bench: %0d MHz controller, %0d-word FIFO, %0d-cycle memory, %0d KB transfers",
+             CLK_MHZ, 1 << FIFO_ADDR_BITS, MEMLAT, BLOCKS / 2);
+    for (i = 0; i < NDIVS; i++) begin
+      regwrite(REG_CLOCK_DIV, DIVS[8*i +: 8]);
+      timed("read", 18, 0, DIVS[8*i +: 8]);
+      if (i == 0) begin
+        errors = 0;
+        for (int w = 0; w < BLOCKS * 128; w++)
+          if (mem[DMA_ADR / 4 + w] !== {card.CardByte(4*w+3), card.CardByte(4*w+2), card.CardByte(4*w+1), card.CardByte(4*w)}) errors++;
+        if (errors) $error("%0d words read from the card were wrong", errors);
+      end
+      timed("write", 25, 1, DIVS[8*i +: 8]);
+    end
+    $finish;
+  end
+endmodule
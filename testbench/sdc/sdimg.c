@@ -0,0 +1,82 @@
+///////////////////////////////////////////
+// sdimg.c
+//
+// Written: CORE-V-Wally contributors 19 October 2026
+// Created: 19 October 2026
+// Modified:
+//
+// Purpose: DPI-C backing store for sdModel.sv.  Maps a raw SD card image, such as the test.img
+//          made by linux/sdcard/make-img.sh, into the simulator's address space so a card of any
+//          size costs only the pages that are touched.  Data moves a 512-byte block at a time.
+//          With copy-on-write the image is mapped privately: the simulation sees its own writes
+//          but the file on disk is never modified.  Otherwise writes go through to the file.
+//
+// A component of the CORE-V-WALLY configurable RISC-V project.
+// https://github.com/openhwgroup/cvw
+//
+// Copyright (C) 2021-23 Harvey Mudd College & Oklahoma State University
+//
+// SPDX-License-Identifier: Apache-2.0 WITH SHL-2.1
+//
+// Licensed under the Solderpad Hardware License v 2.1 (the “License”); you may not use this file
+// except in compliance with the License, or, at your option, the Apache License version 2.0. You
+// may obtain a copy of the License at
+//
+// https://solderpad.org/licenses/SHL-2.1/
+//
+// Unless required by applicable law or agreed to in writing, any work distributed under the
+// License is distributed on an “AS IS” BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+// either express or implied. See the License for the specific language governing permissions
+// and limitations under the License.
+////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SDIMG_BLOCK 512
+
+static unsigned char *img;
+static long long imgblocks;
+
+// Map the image at path.  Returns the card size in blocks, or 0 if it cannot be mapped.
+long long sdimg_open(const char *path, int cow) {
+  struct stat st;
+  void *p;
+  int fd;
+
+  fd = open(path, cow ? O_RDONLY : O_RDWR);
+  if (fd < 0) {
+    perror(path);
+    return 0;
+  }
+  if (fstat(fd, &st) < 0 || st.st_size < SDIMG_BLOCK) {
+    fprintf(stderr, "%s: not a usable SD card image\n", path);
+    close(fd);
+    return 0;
+  }
+  p = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, cow ? MAP_PRIVATE : MAP_SHARED, fd, 0);
+  close(fd); // the mapping keeps the file open
+  if (p == MAP_FAILED) {
+    perror(path);
+    return 0;
+  }
+  madvise(p, st.st_size, MADV_RANDOM); // the card is read a block at a time; don't read ahead
+  img = p;
+  imgblocks = st.st_size / SDIMG_BLOCK;
+  return imgblocks;
+}
+
+// Blocks past the end of the image read as zero and ignore writes, like an unprogrammed card.
+void sdimg_read(long long blk, unsigned char *data) {
+  if (img && blk >= 0 && blk < imgblocks) memcpy(data, img + blk * SDIMG_BLOCK, SDIMG_BLOCK);
+  else memset(data, 0, SDIMG_BLOCK);
+}
+
+void sdimg_write(long long blk, const unsigned char *data) {
+  if (img && blk >= 0 && blk < imgblocks) memcpy(img + blk * SDIMG_BLOCK, data, SDIMG_BLOCK);
+  else fprintf(stderr, "sdimg: write to block %lld beyond end of image ignored\n", blk);
+}
@@ -273,7 +273,8 @@ module testbench;
   wallypipelinedsoc #(P) dut(.clk, .reset_ext, .reset, .HRDATAEXT, .HREADYEXT, .HRESPEXT, .HSELEXT, .HSELEXTSDC,
                         .HCLK, .HRESETn, .HADDR, .HWDATA, .HWSTRB, .HWRITE, .HSIZE, .HBURST, .HPROT,
                         .HTRANS, .HMASTLOCK, .HREADY, .TIMECLK(1'b0), .GPIOIN, .GPIOOUT, .GPIOEN,
-                        .UARTSin, .UARTSout, .SDCIntr, .SPICS, .SPIOut, .SPIIn); 
+                        .UARTSin, .UARTSout, .SDCIntr, .SPICS, .SPIOut, .SPIIn,
+                        .ETHTXCLK(1'b0), .ETHTXD(), .ETHTXEN(), .ETHRXCLK(1'b0), .ETHRXD(4'b0), .ETHRXDV(1'b0), .ETHRXER(1'b0)); 
 
   // W-stage hardware not needed by Wally itself 
   parameter nop = 'h13;
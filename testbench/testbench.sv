@@ -38,6 +38,7 @@ module testbench;
   parameter string TEST="arch64m";
   parameter PrintHPMCounters=0;
   parameter BPRED_LOGGER=0;
+  parameter PIPELINE_LOGGER=0;
   parameter I_CACHE_ADDR_LOGGER=0;
   parameter D_CACHE_ADDR_LOGGER=0;
   parameter RISCV_DIR = "/opt/riscv";
@@ -69,6 +70,8 @@ module testbench;
   logic        SPIIn, SPIOut;
   logic [3:0]  SPICS;
   logic        SDCIntr;
+  logic        ETHTXCLK, ETHTXEN, ETHRXCLK, ETHRXDV, ETHRXER;
+  logic [3:0]  ETHTXD, ETHRXD;
 
   logic        HREADY;
   logic        HSELEXT;
@@ -78,6 +81,7 @@ module testbench;
   integer ProgramAddrLabelArray [string];
 
   int test, i, errors, totalerrors;
+  logic [P.XLEN-1:0] ExitCode; // a0 when a microbenchmark halts
 
   string outputfile;
   integer outputFilePointer;
@@ -118,10 +122,18 @@ module testbench;
         "imperas64c":   if (P.C_SUPPORTED)        tests = imperas64c;
                         else                      tests = imperas64iNOc;
         "custom":                                 tests = custom;
+        "interp":                                 tests = interp;
+        "csrfwd":                                 tests = csrfwd;
+        "loadfwd":                                tests = loadfwd;
+        "amolat":       if (P.A_SUPPORTED)        tests = amolat;
+        "etrace":       if (P.TRACE_SUPPORTED)    tests = etrace;
+        "ethloop":      if (P.ETH_SUPPORTED)      tests = ethloop;
+        "wfiwake":      if (P.ZIHPM_SUPPORTED & P.CLINT_SUPPORTED) tests = wfiwake;
         "wally64i":                               tests = wally64i; 
         "wally64priv":                            tests = wally64priv;
         "wally64periph":                          tests = wally64periph;
         "coremark":                               tests = coremark;
+        "freertos":                               tests = freertos;
         "fpga":                                   tests = fpga;
         "ahb64" :                                 tests = ahb64;
         "coverage64gc" :                          tests = coverage64gc;
@@ -168,6 +180,7 @@ module testbench;
         "ahb32" :                                 tests = ahb32;
         "embench":                                tests = embench;
         "coremark":                               tests = coremark;
+        "freertos":                               tests = freertos;
         "arch32zba":     if (P.ZBA_SUPPORTED)     tests = arch32zba;
         "arch32zbb":     if (P.ZBB_SUPPORTED)     tests = arch32zbb;
         "arch32zbc":     if (P.ZBC_SUPPORTED)     tests = arch32zbc;
@@ -307,6 +320,7 @@ module testbench;
   // Verify the test ran correctly by checking the memory against a known signature.
   ////////////////////////////////////////////////////////////////////////////////
     if(TestBenchReset) test = 1;
+    if(CopyRAM) ExitCode = dut.core.ieu.dp.regf.rf[10];
     if (TEST == "coremark")
       if (dut.core.priv.priv.EcallFaultM) begin
         $display("Benchmark: coremark is done.");
@@ -333,6 +347,12 @@ module testbench;
         $display("Embench Benchmark: created output file: %s", outputfile);
       end else if (TEST == "coverage64gc") begin
         $display("Coverage tests don't get checked");
+      end else if (tests[0] == `MICROBENCH) begin
+        // microbenchmarks check themselves and return nonzero from main on failure
+        if (ExitCode != 0) begin
+          $display("%s failed with exit code %0d", tests[test], ExitCode);
+          totalerrors = totalerrors + 1;
+        end else $display("%s passed", tests[test]);
       end else begin 
         // for tests with no self checking mechanism, read .signature.output file and compare to check for errors
         // clear signature to prevent contamination from previous tests
@@ -450,28 +470,23 @@ module testbench;
     assign {HRESPEXT, HRDATAEXT} = '0;
   end
 
-  if(P.SDC_SUPPORTED) begin : sdcard
-    // *** fix later
-/* -----\/----- EXCLUDED -----\/-----
-    sdModel sdcard
-      (.sdClk(SDCCLK),
-       .cmd(SDCCmd), 
-       .dat(SDCDat));
-
-    assign SDCCmd = SDCCmdOE ? SDCCmdOut : 1'bz;
-    assign SDCCmdIn = SDCCmd;
-    assign SDCDat = sd_dat_reg_t ? sd_dat_reg_o : sd_dat_i;
-    assign SDCDatIn = SDCDat;
- -----/\----- EXCLUDED -----/\----- */
-    assign SDCIntr = '0;
-  end else begin
-    assign SDCIntr = '0;
-  end
+  // The SD card controller is the FPGA's AXI controller on the external bus, which is not part
+  // of this testbench.  sdModel and its disk image run against that controller in the sdc flow
+  // (testbench/sdc/sdc_bench.sv, do wally.do <config> sdc).
+  assign SDCIntr = '0;
 
   wallypipelinedsoc  #(P) dut(.clk, .reset_ext, .reset, .HRDATAEXT, .HREADYEXT, .HRESPEXT, .HSELEXT, .HSELEXTSDC,
     .HCLK, .HRESETn, .HADDR, .HWDATA, .HWSTRB, .HWRITE, .HSIZE, .HBURST, .HPROT,
     .HTRANS, .HMASTLOCK, .HREADY, .TIMECLK(1'b0), .GPIOIN, .GPIOOUT, .GPIOEN,
-    .UARTSin, .UARTSout, .SDCIntr, .SPIIn, .SPIOut, .SPICS); 
+    .UARTSin, .UARTSout, .SDCIntr, .SPIIn, .SPIOut, .SPICS,
+    .ETHTXCLK, .ETHTXD, .ETHTXEN, .ETHRXCLK, .ETHRXD, .ETHRXDV, .ETHRXER); 
+
+  // loop Ethernet frames back and report throughput at the end of the test
+  if (P.ETH_SUPPORTED) begin : ethphy
+    ethphy ethphy(.clk, .reset, .ETHTXCLK, .ETHRXCLK, .ETHTXD, .ETHTXEN, .ETHRXD, .ETHRXDV, .ETHRXER, .Report(TestComplete));
+  end else begin : ethphy
+    assign {ETHTXCLK, ETHRXCLK, ETHRXD, ETHRXDV, ETHRXER} = '0;
+  end
 
   // generate clock to sequence tests
   always begin
@@ -513,9 +528,31 @@ module testbench;
   riscvassertions #(P) riscvassertions();  // check assertions for a legal configuration
   loggers #(P, TEST, PrintHPMCounters, I_CACHE_ADDR_LOGGER, D_CACHE_ADDR_LOGGER, BPRED_LOGGER)
   loggers (clk, reset, DCacheFlushStart, DCacheFlushDone, memfilename);
+  if (PIPELINE_LOGGER) begin : pipelinelogger  // Konata pipeline trace in konata.log
+    pipelinelogger #(P, TEST) pipelinelogger(clk, reset);
+  end
+
+  // E-Trace round trip: log the PCs retired while tracing and dump the trace buffer when the test
+  // completes, so bin/etrace-decode.py --check can compare the decoded trace with what ran
+  if (P.TRACE_SUPPORTED) begin : etracecheck
+    integer RetiredFile, DumpFile, entry;
+    initial if (TEST == "etrace") RetiredFile = $fopen("etrace.retired", "w");
+    always @(posedge clk)
+      if (TEST == "etrace") begin
+        if (dut.TraceEnable & dut.core.InstrValidM & ~dut.core.StallW & ~dut.core.FlushW)
+          $fwrite(RetiredFile, "%h\n", dut.core.PCM);
+        if (CopyRAM) begin
+          $fclose(RetiredFile);
+          DumpFile = $fopen("etrace.dump", "w");
+          for (entry = 0; entry < P.TRACE_ENTRIES; entry++)
+            $fwrite(DumpFile, "%h\n", dut.uncore.uncore.trace.trace.buffer.mem[entry]);
+          $fclose(DumpFile);
+        end
+      end
+  end
 
   // track the current function or global label
-  if (DEBUG == 1 | ((PrintHPMCounters | BPRED_LOGGER) & P.ZICNTR_SUPPORTED)) begin : FunctionName
+  if (DEBUG == 1 | PIPELINE_LOGGER | ((PrintHPMCounters | BPRED_LOGGER) & P.ZICNTR_SUPPORTED)) begin : FunctionName
     FunctionName #(P) FunctionName(.reset(reset_ext | TestBenchReset),
 			      .clk(clk), .ProgramAddrMapFile(ProgramAddrMapFile), .ProgramLabelMapFile(ProgramLabelMapFile));
   end
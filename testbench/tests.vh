@@ -32,6 +32,8 @@
 `define CUSTOM "5"
 `define COVERAGE "6"
 `define BUILDROOT "7"
+`define FREERTOS "8"
+`define MICROBENCH "9"
 
 string tvpaths[] = '{
     "$RISCV/imperas-riscv-tests/work/",
@@ -40,7 +42,10 @@ string tvpaths[] = '{
     "../benchmarks/coremark/work/",
     "../addins/embench-iot/",
     "../tests/custom/work/",
-    "../tests/coverage/"
+    "../tests/coverage/",
+    "$RISCV/linux-testvectors/",
+    "../benchmarks/freertos/work/",
+    "../tests/custom/work/"
     };
 
   string coverage64gc[] = '{
@@ -82,6 +87,11 @@ string tvpaths[] = '{
     "coremark.bare.riscv"
   };
 
+  string freertos[] = '{
+    `FREERTOS,
+    "freertos.bare.riscv"
+  };
+
   string embench[] = '{
     `EMBENCH,
     "bd_speedopt_speed/src/aha-mont64/aha-mont64",
@@ -2579,6 +2589,42 @@ string arch32zfh_fma[] = '{
     "debug",
     "cacheTest"
  };
+
+ // Microbenchmarks in tests/custom return 0 from main when they pass
+ string interp[] = '{
+    `MICROBENCH,
+    "interp"
+ };
+
+ string csrfwd[] = '{
+    `MICROBENCH,
+    "csrfwd"
+ };
+
+ string loadfwd[] = '{
+    `MICROBENCH,
+    "loadfwd"
+ };
+
+ string amolat[] = '{
+    `MICROBENCH,
+    "amolat"
+ };
+
+ string etrace[] = '{
+    `MICROBENCH,
+    "etrace"
+ };
+
+ string ethloop[] = '{
+    `MICROBENCH,
+    "ethloop"
+ };
+
+ string wfiwake[] = '{
+    `MICROBENCH,
+    "wfiwake"
+ };
   string testsBP64[] = '{
     `IMPERASTEST,
     "rv64BP/simple"
@@ -53,6 +53,8 @@ module wallywrapper;
   logic        SPIIn, SPIOut;
   logic [3:0]  SPICS;
   logic        SDCIntr;
+  logic        ETHTXCLK, ETHTXEN, ETHRXCLK, ETHRXDV, ETHRXER;
+  logic [3:0]  ETHTXD, ETHRXD;
 
   logic        HREADY;
   logic        HSELEXT;
@@ -71,6 +73,7 @@ module wallywrapper;
   wallypipelinedsoc  #(P) dut(.clk, .reset_ext, .reset, .HRDATAEXT,.HREADYEXT, .HRESPEXT,.HSELEXT, .HSELEXTSDC,
                         .HCLK, .HRESETn, .HADDR, .HWDATA, .HWSTRB, .HWRITE, .HSIZE, .HBURST, .HPROT,
                         .HTRANS, .HMASTLOCK, .HREADY, .TIMECLK(1'b0), .GPIOIN, .GPIOOUT, .GPIOEN,
-                        .UARTSin, .UARTSout, .SPIIn, .SPIOut, .SPICS, .SDCIntr); 
+                        .UARTSin, .UARTSout, .SPIIn, .SPIOut, .SPICS, .SDCIntr,
+                        .ETHTXCLK, .ETHTXD, .ETHTXEN, .ETHRXCLK, .ETHRXD, .ETHRXDV, .ETHRXER); 
 
 endmodule
@@ -0,0 +1,79 @@
+/*
+ * Filename:
+ *
+ *   amolat.c
+ *
+ * Description:
+ *
+ *   Microbenchmark for AMOs on cacheable memory.  A reference count in the
+ *   D$ is bumped with amoadd.d in a loop, once using each old value in the
+ *   next instruction and once with no dependence on it.  mhpmcounter28
+ *   counts the cycles AMOs spend in the Memory stage, so once the line is
+ *   in the cache every amoadd.d should take exactly one.  With
+ *   LOADFWD_SUPPORTED the old value is forwarded and both loops take the
+ *   same number of cycles; otherwise the dependent loop takes one more per
+ *   iteration.  The loop cycle counts are left in depcycles and indepcycles.
+ *   Returns 0 if every AMO hit completed in one cycle, 1 otherwise.
+ *
+ */
+
+#define ITER 1000
+
+static long refcount;
+volatile unsigned long depcycles, indepcycles;
+
+static inline unsigned long amocycles(void) {
+  unsigned long c;
+  asm volatile("csrr %0, mhpmcounter28" : "=r"(c));
+  return c;
+}
+
+static unsigned long dependent(long *p, unsigned long n, unsigned long *amo) {
+  unsigned long start, end, a0;
+  long acc = 0, t;
+  a0 = amocycles();
+  asm volatile("csrr %0, mcycle" : "=r"(start));
+  asm volatile(
+    "1:\n"
+    "  amoadd.d %0, %4, (%1)\n"
+    "  add  %2, %2, %0\n"
+    "  addi %3, %3, -1\n"
+    "  bnez %3, 1b\n"
+    : "=&r"(t), "+r"(p), "+r"(acc), "+r"(n)
+    : "r"(1L)
+    : "memory");
+  asm volatile("csrr %0, mcycle" : "=r"(end));
+  *amo = amocycles() - a0;
+  return end - start;
+}
+
+static unsigned long independent(long *p, unsigned long n, unsigned long *amo) {
+  unsigned long start, end, a0;
+  long acc = 0, t;
+  a0 = amocycles();
+  asm volatile("csrr %0, mcycle" : "=r"(start));
+  asm volatile(
+    "1:\n"
+    "  amoadd.d %0, %4, (%1)\n"
+    "  add  %2, %2, %3\n"
+    "  addi %3, %3, -1\n"
+    "  bnez %3, 1b\n"
+    : "=&r"(t), "+r"(p), "+r"(acc), "+r"(n)
+    : "r"(1L)
+    : "memory");
+  asm volatile("csrr %0, mcycle" : "=r"(end));
+  *amo = amocycles() - a0;
+  return end - start;
+}
+
+int main() {
+  unsigned long depamo, indepamo;
+
+  // warm the caches and branch predictor
+  dependent(&refcount, ITER, &depamo);
+  independent(&refcount, ITER, &indepamo);
+
+  depcycles = dependent(&refcount, ITER, &depamo);
+  indepcycles = independent(&refcount, ITER, &indepamo);
+  return depamo != ITER || indepamo != ITER;
+}
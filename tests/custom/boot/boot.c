@@ -117,6 +117,23 @@ struct sdc_regs {
 
 #define MAX_BLOCK_CNT 0x1000
 
+// SD clock.  The controller divides its clock by clock_divider + 1.
+// Default speed keeps the original half-rate margin; once a card has
+// switched to high speed (CMD6) it runs at the full controller clock.
+#define SDC_DIV_INIT    0x36            /* 22MHz/55 = 400kHz */
+#define SDC_DIV_DS      1               /* 22MHz/2 = 11MHz, default speed */
+#define SDC_DIV_HS      0               /* 22MHz, high speed */
+
+// Software limit on waiting for a command or data transfer to finish,
+// in case the controller's own timeouts never fire.
+#define SDC_TIMEOUT_US  500000
+
+// Build with -DSDC_FAST_BOOT=0 to keep the card in 1-bit default-speed
+// mode, e.g. to compare boot-image load times in simulation.
+#ifndef SDC_FAST_BOOT
+#define SDC_FAST_BOOT   1
+#endif
+
 #define SDC 0x00013000;
 
 // static struct sdc_regs * const regs __attribute__((section(".rodata"))) = (struct sdc_regs *)0x00013000;
@@ -144,20 +161,25 @@ struct sdc_regs {
     return "Unknown error code";
     }*/
 
+// Cycles taken by the last copyFlash boot-image load
+volatile QWORD sd_load_cycles;
+
+static uintptr_t cycles(void) {
+    uintptr_t c;
+    asm volatile ("csrr %0, 0xB00" : "=r" (c));
+    return c;
+}
+
 static void usleep(unsigned us) {
-    uintptr_t cycles0;
-    uintptr_t cycles1;
-    asm volatile ("csrr %0, 0xB00" : "=r" (cycles0));
-    for (;;) {
-        asm volatile ("csrr %0, 0xB00" : "=r" (cycles1));
-        if (cycles1 - cycles0 >= us * 100) break;
-    }
+    uintptr_t cycles0 = cycles();
+    while (cycles() - cycles0 < us * 100) {}
 }
 
 static int sdc_cmd_finish(unsigned cmd, uint32_t * response) {
   struct sdc_regs * regs = (struct sdc_regs *)SDC;
+  uintptr_t start = cycles();
   
-    while (1) {
+    while (cycles() - start < SDC_TIMEOUT_US * 100) {
         unsigned status = regs->cmd_int_status;
         if (status) {
             // clear interrupts
@@ -184,8 +206,10 @@ static int sdc_cmd_finish(unsigned cmd, uint32_t * response) {
 static int sdc_data_finish(void) {
     int status;
     struct sdc_regs * regs = (struct sdc_regs *)SDC;
+    uintptr_t start = cycles();
     
-    while ((status = regs->dat_int_status) == 0) {}
+    while ((status = regs->dat_int_status) == 0)
+        if (cycles() - start >= SDC_TIMEOUT_US * 100) return -1;
     regs->dat_int_status = 0;
     while (regs->software_reset != 0) {}
 
@@ -207,6 +231,7 @@ static int send_data_cmd(unsigned cmd, unsigned arg, void * buf, unsigned blocks
     case CMD15:
         // No responce
         break;
+    case CMD6:
     case CMD11:
     case CMD13:
     case CMD16:
@@ -274,7 +299,7 @@ static int send_data_cmd(unsigned cmd, unsigned arg, void * buf, unsigned blocks
             return -1;
         }
         regs->dma_addres = (uint64_t)(intptr_t)buf;
-        regs->block_size = 511;
+        regs->block_size = cmd == CMD6 ? 63 : 511; // switch function status is 512 bits
         regs->block_count = blocks - 1;
         regs->data_timeout = 0x1FFFFFF;
     }
@@ -291,6 +316,31 @@ static int send_data_cmd(unsigned cmd, unsigned arg, void * buf, unsigned blocks
 
 #define send_cmd(cmd, arg, response) send_data_cmd(cmd, arg, NULL, 0, response)
 
+/* Switch the card's access mode (function group 1) with CMD6: 1 for high
+   speed, 0 for default speed.  The 512-bit status returned by both the check
+   and the switch lists the supported functions of group 1 in bits 415:400 and
+   the selected function in bits 379:376, most significant byte first.
+   Returns 1 if the card selected the mode. */
+static int sd_access_mode(unsigned mode) {
+    uint32_t response[4];
+    BYTE status[64] __attribute__((aligned(8)));
+
+    if (send_data_cmd(CMD6, 0x00FFFFF0 | mode, status, 1, response) < 0) return 0;
+    if (!(status[13] & (1 << mode))) return 0;  /* bit 400 + mode: mode supported */
+    if (send_data_cmd(CMD6, 0x80FFFFF0 | mode, status, 1, response) < 0) return 0;
+    return (status[16] & 0x0F) == mode;         /* bits 379:376: mode selected */
+}
+
+/* Set the data bus width with ACMD6: 2 for 4 bits, 0 for 1 bit */
+static int sd_bus_width(unsigned rca, unsigned width) {
+    struct sdc_regs * regs = (struct sdc_regs *)SDC;
+    uint32_t response[4];
+
+    if (send_cmd(CMD55, rca << 16, response) < 0 || send_cmd(ACMD6, width, response) < 0) return -1;
+    regs->control = (regs->control & ~SDC_CONTROL_SD_4BIT) | (width ? SDC_CONTROL_SD_4BIT : 0);
+    return 0;
+}
+
 static BYTE ini_sd(void) {
   struct sdc_regs * regs = (struct sdc_regs *)SDC;
     unsigned rca;
@@ -356,16 +406,36 @@ static BYTE ini_sd(void) {
 
     /* Clock 25MHz */
     // 22Mhz/2 = 11Mhz
-    regs->clock_divider = 1;
+    regs->clock_divider = SDC_DIV_DS;
     usleep(10000);
 
-    /* Bus width 1-bit */
+    /* Bus width 4-bit if the controller has DAT[3:1], otherwise 1-bit */
     regs->control = 0;
-    if (send_cmd(CMD55, rca << 16, response) < 0 || send_cmd(ACMD6, 0, response) < 0) return -1;
+    if (!(SDC_FAST_BOOT && (regs->capability & SDC_CAPABILITY_SD_4BIT) && sd_bus_width(rca, 2) == 0))
+        if (sd_bus_width(rca, 0) < 0) return -1;
+
+    /* High speed: only SD ver 2 cards are sure to support CMD6 */
+    if (SDC_FAST_BOOT && (card_type & CT_SD2) && sd_access_mode(1)) {
+        regs->clock_divider = SDC_DIV_HS;
+        usleep(10);
+    }
 
     /* Set R/W block length to 512 */
     if (send_cmd(CMD16, 512, response) < 0) return -1;
 
+    /* Make sure a block can be read, backing off first from high speed and then from 4-bit */
+    {
+        BYTE buf[512] __attribute__((aligned(8)));
+        if (regs->clock_divider == SDC_DIV_HS && disk_read(buf, 0, 1, card_type)) {
+            /* Slow the clock first, then switch the card out of high speed */
+            regs->clock_divider = SDC_DIV_DS;
+            usleep(10);
+            sd_access_mode(0);
+        }
+        if ((regs->control & SDC_CONTROL_SD_4BIT) && disk_read(buf, 0, 1, card_type))
+            if (sd_bus_width(rca, 0) < 0) return -1;
+    }
+
     // drv_status &= ~STA_NOINIT;
     return card_type;
 }
@@ -403,13 +473,17 @@ void copyFlash(QWORD address, QWORD * Dst, DWORD numBlocks) {
   BYTE card_type;
   int ret = 0;
   
+  uintptr_t start;
+  
   card_type = ini_sd();
 
   // BYTE * buf = (BYTE *)Dst;
     
   // if (disk_read(buf, (LBA_t)address, (UINT)numBlocks, card_type) < 0) /* UART Print function?*/;
   
+  start = cycles();
   ret = gpt_load_partitions(card_type);
+  sd_load_cycles = cycles() - start;
 }
 
 /*
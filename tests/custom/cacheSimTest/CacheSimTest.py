@@ -87,4 +87,43 @@ if __name__ == "__main__":
     #this line was dirty, so there was a wb
     assert (cache.cacheaccess(0xEAC2) == 'D')
     assert (cache.ways[0][0xC].tag == 0xEA)
-    assert (cache.pLRU[0xC] == [1,1,0])
\ No newline at end of file
+    assert (cache.pLRU[0xC] == [1,1,0])
+    #true LRU: the ages stay a permutation, and the oldest way is evicted
+    cache = cs.Cache(16, 4, 16, 8, "lru")
+    for addr in [0xABCD, 0xACCD, 0xADCD, 0xAECD]:
+        assert (cache.cacheaccess(addr) == 'M')
+    assert (cache.ages[0xC] == [3,2,1,0])
+    assert (cache.cacheaccess(0xABCD) == 'H')
+    assert (cache.ages[0xC] == [0,3,2,1])
+    assert (cache.cacheaccess(0xAFCD) == 'E')
+    assert (cache.ways[1][0xC].tag == 0xAF)
+    assert (cache.ages[0xC] == [1,0,3,2])
+
+    #SRRIP: fills insert at 2, hits promote to 0, and evictions age the set
+    cache = cs.Cache(16, 4, 16, 8, "srrip")
+    for addr in [0xABCD, 0xACCD, 0xADCD, 0xAECD]:
+        assert (cache.cacheaccess(addr) == 'M')
+    assert (cache.rrpv[0xC] == [2,2,2,2])
+    assert (cache.cacheaccess(0xABCD) == 'H')
+    assert (cache.rrpv[0xC] == [0,2,2,2])
+    assert (cache.cacheaccess(0xAFCD) == 'E')
+    assert (cache.ways[1][0xC].tag == 0xAF)
+    assert (cache.rrpv[0xC] == [1,2,3,3])
+    #a scan does not displace the line that hit
+    for addr in [0xB0CD, 0xB1CD, 0xB2CD]:
+        assert (cache.cacheaccess(addr) == 'E')
+    assert (cache.ways[0][0xC].tag == 0xAB)
+
+    #BRRIP: only every 32nd fill inserts at 2
+    cache = cs.Cache(16, 4, 16, 8, "brrip")
+    for addr in [0xABCD, 0xACCD, 0xADCD, 0xAECD]:
+        assert (cache.cacheaccess(addr) == 'M')
+    assert (cache.rrpv[0xC] == [2,3,3,3])
+
+    #random: the LFSR advances once per fill
+    cache = cs.Cache(16, 4, 16, 8, "random")
+    for addr in [0xABCD, 0xACCD, 0xADCD, 0xAECD]:
+        assert (cache.cacheaccess(addr) == 'M')
+    assert (cache.lfsr == 0x10)
+    assert (cache.cacheaccess(0xAFCD) == 'E')
+    assert (cache.ways[0][0xC].tag == 0xAF)
@@ -54,6 +54,5 @@ _start:
 .type _halt, @function
 _halt:
 	li gp, 1
-	li a0, 0
 	ecall
 	j _halt
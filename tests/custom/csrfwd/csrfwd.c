@@ -0,0 +1,57 @@
+/*
+ * Filename:
+ *
+ *   csrfwd.c
+ *
+ * Description:
+ *
+ *   Microbenchmark for CSR read forwarding (CSRFWD_SUPPORTED).  Two loops
+ *   with identical instruction sequences read instret; in the first the
+ *   following add consumes the CSR value, in the second it does not.
+ *   With forwarding, the dependent loop adds no bubbles and both loops
+ *   take the same number of cycles.  Returns 0 if so, 1 otherwise.
+ *   Without forwarding, expect one extra cycle per iteration.
+ *
+ */
+
+#define ITER 1000
+
+static unsigned long dependent(unsigned long n) {
+  unsigned long start, end, acc = 0, t;
+  asm volatile("csrr %0, mcycle" : "=r"(start));
+  asm volatile(
+    "1:\n"
+    "  csrr %0, instret\n"
+    "  add  %1, %1, %0\n"
+    "  addi %2, %2, -1\n"
+    "  bnez %2, 1b\n"
+    : "=&r"(t), "+r"(acc), "+r"(n));
+  asm volatile("csrr %0, mcycle" : "=r"(end));
+  return end - start;
+}
+
+static unsigned long independent(unsigned long n) {
+  unsigned long start, end, acc = 0, t;
+  asm volatile("csrr %0, mcycle" : "=r"(start));
+  asm volatile(
+    "1:\n"
+    "  csrr %0, instret\n"
+    "  add  %1, %1, %1\n"
+    "  addi %2, %2, -1\n"
+    "  bnez %2, 1b\n"
+    : "=&r"(t), "+r"(acc), "+r"(n));
+  asm volatile("csrr %0, mcycle" : "=r"(end));
+  return end - start;
+}
+
+int main() {
+  unsigned long dep, indep;
+
+  // warm the caches and branch predictor
+  dependent(ITER);
+  independent(ITER);
+
+  dep = dependent(ITER);
+  indep = independent(ITER);
+  return dep > indep;
+}
@@ -0,0 +1,226 @@
+/*
+ * Filename:
+ *
+ *   ethloop.c
+ *
+ * Description:
+ *
+ *   Loopback test and benchmark for the Ethernet MAC (ETH_SUPPORTED,
+ *   src/uncore/eth_apb.sv).  Run it on eth_rv64gc, where the testbench
+ *   connects the MII port to a loopback PHY model (testbench/common/ethphy.sv).
+ *   NFRAMES frames are queued on the transmit ring as slots free up, and
+ *   each one is expected back on the receive ring with its payload intact.
+ *   The DMA is not coherent with the data cache, so buffers and descriptors
+ *   are flushed before the hardware reads them and invalidated before the
+ *   processor reads what the hardware wrote.  Receive descriptors share cache
+ *   lines, so the processor never writes one once the ring is running: each
+ *   slot keeps its buffer and is handed back just by advancing the tail.
+ *   Prints elapsed and processor cycles per frame on the UART and returns
+ *   the number of bad or missing frames.  The PHY model prints the wire
+ *   throughput when the test ends.  Finally a transmit descriptor with a
+ *   buffer off the 64-bit bus width must be rejected without sending.
+ *
+ */
+
+#include <stdint.h>
+
+#define ETH_BASE     0x10080000UL
+#define ETH_CTRL     0x00
+#define ETH_INTSTAT  0x04
+#define ETH_MACLO    0x0C
+#define ETH_MACHI    0x10
+#define ETH_TXBASELO 0x14
+#define ETH_TXBASEHI 0x18
+#define ETH_TXSIZE   0x1C
+#define ETH_TXTAIL   0x20
+#define ETH_TXHEAD   0x24
+#define ETH_RXBASELO 0x28
+#define ETH_RXBASEHI 0x2C
+#define ETH_RXSIZE   0x30
+#define ETH_RXTAIL   0x34
+#define ETH_RXHEAD   0x38
+#define ETH_RXDROPS  0x44
+
+#define ETH_INT_DESCERR 0x08
+
+#define UART_THR ((volatile uint8_t *)0x10000000)
+#define UART_LSR ((volatile uint8_t *)0x10000005)
+
+#define NDESC     8
+#define NFRAMES   32
+#define FRAMELEN  256
+#define RXBUFLEN  1536
+#define LINE      64
+
+struct desc {
+  uint64_t adr;
+  uint64_t len;
+};
+
+static struct desc txring[NDESC] __attribute__((aligned(LINE)));
+static struct desc rxring[NDESC] __attribute__((aligned(LINE)));
+static uint8_t txbuf[NDESC][FRAMELEN] __attribute__((aligned(LINE)));
+static uint8_t rxbuf[NDESC][RXBUFLEN] __attribute__((aligned(LINE)));
+static const uint8_t mac[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+
+static inline void eth_write(int reg, uint32_t val) {
+  *(volatile uint32_t *)(ETH_BASE + reg) = val;
+}
+
+static inline uint32_t eth_read(int reg) {
+  return *(volatile uint32_t *)(ETH_BASE + reg);
+}
+
+static inline unsigned long cycles(void) {
+  unsigned long c;
+  asm volatile("csrr %0, mcycle" : "=r"(c));
+  return c;
+}
+
+// write back to memory for the DMA to read
+static void flush(void *p, unsigned long n) {
+  unsigned long a;
+  for (a = (unsigned long)p & ~(LINE-1); a < (unsigned long)p + n; a += LINE)
+    asm volatile("cbo.flush (%0)" :: "r"(a) : "memory");
+  asm volatile("fence" ::: "memory");
+}
+
+// discard cached copies of memory the DMA has written
+static void inval(void *p, unsigned long n) {
+  unsigned long a;
+  asm volatile("fence" ::: "memory");
+  for (a = (unsigned long)p & ~(LINE-1); a < (unsigned long)p + n; a += LINE)
+    asm volatile("cbo.inval (%0)" :: "r"(a) : "memory");
+}
+
+static void putch(char c) {
+  while (!(*UART_LSR & 0x20));
+  *UART_THR = c;
+}
+
+static void puts_(const char *s) {
+  while (*s) putch(*s++);
+}
+
+static void putu(unsigned long n) {
+  char buf[24];
+  int i = 0;
+  do {
+    buf[i++] = '0' + n % 10;
+    n /= 10;
+  } while (n);
+  while (i) putch(buf[--i]);
+}
+
+static void init_rx(void) {
+  int i;
+  for (i = 0; i < NDESC; i++) {
+    rxring[i].adr = (uint64_t)(unsigned long)rxbuf[i];
+    rxring[i].len = 0;
+  }
+  flush(rxring, sizeof(rxring));
+  flush(rxbuf, sizeof(rxbuf)); // no dirty line may be written back over received data
+}
+
+static void fill_tx(int slot, int seq) {
+  uint8_t *f = txbuf[slot];
+  int i;
+  for (i = 0; i < 6; i++) {
+    f[i] = mac[i];      // destination: ourselves
+    f[6+i] = mac[i];    // source
+  }
+  f[12] = 0x88;         // local experimental EtherType
+  f[13] = 0xB5;
+  for (i = 14; i < FRAMELEN; i++) f[i] = (uint8_t)(seq + i);
+  flush(f, FRAMELEN);
+  txring[slot].adr = (uint64_t)(unsigned long)f;
+  txring[slot].len = FRAMELEN;
+  flush(&txring[slot], sizeof(struct desc));
+}
+
+static int check_rx(int slot, int seq) {
+  uint8_t *f = rxbuf[slot];
+  int i;
+  inval(&rxring[slot], sizeof(struct desc));
+  if (rxring[slot].len != FRAMELEN) return 1;
+  inval(f, FRAMELEN);
+  for (i = 0; i < 6; i++)
+    if (f[i] != mac[i]) return 1;
+  for (i = 14; i < FRAMELEN; i++)
+    if (f[i] != (uint8_t)(seq + i)) return 1;
+  return 0;
+}
+
+int main() {
+  int sent = 0, received = 0, errors = 0;
+  int txtail = 0, rxtail = NDESC - 1, rxnext = 0;
+  unsigned long start, end, t, busy = 0;
+
+  eth_write(ETH_MACLO, mac[0] | mac[1] << 8 | mac[2] << 16 | (uint32_t)mac[3] << 24);
+  eth_write(ETH_MACHI, mac[4] | mac[5] << 8);
+  eth_write(ETH_TXBASELO, (uint32_t)(unsigned long)txring);
+  eth_write(ETH_TXBASEHI, (uint32_t)((uint64_t)(unsigned long)txring >> 32));
+  eth_write(ETH_TXSIZE, NDESC);
+  eth_write(ETH_TXTAIL, 0);
+  eth_write(ETH_RXBASELO, (uint32_t)(unsigned long)rxring);
+  eth_write(ETH_RXBASEHI, (uint32_t)((uint64_t)(unsigned long)rxring >> 32));
+  eth_write(ETH_RXSIZE, NDESC);
+  init_rx();
+  eth_write(ETH_RXTAIL, rxtail);
+  eth_write(ETH_CTRL, 3); // transmit and receive enable
+
+  start = cycles();
+  while (received < NFRAMES) {
+    // queue a frame whenever a transmit slot is free; one slot always stays empty
+    if (sent < NFRAMES && (txtail + 1) % NDESC != eth_read(ETH_TXHEAD)) {
+      t = cycles();
+      fill_tx(txtail, sent);
+      txtail = (txtail + 1) % NDESC;
+      eth_write(ETH_TXTAIL, txtail);
+      sent++;
+      busy += cycles() - t;
+    }
+    // collect received frames and hand their buffers back
+    if (rxnext != eth_read(ETH_RXHEAD)) {
+      t = cycles();
+      errors += check_rx(rxnext, received);
+      rxtail = (rxtail + 1) % NDESC;
+      eth_write(ETH_RXTAIL, rxtail);
+      rxnext = (rxnext + 1) % NDESC;
+      received++;
+      busy += cycles() - t;
+    }
+    if (cycles() - start > 2000000UL) break; // frames were lost
+  }
+  end = cycles();
+
+  // a misaligned buffer is consumed without sending and flagged in the interrupt status
+  eth_write(ETH_INTSTAT, ETH_INT_DESCERR);
+  fill_tx(txtail, 0);
+  txring[txtail].adr += 4;
+  flush(&txring[txtail], sizeof(struct desc));
+  txtail = (txtail + 1) % NDESC;
+  eth_write(ETH_TXTAIL, txtail);
+  t = cycles();
+  while (eth_read(ETH_TXHEAD) != txtail && cycles() - t < 10000UL);
+  while (cycles() - t < 10000UL); // long enough for a frame to come back if one was sent
+  if (eth_read(ETH_TXHEAD) != txtail || !(eth_read(ETH_INTSTAT) & ETH_INT_DESCERR) ||
+      eth_read(ETH_RXHEAD) != rxnext) errors++;
+  eth_write(ETH_CTRL, 0);
+
+  errors += NFRAMES - received;
+  puts_("ethloop: ");
+  putu(received);
+  puts_(" frames of ");
+  putu(FRAMELEN);
+  puts_(" bytes, ");
+  putu((end - start) / NFRAMES);
+  puts_(" cycles per frame elapsed, ");
+  putu(busy / NFRAMES);
+  puts_(" processor cycles per frame, ");
+  putu(eth_read(ETH_RXDROPS));
+  puts_(" dropped, ");
+  putu(errors);
+  puts_(" errors\n");
+  return errors;
+}
@@ -0,0 +1,53 @@
+/*
+ * Filename:
+ *
+ *   etrace.c
+ *
+ * Description:
+ *
+ *   Round-trip test for the E-Trace encoder (TRACE_SUPPORTED).  Traces a
+ *   small program with taken and not-taken branches, forward and backward
+ *   jumps, indirect calls through a function pointer table, and returns.
+ *   The testbench logs the retired PCs while tracing is enabled and dumps
+ *   the trace buffer at the end; bin/etrace-decode.py --check rebuilds the
+ *   PC stream from the buffer and compares it with the log.
+ *   Returns 0 if the trace fit in the buffer, 1 otherwise.
+ *
+ */
+
+#include <stdint.h>
+
+#define TRACE_BASE 0x10070000
+#define TRACE_CTRL   (*(volatile uint32_t *)(TRACE_BASE + 0x0))
+#define TRACE_STATUS (*(volatile uint32_t *)(TRACE_BASE + 0x4))
+#define ITER 20
+
+typedef long (*op_t)(long, long);
+
+static long add(long a, long b) { return a + b; }
+static long sub(long a, long b) { return a - b; }
+static long mix(long a, long b) { return (a ^ b) + (a >> 1); }
+
+op_t ops[] = {add, sub, mix}; // global so the calls stay indirect
+
+static long __attribute__((noinline)) work(int n) {
+  long acc = 1;
+  int i;
+
+  for (i = 0; i < n; i++) {
+    if (i & 1) acc = ops[i % 3](acc, i);   // indirect call
+    else if (i % 5 == 0) acc += 7;
+    else acc = mix(acc, 3);
+  }
+  return acc;
+}
+
+volatile long result;
+
+int main() {
+  TRACE_STATUS = 0;   // clear the write index
+  TRACE_CTRL = 1;     // enable, stop when full
+  result = work(ITER);
+  TRACE_CTRL = 0;     // disable
+  return TRACE_STATUS >> 31; // full bit
+}
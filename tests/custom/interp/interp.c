@@ -0,0 +1,84 @@
+/*
+ * Filename:
+ *
+ *   interp.c
+ *
+ * Description:
+ *
+ *   Bytecode interpreter microbenchmark for the indirect jump target
+ *   predictor.  The same bytecode program runs on a threaded (computed
+ *   goto) interpreter, where every handler ends in its own jalr, and on a
+ *   switch interpreter, where every opcode dispatches through one shared
+ *   jump table jalr.  The program mixes opcodes so the dispatch targets
+ *   depend on the path taken rather than on the jalr's PC alone.
+ *   Returns 0 if both interpreters agree with the expected result.
+ *
+ */
+
+#include <stdint.h>
+
+#define ITER 200
+
+enum {OP_PUSH, OP_ADD, OP_SUB, OP_XOR, OP_DUP, OP_SWAP, OP_DEC, OP_JNZ, OP_HALT};
+
+// computes a checksum with a counted loop; the loop body alternates between opcode sequences
+static const uint8_t program[] = {
+  OP_PUSH, 0,                               // acc
+  OP_PUSH, 50,                              // counter
+  /* 4: loop */
+  OP_SWAP, OP_PUSH, 7, OP_ADD, OP_DUP, OP_XOR, OP_PUSH, 3, OP_SUB,
+  OP_PUSH, 11, OP_ADD, OP_SWAP,
+  OP_DEC, OP_DUP, OP_JNZ, 4,
+  OP_HALT
+};
+
+static int64_t threaded(const uint8_t *code) {
+  static void *dispatch[] = {&&push, &&add, &&sub, &&xor, &&dup, &&swap, &&dec, &&jnz, &&halt};
+  int64_t stack[16];
+  int64_t *sp = stack;
+  const uint8_t *pc = code;
+  int64_t t;
+
+  goto *dispatch[*pc++];
+push: *sp++ = *pc++;                     goto *dispatch[*pc++];
+add:  sp--; sp[-1] += sp[0];             goto *dispatch[*pc++];
+sub:  sp--; sp[-1] -= sp[0];             goto *dispatch[*pc++];
+xor:  sp--; sp[-1] ^= sp[0] >> 1;        goto *dispatch[*pc++];
+dup:  sp[0] = sp[-1]; sp++;              goto *dispatch[*pc++];
+swap: t = sp[-1]; sp[-1] = sp[-2]; sp[-2] = t; goto *dispatch[*pc++];
+dec:  sp[-1]--;                          goto *dispatch[*pc++];
+jnz:  sp--; if (sp[0]) pc = code + *pc; else pc++; goto *dispatch[*pc++];
+halt: return sp[-2];
+}
+
+static int64_t switched(const uint8_t *code) {
+  int64_t stack[16];
+  int64_t *sp = stack;
+  const uint8_t *pc = code;
+  int64_t t;
+
+  for (;;) {
+    switch (*pc++) {
+      case OP_PUSH: *sp++ = *pc++; break;
+      case OP_ADD:  sp--; sp[-1] += sp[0]; break;
+      case OP_SUB:  sp--; sp[-1] -= sp[0]; break;
+      case OP_XOR:  sp--; sp[-1] ^= sp[0] >> 1; break;
+      case OP_DUP:  sp[0] = sp[-1]; sp++; break;
+      case OP_SWAP: t = sp[-1]; sp[-1] = sp[-2]; sp[-2] = t; break;
+      case OP_DEC:  sp[-1]--; break;
+      case OP_JNZ:  sp--; if (sp[0]) pc = code + *pc; else pc++; break;
+      default:      return sp[-2];
+    }
+  }
+}
+
+int main() {
+  int64_t expected = threaded(program);
+  int i;
+
+  for (i = 0; i < ITER; i++) {
+    if (threaded(program) != expected) return 1;
+    if (switched(program) != expected) return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,130 @@
+/*
+ * Filename:
+ *
+ *   loadfwd.c
+ *
+ * Description:
+ *
+ *   Microbenchmark for load-use forwarding (LOADFWD_SUPPORTED).  A
+ *   circular linked list is walked in the style of CoreMark's
+ *   core_list_join.c.  In the first loop each load uses the pointer just
+ *   loaded and the add uses the data just loaded; in the second loop the
+ *   same instructions load from a fixed node and add the older value, so
+ *   there is no load-use dependence.  With forwarding of D$ hit
+ *   data both loops take the same number of cycles.  Without forwarding,
+ *   expect two extra cycles per iteration.
+ *
+ *   A second pair of loops checks load-to-ALU use directly: an add and an
+ *   xor consume each load in the next instruction, or one instruction
+ *   later.  Both must produce the checksum computed in C and, with
+ *   forwarding, take the same number of cycles.  Returns 0 if every check
+ *   passes, 1 otherwise.
+ *
+ */
+
+#define NODES 64
+#define ITER 1000
+
+struct node {
+  struct node *next;
+  long data;
+};
+
+static struct node list[NODES];
+static long vals[2*NODES];
+
+static unsigned long dependent(struct node *p, unsigned long n) {
+  unsigned long start, end;
+  long acc = 0, t;
+  asm volatile("csrr %0, mcycle" : "=r"(start));
+  asm volatile(
+    "1:\n"
+    "  ld   %1, 0(%1)\n"
+    "  ld   %0, 8(%1)\n"
+    "  add  %2, %2, %0\n"
+    "  addi %3, %3, -1\n"
+    "  bnez %3, 1b\n"
+    : "=&r"(t), "+r"(p), "+r"(acc), "+r"(n));
+  asm volatile("csrr %0, mcycle" : "=r"(end));
+  return end - start;
+}
+
+static unsigned long independent(struct node *p, unsigned long n) {
+  unsigned long start, end;
+  long acc = 0, t;
+  struct node *q;
+  asm volatile("csrr %0, mcycle" : "=r"(start));
+  asm volatile(
+    "1:\n"
+    "  ld   %1, 0(%2)\n"
+    "  ld   %0, 8(%2)\n"
+    "  add  %3, %3, %1\n"
+    "  addi %4, %4, -1\n"
+    "  bnez %4, 1b\n"
+    : "=&r"(t), "=&r"(q), "+r"(p), "+r"(acc), "+r"(n));
+  asm volatile("csrr %0, mcycle" : "=r"(end));
+  return end - start;
+}
+
+// each loaded value is used by the next instruction
+static unsigned long use(long *a, long *acc) {
+  unsigned long start, end;
+  long t, *e = a + 2*NODES;
+  asm volatile("csrr %0, mcycle" : "=r"(start));
+  asm volatile(
+    "1:\n"
+    "  ld   %0, 0(%1)\n"
+    "  add  %2, %2, %0\n"
+    "  ld   %0, 8(%1)\n"
+    "  xor  %2, %2, %0\n"
+    "  addi %1, %1, 16\n"
+    "  bne  %1, %3, 1b\n"
+    : "=&r"(t), "+r"(a), "+r"(*acc) : "r"(e));
+  asm volatile("csrr %0, mcycle" : "=r"(end));
+  return end - start;
+}
+
+// same work with each loaded value used two instructions later
+static unsigned long nouse(long *a, long *acc) {
+  unsigned long start, end;
+  long t, u, *e = a + 2*NODES;
+  asm volatile("csrr %0, mcycle" : "=r"(start));
+  asm volatile(
+    "1:\n"
+    "  ld   %0, 0(%2)\n"
+    "  ld   %1, 8(%2)\n"
+    "  add  %3, %3, %0\n"
+    "  xor  %3, %3, %1\n"
+    "  addi %2, %2, 16\n"
+    "  bne  %2, %4, 1b\n"
+    : "=&r"(t), "=&r"(u), "+r"(a), "+r"(*acc) : "r"(e));
+  asm volatile("csrr %0, mcycle" : "=r"(end));
+  return end - start;
+}
+
+int main() {
+  unsigned long dep, indep, usecyc, nousecyc;
+  long expect = 0, useacc = 0, nouseacc = 0;
+  int i;
+
+  for (i = 0; i < NODES; i++) {
+    list[i].next = &list[(i + 1) % NODES];
+    list[i].data = i;
+    vals[2*i] = (long)i * 0x9E3779B97F4A7C15L;
+    vals[2*i+1] = ~((long)i << 17) ^ 0x5A5A;
+    expect = (expect + vals[2*i]) ^ vals[2*i+1];
+  }
+
+  // warm the caches and branch predictor
+  dependent(list, ITER);
+  independent(list, ITER);
+  use(vals, &useacc);
+  nouse(vals, &nouseacc);
+  useacc = nouseacc = 0;
+
+  dep = dependent(list, ITER);
+  indep = independent(list, ITER);
+  usecyc = use(vals, &useacc);
+  nousecyc = nouse(vals, &nouseacc);
+  return (dep > indep) | (usecyc > nousecyc) | (useacc != expect) | (nouseacc != expect);
+}
@@ -0,0 +1,65 @@
+/*
+ * Filename:
+ *
+ *   wfiwake.c
+ *
+ * Description:
+ *
+ *   Microbenchmark for WFI wake-up latency.  The CLINT timer is set to
+ *   fire DELAY ticks ahead and the hart waits in WFI with only MTIE
+ *   enabled in mie and mstatus.MIE clear, so the interrupt resumes
+ *   execution after the WFI instead of trapping.  mtime advances once
+ *   per clock, so mtime read right after the WFI, less mtimecmp, is the
+ *   wake-up latency in cycles plus one uncached mtime load.
+ *   mhpmcounter31 counts the cycles spent waiting in WFI.  Run it with
+ *   and without WFI_CLOCKGATE to see that gating the pipeline clock
+ *   adds no latency.  The latencies are left in wakemax and waketotal
+ *   and the WFI cycles in wficycles.  Returns 0 if every wake-up took
+ *   at most MAXLAT cycles and the WFI cycles were counted, 1 otherwise.
+ *
+ */
+
+#define CLINT_MTIMECMP ((volatile unsigned long *)0x02004000)
+#define CLINT_MTIME    ((volatile unsigned long *)0x0200BFF8)
+#define MIP_MTIP       0x80
+#define ITER  8
+#define DELAY 200
+#define MAXLAT 64
+
+volatile unsigned long wakemax, waketotal, wficycles;
+
+static inline unsigned long wficount(void) {
+  unsigned long c;
+  asm volatile("csrr %0, mhpmcounter31" : "=r"(c));
+  return c;
+}
+
+// wait in WFI until the timer fires; return cycles from the timer firing to the next instruction
+static unsigned long wake(void) {
+  unsigned long target, now;
+  target = *CLINT_MTIME + DELAY;
+  *CLINT_MTIMECMP = target;
+  asm volatile("wfi");
+  now = *CLINT_MTIME;
+  *CLINT_MTIMECMP = -1UL;
+  return now - target;
+}
+
+int main() {
+  unsigned long lat, w0;
+  int i;
+
+  asm volatile("csrc mstatus, %0" : : "r"(0x8));      // no trap: WFI resumes on a pending enabled interrupt
+  asm volatile("csrw mie, %0" : : "r"(MIP_MTIP));
+  wake();                                            // warm the caches and branch predictor
+  wakemax = waketotal = 0;
+  w0 = wficount();
+  for (i = 0; i < ITER; i++) {
+    lat = wake();
+    waketotal += lat;
+    if (lat > wakemax) wakemax = lat;
+  }
+  wficycles = wficount() - w0;
+  asm volatile("csrw mie, zero");
+  return wakemax > MAXLAT || wficycles < ITER * (DELAY / 2);
+}